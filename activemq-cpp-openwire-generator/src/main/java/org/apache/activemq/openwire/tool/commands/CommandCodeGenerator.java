@@ -234,6 +234,15 @@ public abstract class CommandCodeGenerator {
         }
     }
 
+    /**
+     * Byte array properties for which this returns true are held in a buffer that
+     * is shared between copies of the command and only copied when one of them is
+     * about to be modified.
+     */
+    protected boolean isCopyOnWriteProperty( JProperty property ) {
+        return false;
+    }
+
     protected String decapitalize(String text) {
         if (text == null) {
             return null;
@@ -155,6 +155,10 @@ public class CommandHeaderGenerator extends CommandCodeGenerator {
         }
 
         for( JProperty property : getProperties() ) {
+            if( isCopyOnWriteProperty( property ) ) {
+                includes.add("<decaf/util/concurrent/atomic/AtomicBoolean.h>");
+            }
+
             if( !property.getType().isPrimitiveType() &&
                 !property.getType().getSimpleName().equals("String") &&
                 !property.getType().getSimpleName().equals("ByteSequence") )
@@ -216,6 +220,12 @@ public class CommandHeaderGenerator extends CommandCodeGenerator {
                 type = "Pointer<" + type + ">";
             }
 
+            if( isCopyOnWriteProperty( property ) ) {
+                out.println("        Pointer< "+type+" > "+name+";");
+                out.println("        mutable decaf::util::concurrent::atomic::AtomicBoolean "+name+"Shared;");
+                continue;
+            }
+
             out.println("        "+type+" "+name+";");
         }
 
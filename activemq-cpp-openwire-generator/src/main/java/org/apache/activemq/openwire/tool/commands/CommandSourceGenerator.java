@@ -236,6 +236,11 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
                 result.append("\n");
                 result.append("      ");
             }
+            if( isCopyOnWriteProperty( property ) ) {
+                result.append(parameterName + "(new " + type + "()), " + parameterName + "Shared(false)" );
+                continue;
+            }
+
             result.append(parameterName + "(" + value + ")" );
         }
 
@@ -263,6 +268,15 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
         for( JProperty property : getProperties() ) {
             String getter = property.getGetter().getSimpleName();
             String setter = property.getSetter().getSimpleName();
+
+            if( isCopyOnWriteProperty( property ) ) {
+                String name = decapitalize(property.getSimpleName());
+                out.println("    this->"+name+" = srcPtr->"+name+";");
+                out.println("    this->"+name+"Shared.set( true );");
+                out.println("    srcPtr->"+name+"Shared.set( true );");
+                continue;
+            }
+
             out.println("    this->"+setter+"( srcPtr->"+getter+"() );");
         }
     }
@@ -434,6 +448,35 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
                 constNess = "const ";
             }
 
+            if( isCopyOnWriteProperty( property ) ) {
+                String valueType = toCppType(property.getType());
+                out.println("////////////////////////////////////////////////////////////////////////////////");
+                out.println("const "+type+" "+getClassName()+"::"+getter+"() const {");
+                out.println("    return *"+parameterName+";");
+                out.println("}");
+                out.println("");
+                out.println("////////////////////////////////////////////////////////////////////////////////");
+                out.println(""+type+" "+getClassName()+"::"+getter+"() {");
+                out.println("    if( this->"+parameterName+"Shared.get() ) {");
+                out.println("        this->"+parameterName+".reset( new "+valueType+"( *this->"+parameterName+" ) );");
+                out.println("        this->"+parameterName+"Shared.set( false );");
+                out.println("    }");
+                out.println("    return *"+parameterName+";");
+                out.println("}");
+                out.println("");
+                out.println("////////////////////////////////////////////////////////////////////////////////");
+                out.println("void " + getClassName() + "::" + setter+"( " + constNess + type+ " " + parameterName +" ) {");
+                out.println("    if( this->"+parameterName+"Shared.get() ) {");
+                out.println("        this->"+parameterName+".reset( new "+valueType+"( "+parameterName+" ) );");
+                out.println("        this->"+parameterName+"Shared.set( false );");
+                out.println("    } else {");
+                out.println("        *this->"+parameterName+" = "+parameterName+";");
+                out.println("    }");
+                out.println("}");
+                out.println("");
+                continue;
+            }
+
             if( property.getType().isPrimitiveType() ) {
                 out.println("////////////////////////////////////////////////////////////////////////////////");
                 out.println(type+" "+getClassName()+"::"+getter+"() const {");
@@ -19,8 +19,15 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
+import org.codehaus.jam.JProperty;
+
 public class MessageHeaderGenerator extends CommandHeaderGenerator {
 
+    protected boolean isCopyOnWriteProperty( JProperty property ) {
+        String name = property.getSimpleName();
+        return name.equals("Content") || name.equals("MarshalledProperties");
+    }
+
     protected void populateIncludeFilesSet() {
 
         super.populateIncludeFilesSet();
@@ -51,8 +58,17 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("        Pointer<core::ActiveMQAckHandler> ackHandler;");
         out.println("");
         out.println("        // Message properties, these are Marshaled and Unmarshaled from the Message");
-        out.println("        // Command's marshaledProperties vector.");
-        out.println("        activemq::util::PrimitiveMap properties;");
+        out.println("        // Command's marshaledProperties vector.  Unmarshaling is deferred until the");
+        out.println("        // properties are first accessed.");
+        out.println("        mutable activemq::util::PrimitiveMap properties;");
+        out.println("");
+        out.println("        // Indicates the marshaledProperties hold properties that have not yet been");
+        out.println("        // unmarshaled into the properties map.");
+        out.println("        mutable bool propertiesUnmarshalPending;");
+        out.println("");
+        out.println("        // Indicates the properties map may no longer match the marshaledProperties");
+        out.println("        // so they must be marshaled again before this message is sent.");
+        out.println("        bool propertiesModified;");
         out.println("");
         out.println("        // Indicates if the Message Properties are Read Only");
         out.println("        bool readOnlyProperties;");
@@ -60,6 +76,12 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("        // Indicates if the Message Body are Read Only");
         out.println("        bool readOnlyBody;");
         out.println("");
+        out.println("        /**");
+        out.println("         * Unmarshals the received marshaledProperties into the properties map");
+        out.println("         * the first time the properties are accessed.");
+        out.println("         */");
+        out.println("        void unmarshalProperties() const;");
+        out.println("");
         out.println("    protected:");
         out.println("");
         out.println("        core::ActiveMQConnection* connection;");
@@ -170,9 +192,12 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("         * @return a reference to the Primitive Map that holds message properties.");
         out.println("         */");
         out.println("        util::PrimitiveMap& getMessageProperties() {");
+        out.println("            this->unmarshalProperties();");
+        out.println("            this->propertiesModified = true;");
         out.println("            return this->properties;");
         out.println("        }");
         out.println("        const util::PrimitiveMap& getMessageProperties() const {");
+        out.println("            this->unmarshalProperties();");
         out.println("            return this->properties;");
         out.println("        }");
         out.println("");
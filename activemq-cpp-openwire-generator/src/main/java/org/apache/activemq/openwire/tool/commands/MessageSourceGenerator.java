@@ -19,8 +19,15 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
+import org.codehaus.jam.JProperty;
+
 public class MessageSourceGenerator extends CommandSourceGenerator {
 
+    protected boolean isCopyOnWriteProperty( JProperty property ) {
+        String name = property.getSimpleName();
+        return name.equals("Content") || name.equals("MarshalledProperties");
+    }
+
     protected void populateIncludeFilesSet() {
         super.populateIncludeFilesSet();
         Set<String> includes = getIncludeFiles();
@@ -37,6 +44,8 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         result.append(super.generateInitializerList());
         result.append(", ackHandler(NULL)");
         result.append(", properties()");
+        result.append(", propertiesUnmarshalPending(false)");
+        result.append(", propertiesModified(true)");
         result.append(", readOnlyProperties(false)");
         result.append(", readOnlyBody(false)");
         result.append(", connection(NULL)");
@@ -47,7 +56,17 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
     protected void generateCopyDataStructureBody( PrintWriter out ) {
         super.generateCopyDataStructureBody(out);
 
-        out.println("    this->properties.copy( srcPtr->properties );");
+        out.println("    // When the source's marshaled properties are current they are shared with");
+        out.println("    // this copy above and only unmarshaled here if and when they are accessed.");
+        out.println("    this->properties.clear();");
+        out.println("    if( srcPtr->propertiesUnmarshalPending || !srcPtr->propertiesModified ) {");
+        out.println("        this->propertiesUnmarshalPending = !this->marshalledProperties->empty();");
+        out.println("        this->propertiesModified = false;");
+        out.println("    } else {");
+        out.println("        this->properties.copy( srcPtr->properties );");
+        out.println("        this->propertiesUnmarshalPending = false;");
+        out.println("        this->propertiesModified = true;");
+        out.println("    }");
         out.println("    this->setAckHandler( srcPtr->getAckHandler() );");
         out.println("    this->setReadOnlyBody( srcPtr->isReadOnlyBody() );");
         out.println("    this->setReadOnlyProperties( srcPtr->isReadOnlyProperties() );");
@@ -65,7 +84,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("        return false;");
         out.println("    }");
         out.println("");
-        out.println("    if( !properties.equals( valuePtr->properties ) ) {");
+        out.println("    if( !getMessageProperties().equals( valuePtr->getMessageProperties() ) ) {");
         out.println("        return false;");
         out.println("    }");
         out.println("");
@@ -113,10 +132,18 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    try{");
         out.println("");
-        out.println("        marshalledProperties.clear();");
-        out.println("        if( !properties.isEmpty() ) {");
-        out.println("            wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(");
-        out.println("                &properties, marshalledProperties );");
+        out.println("        // Properties that were received and not modified since are sent");
+        out.println("        // again exactly as they arrived.");
+        out.println("        if( this->propertiesModified ) {");
+        out.println("");
+        out.println("            std::vector<unsigned char>& buffer = this->getMarshalledProperties();");
+        out.println("            buffer.clear();");
+        out.println("            if( !properties.isEmpty() ) {");
+        out.println("                wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(");
+        out.println("                    &properties, buffer );");
+        out.println("            }");
+        out.println("");
+        out.println("            this->propertiesModified = false;");
         out.println("        }");
         out.println("    }");
         out.println("    AMQ_CATCH_RETHROW( decaf::io::IOException )");
@@ -129,8 +156,29 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    try{");
         out.println("");
+        out.println("        // The properties are only unmarshaled if and when they are accessed.");
+        out.println("        this->properties.clear();");
+        out.println("        this->propertiesUnmarshalPending = !marshalledProperties->empty();");
+        out.println("        this->propertiesModified = false;");
+        out.println("    }");
+        out.println("    AMQ_CATCH_RETHROW( decaf::io::IOException )");
+        out.println("    AMQ_CATCH_EXCEPTION_CONVERT( decaf::lang::Exception, decaf::io::IOException )");
+        out.println("    AMQ_CATCHALL_THROW( decaf::io::IOException )");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::unmarshalProperties() const {");
+        out.println("");
+        out.println("    if( !this->propertiesUnmarshalPending ) {");
+        out.println("        return;");
+        out.println("    }");
+        out.println("");
+        out.println("    try{");
+        out.println("");
         out.println("        wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(");
-        out.println("            &properties, marshalledProperties );");
+        out.println("            &properties, *marshalledProperties );");
+        out.println("");
+        out.println("        this->propertiesUnmarshalPending = false;");
         out.println("    }");
         out.println("    AMQ_CATCH_RETHROW( decaf::io::IOException )");
         out.println("    AMQ_CATCH_EXCEPTION_CONVERT( decaf::lang::Exception, decaf::io::IOException )");
@@ -51,10 +51,6 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
      */
     protected boolean checkNeedsInfoPointerTM1() {
 
-        if( isMarshallerAware() ){
-            return true;
-        }
-
         for ( JProperty property : getProperties() ) {
             JClass propertyType = property.getType();
             String type = propertyType.getSimpleName();
@@ -80,10 +76,6 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
      */
     protected boolean checkNeedsInfoPointerTM2() {
 
-        if( isMarshallerAware() ){
-            return true;
-        }
-
         for ( JProperty property : getProperties() ) {
             JClass propertyType = property.getType();
             String type = propertyType.getSimpleName();
@@ -658,13 +650,13 @@ out.println("");
 
     if( checkNeedsInfoPointerTM1() ) {
         String properClassName = getProperClassName( jclass.getSimpleName() );
-out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>( dataStructure );");
+out.println("        const "+properClassName+"* info =");
+out.println("            dynamic_cast<const "+properClassName+"*>( dataStructure );");
 out.println("");
     }
 
     if( marshallerAware ) {
-out.println("        info->beforeMarshal( wireFormat );");
+out.println("        dataStructure->beforeMarshal( wireFormat );");
     }
 
 out.println("        int rc = "+baseClass+"::tightMarshal1( wireFormat, dataStructure, bs );");
@@ -695,8 +687,8 @@ out.println("");
 
     if( checkNeedsInfoPointerTM2() ) {
         String properClassName = getProperClassName( jclass.getSimpleName() );
-out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>( dataStructure );");
+out.println("        const "+properClassName+"* info =");
+out.println("            dynamic_cast<const "+properClassName+"*>( dataStructure );");
     }
 
     if( checkNeedsWireFormatVersion() ) {
@@ -708,7 +700,7 @@ out.println("            dynamic_cast<"+properClassName+"*>( dataStructure );");
     generateTightMarshal2Body(out);
 
     if( marshallerAware ) {
-out.println("        info->afterMarshal( wireFormat );");
+out.println("        dataStructure->afterMarshal( wireFormat );");
     }
 
 out.println("    }");
@@ -758,14 +750,14 @@ out.println("");
 out.println("    try {");
 out.println("");
 
-    if( !properties.isEmpty() || marshallerAware ) {
+    if( !properties.isEmpty() ) {
         String properClassName = getProperClassName( jclass.getSimpleName() );
-out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>( dataStructure );");
+out.println("        const "+properClassName+"* info =");
+out.println("            dynamic_cast<const "+properClassName+"*>( dataStructure );");
     }
 
     if( marshallerAware ) {
-out.println("        info->beforeMarshal( wireFormat );");
+out.println("        dataStructure->beforeMarshal( wireFormat );");
     }
 
 out.println("        "+baseClass+"::looseMarshal( wireFormat, dataStructure, dataOut );");
@@ -779,7 +771,7 @@ out.println("        "+baseClass+"::looseMarshal( wireFormat, dataStructure, dat
     generateLooseMarshalBody(out);
 
     if( marshallerAware ) {
-out.println("        info->afterMarshal( wireFormat );");
+out.println("        dataStructure->afterMarshal( wireFormat );");
     }
 
 out.println("    }");
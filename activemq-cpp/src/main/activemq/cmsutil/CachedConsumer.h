@@ -72,6 +72,10 @@ namespace cmsutil {
             return consumer->receiveNoWait();
         }
 
+        virtual int receive( std::vector<cms::Message*>& messages, int maxMessages, int millisecs ) {
+            return consumer->receive( messages, maxMessages, millisecs );
+        }
+
         virtual void setMessageListener( cms::MessageListener* listener ) {
             consumer->setMessageListener( listener );
         }
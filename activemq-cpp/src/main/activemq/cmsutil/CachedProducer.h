@@ -76,6 +76,34 @@ namespace cmsutil {
             producer->send( destination, message, deliveryMode, priority, timeToLive );
         }
 
+        virtual void send( cms::Message* message, cms::AsyncCallback* onComplete ) {
+            producer->send( message, onComplete );
+        }
+
+        virtual void send( cms::Message* message, int deliveryMode, int priority,
+                           long long timeToLive, cms::AsyncCallback* onComplete ) {
+
+            producer->send( message, deliveryMode, priority, timeToLive, onComplete );
+        }
+
+        virtual void send( const cms::Destination* destination,
+                           cms::Message* message, cms::AsyncCallback* onComplete ) {
+
+            producer->send( destination, message, onComplete );
+        }
+
+        virtual void send( const cms::Destination* destination,
+                           cms::Message* message, int deliveryMode,
+                           int priority, long long timeToLive,
+                           cms::AsyncCallback* onComplete ) {
+
+            producer->send( destination, message, deliveryMode, priority, timeToLive, onComplete );
+        }
+
+        virtual void send( const std::vector<cms::Message*>& messages ) {
+            producer->send( messages );
+        }
+
         virtual void setDeliveryMode( int mode ) {
             producer->setDeliveryMode( mode );
         }
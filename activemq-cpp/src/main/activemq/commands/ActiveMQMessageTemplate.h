@@ -46,7 +46,7 @@ namespace commands {
     public:
 
         ActiveMQMessageTemplate() : commands::Message(), propertiesInterceptor() {
-            this->propertiesInterceptor.reset(new wireformat::openwire::utils::MessagePropertyInterceptor(this, &this->getMessageProperties()));
+            this->propertiesInterceptor.reset(new wireformat::openwire::utils::MessagePropertyInterceptor(this));
         }
 
         virtual ~ActiveMQMessageTemplate() throw () {
@@ -20,11 +20,18 @@
 
 #include <activemq/util/Config.h>
 #include <activemq/wireformat/MarshalAware.h>
+#include <decaf/util/concurrent/atomic/AtomicRefCounted.h>
 
 namespace activemq{
 namespace commands{
 
-    class AMQCPP_API DataStructure : public wireformat::MarshalAware {
+    /**
+     * Base class of all the OpenWire commands and the objects they carry.  Each instance
+     * embeds its own reference count so that wrapping a newly created or unmarshaled
+     * object in a Pointer does not need a second allocation for the count.
+     */
+    class AMQCPP_API DataStructure : public wireformat::MarshalAware,
+                                     public decaf::util::concurrent::atomic::AtomicRefCounted {
     public:
 
         virtual ~DataStructure() {}
@@ -46,8 +46,9 @@ using namespace decaf::lang::exceptions;
 Message::Message() 
     : BaseCommand(), producerId(NULL), destination(NULL), transactionId(NULL), originalDestination(NULL), messageId(NULL), originalTransactionId(NULL), 
       groupID(""), groupSequence(0), correlationId(""), persistent(false), expiration(0), priority(0), replyTo(NULL), timestamp(0), 
-      type(""), content(), marshalledProperties(), dataStructure(NULL), targetConsumerId(NULL), compressed(false), redeliveryCounter(0), 
-      brokerPath(), arrival(0), userID(""), recievedByDFBridge(false), droppable(false), cluster(), brokerInTime(0), brokerOutTime(0), ackHandler(NULL), properties(), readOnlyProperties(false), readOnlyBody(false), connection(NULL) {
+      type(""), content(new std::vector<unsigned char>()), contentShared(false), marshalledProperties(new std::vector<unsigned char>()), marshalledPropertiesShared(false), 
+      dataStructure(NULL), targetConsumerId(NULL), compressed(false), redeliveryCounter(0), brokerPath(), arrival(0), userID(""), 
+      recievedByDFBridge(false), droppable(false), cluster(), brokerInTime(0), brokerOutTime(0), ackHandler(NULL), properties(), propertiesUnmarshalPending(false), propertiesModified(true), readOnlyProperties(false), readOnlyBody(false), connection(NULL) {
 
 }
 
@@ -99,8 +100,12 @@ void Message::copyDataStructure( const DataStructure* src ) {
     this->setReplyTo( srcPtr->getReplyTo() );
     this->setTimestamp( srcPtr->getTimestamp() );
     this->setType( srcPtr->getType() );
-    this->setContent( srcPtr->getContent() );
-    this->setMarshalledProperties( srcPtr->getMarshalledProperties() );
+    this->content = srcPtr->content;
+    this->contentShared.set( true );
+    srcPtr->contentShared.set( true );
+    this->marshalledProperties = srcPtr->marshalledProperties;
+    this->marshalledPropertiesShared.set( true );
+    srcPtr->marshalledPropertiesShared.set( true );
     this->setDataStructure( srcPtr->getDataStructure() );
     this->setTargetConsumerId( srcPtr->getTargetConsumerId() );
     this->setCompressed( srcPtr->isCompressed() );
@@ -113,7 +118,17 @@ void Message::copyDataStructure( const DataStructure* src ) {
     this->setCluster( srcPtr->getCluster() );
     this->setBrokerInTime( srcPtr->getBrokerInTime() );
     this->setBrokerOutTime( srcPtr->getBrokerOutTime() );
-    this->properties.copy( srcPtr->properties );
+    // When the source's marshaled properties are current they are shared with
+    // this copy above and only unmarshaled here if and when they are accessed.
+    this->properties.clear();
+    if( srcPtr->propertiesUnmarshalPending || !srcPtr->propertiesModified ) {
+        this->propertiesUnmarshalPending = !this->marshalledProperties->empty();
+        this->propertiesModified = false;
+    } else {
+        this->properties.copy( srcPtr->properties );
+        this->propertiesUnmarshalPending = false;
+        this->propertiesModified = true;
+    }
     this->setAckHandler( srcPtr->getAckHandler() );
     this->setReadOnlyBody( srcPtr->isReadOnlyBody() );
     this->setReadOnlyProperties( srcPtr->isReadOnlyProperties() );
@@ -433,7 +448,7 @@ bool Message::equals( const DataStructure* value ) const {
         return false;
     }
 
-    if( !properties.equals( valuePtr->properties ) ) {
+    if( !getMessageProperties().equals( valuePtr->getMessageProperties() ) ) {
         return false;
     }
 
@@ -653,32 +668,50 @@ void Message::setType( const std::string& type ) {
 
 ////////////////////////////////////////////////////////////////////////////////
 const std::vector<unsigned char>& Message::getContent() const {
-    return content;
+    return *content;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>& Message::getContent() {
-    return content;
+    if( this->contentShared.get() ) {
+        this->content.reset( new std::vector<unsigned char>( *this->content ) );
+        this->contentShared.set( false );
+    }
+    return *content;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setContent( const std::vector<unsigned char>& content ) {
-    this->content = content;
+    if( this->contentShared.get() ) {
+        this->content.reset( new std::vector<unsigned char>( content ) );
+        this->contentShared.set( false );
+    } else {
+        *this->content = content;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 const std::vector<unsigned char>& Message::getMarshalledProperties() const {
-    return marshalledProperties;
+    return *marshalledProperties;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>& Message::getMarshalledProperties() {
-    return marshalledProperties;
+    if( this->marshalledPropertiesShared.get() ) {
+        this->marshalledProperties.reset( new std::vector<unsigned char>( *this->marshalledProperties ) );
+        this->marshalledPropertiesShared.set( false );
+    }
+    return *marshalledProperties;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setMarshalledProperties( const std::vector<unsigned char>& marshalledProperties ) {
-    this->marshalledProperties = marshalledProperties;
+    if( this->marshalledPropertiesShared.get() ) {
+        this->marshalledProperties.reset( new std::vector<unsigned char>( marshalledProperties ) );
+        this->marshalledPropertiesShared.set( false );
+    } else {
+        *this->marshalledProperties = marshalledProperties;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -858,10 +891,18 @@ void Message::beforeMarshal( wireformat::WireFormat* wireFormat AMQCPP_UNUSED )
 
     try{
 
-        marshalledProperties.clear();
-        if( !properties.isEmpty() ) {
-            wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(
-                &properties, marshalledProperties );
+        // Properties that were received and not modified since are sent
+        // again exactly as they arrived.
+        if( this->propertiesModified ) {
+
+            std::vector<unsigned char>& buffer = this->getMarshalledProperties();
+            buffer.clear();
+            if( !properties.isEmpty() ) {
+                wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(
+                    &properties, buffer );
+            }
+
+            this->propertiesModified = false;
         }
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -872,10 +913,31 @@ void Message::beforeMarshal( wireformat::WireFormat* wireFormat AMQCPP_UNUSED )
 ////////////////////////////////////////////////////////////////////////////////
 void Message::afterUnmarshal( wireformat::WireFormat* wireFormat AMQCPP_UNUSED ) {
 
+    try{
+
+        // The properties are only unmarshaled if and when they are accessed.
+        this->properties.clear();
+        this->propertiesUnmarshalPending = !marshalledProperties->empty();
+        this->propertiesModified = false;
+    }
+    AMQ_CATCH_RETHROW( decaf::io::IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( decaf::lang::Exception, decaf::io::IOException )
+    AMQ_CATCHALL_THROW( decaf::io::IOException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::unmarshalProperties() const {
+
+    if( !this->propertiesUnmarshalPending ) {
+        return;
+    }
+
     try{
 
         wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(
-            &properties, marshalledProperties );
+            &properties, *marshalledProperties );
+
+        this->propertiesUnmarshalPending = false;
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( decaf::lang::Exception, decaf::io::IOException )
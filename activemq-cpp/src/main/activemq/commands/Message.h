@@ -35,6 +35,7 @@
 #include <activemq/util/Config.h>
 #include <activemq/util/PrimitiveMap.h>
 #include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <string>
 #include <vector>
 
@@ -74,8 +75,10 @@ namespace commands{
         Pointer<ActiveMQDestination> replyTo;
         long long timestamp;
         std::string type;
-        std::vector<unsigned char> content;
-        std::vector<unsigned char> marshalledProperties;
+        Pointer< std::vector<unsigned char> > content;
+        mutable decaf::util::concurrent::atomic::AtomicBoolean contentShared;
+        Pointer< std::vector<unsigned char> > marshalledProperties;
+        mutable decaf::util::concurrent::atomic::AtomicBoolean marshalledPropertiesShared;
         Pointer<DataStructure> dataStructure;
         Pointer<ConsumerId> targetConsumerId;
         bool compressed;
@@ -100,8 +103,17 @@ namespace commands{
         Pointer<core::ActiveMQAckHandler> ackHandler;
 
         // Message properties, these are Marshaled and Unmarshaled from the Message
-        // Command's marshaledProperties vector.
-        activemq::util::PrimitiveMap properties;
+        // Command's marshaledProperties vector.  Unmarshaling is deferred until the
+        // properties are first accessed.
+        mutable activemq::util::PrimitiveMap properties;
+
+        // Indicates the marshaledProperties hold properties that have not yet been
+        // unmarshaled into the properties map.
+        mutable bool propertiesUnmarshalPending;
+
+        // Indicates the properties map may no longer match the marshaledProperties
+        // so they must be marshaled again before this message is sent.
+        bool propertiesModified;
 
         // Indicates if the Message Properties are Read Only
         bool readOnlyProperties;
@@ -109,6 +121,12 @@ namespace commands{
         // Indicates if the Message Body are Read Only
         bool readOnlyBody;
 
+        /**
+         * Unmarshals the received marshaledProperties into the properties map
+         * the first time the properties are accessed.
+         */
+        void unmarshalProperties() const;
+
     protected:
 
         core::ActiveMQConnection* connection;
@@ -233,9 +251,12 @@ namespace commands{
          * @return a reference to the Primitive Map that holds message properties.
          */
         util::PrimitiveMap& getMessageProperties() {
+            this->unmarshalProperties();
+            this->propertiesModified = true;
             return this->properties;
         }
         const util::PrimitiveMap& getMessageProperties() const {
+            this->unmarshalProperties();
             return this->properties;
         }
 
@@ -31,11 +31,16 @@
 #include <activemq/exceptions/ConnectionFailedException.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/IdGenerator.h>
+#include <activemq/threads/DedicatedTaskRunner.h>
+#include <activemq/threads/PooledTaskRunner.h>
 #include <activemq/transport/failover/FailoverTransport.h>
+#include <activemq/transport/tcp/TcpTransport.h>
 
 #include <decaf/lang/Math.h>
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
 #include <decaf/util/Iterator.h>
 #include <decaf/util/UUID.h>
 #include <decaf/util/concurrent/Mutex.h>
@@ -43,12 +48,14 @@
 #include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/ThreadPoolExecutor.h>
 #include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
 
 #include <activemq/commands/Command.h>
 #include <activemq/commands/ActiveMQMessage.h>
 #include <activemq/commands/BrokerInfo.h>
 #include <activemq/commands/BrokerError.h>
 #include <activemq/commands/ConnectionId.h>
+#include <activemq/commands/ConnectionControl.h>
 #include <activemq/commands/DestinationInfo.h>
 #include <activemq/commands/ExceptionResponse.h>
 #include <activemq/commands/KeepAliveInfo.h>
@@ -75,6 +82,7 @@ using namespace activemq::exceptions;
 using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace activemq::transport::failover;
+using namespace activemq::transport::tcp;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::util;
@@ -115,6 +123,7 @@ namespace core{
         Pointer<util::IdGenerator> clientIdGenerator;
         Pointer<Scheduler> scheduler;
         Pointer<ExecutorService> executor;
+        Pointer<ExecutorService> sessionExecutor;
 
         util::LongSequenceGenerator sessionIds;
         util::LongSequenceGenerator consumerIdGenerator;
@@ -130,10 +139,21 @@ namespace core{
         decaf::util::concurrent::Mutex ensureConnectionInfoSentMutex;
         decaf::util::concurrent::Mutex mutex;
 
+        decaf::util::concurrent::atomic::AtomicReference<decaf::lang::Thread> directDispatchThread;
+        decaf::util::concurrent::atomic::AtomicBoolean directDispatchRefused;
+
         bool dispatchAsync;
+        bool alwaysSessionAsync;
         bool alwaysSyncSend;
         bool useAsyncSend;
         bool messagePrioritySupported;
+        bool useRingBufferDispatchChannel;
+        bool copyMessageOnSend;
+        bool useDedicatedTaskRunner;
+        int sessionTaskRunnerPoolSize;
+        bool optimizeAcknowledge;
+        long long optimizeAcknowledgeTimeOut;
+        double optimizeAcknowledgeRatio;
         bool watchTopicAdvisories;
         bool useCompression;
         int compressionLevel;
@@ -168,6 +188,8 @@ namespace core{
                              transport(),
                              clientIdGenerator(),
                              scheduler(),
+                             executor(),
+                             sessionExecutor(),
                              sessionIds(),
                              consumerIdGenerator(),
                              tempDestinationIds(),
@@ -178,10 +200,20 @@ namespace core{
                              userSpecifiedClientID(false),
                              ensureConnectionInfoSentMutex(),
                              mutex(),
+                             directDispatchThread(),
+                             directDispatchRefused(false),
                              dispatchAsync(true),
+                             alwaysSessionAsync(true),
                              alwaysSyncSend(false),
                              useAsyncSend(false),
                              messagePrioritySupported(true),
+                             useRingBufferDispatchChannel(false),
+                             copyMessageOnSend(true),
+                             useDedicatedTaskRunner(true),
+                             sessionTaskRunnerPoolSize(System::availableProcessors()),
+                             optimizeAcknowledge(false),
+                             optimizeAcknowledgeTimeOut(300),
+                             optimizeAcknowledgeRatio(0.65),
                              watchTopicAdvisories(true),
                              useCompression(false),
                              compressionLevel(-1),
@@ -314,6 +346,44 @@ namespace core{
         }
     };
 
+    /**
+     * Converts an ExceptionResponse into a BrokerException before handing the outcome
+     * of an asynchronous request to the caller's callback, as syncRequest does.
+     */
+    class BrokerResponseCallback : public ResponseCallback {
+    private:
+
+        BrokerResponseCallback(const BrokerResponseCallback&);
+        BrokerResponseCallback& operator=(const BrokerResponseCallback&);
+
+    private:
+
+        Pointer<ResponseCallback> onComplete;
+
+    public:
+
+        BrokerResponseCallback(const Pointer<ResponseCallback>& onComplete) :
+            ResponseCallback(), onComplete(onComplete) {}
+        virtual ~BrokerResponseCallback() {}
+
+        virtual void onResponse(const Pointer<Response>& response) {
+
+            commands::ExceptionResponse* exceptionResponse =
+                dynamic_cast<ExceptionResponse*> (response.get());
+
+            if (exceptionResponse != NULL) {
+                BrokerException exception(__FILE__, __LINE__, exceptionResponse->getException().get());
+                this->onComplete->onException(exception);
+            } else {
+                this->onComplete->onResponse(response);
+            }
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex) {
+            this->onComplete->onException(ex);
+        }
+    };
+
 }}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -558,6 +628,16 @@ void ActiveMQConnection::close() {
         } catch(Exception& ex) {
         }
 
+        // The Sessions are all disposed of so their runners are done with the pool.
+        try {
+            synchronized(&this->config->mutex) {
+                if (this->config->sessionExecutor != NULL) {
+                    this->config->sessionExecutor->shutdown();
+                }
+            }
+        } catch(Exception& ex) {
+        }
+
         // Now inform the Broker we are shutting down.
         this->disconnect(lastDeliveredSequenceId);
 
@@ -882,8 +962,23 @@ void ActiveMQConnection::onControlCommand(Pointer<commands::Command> command AMQ
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ActiveMQConnection::onConnectionControl(Pointer<commands::Command> command AMQCPP_UNUSED) {
-    // Don't need to do anything yet as we don't support optimizeAcknowledge.
+void ActiveMQConnection::onConnectionControl(Pointer<commands::Command> command) {
+
+    Pointer<ConnectionControl> control = command.dynamicCast<ConnectionControl>();
+
+    // A fault tolerant broker may hand the connection over to another broker that knows
+    // nothing of the acks held back, so the consumers send what they have batched and go
+    // back to acking each message.
+    if (control->isFaultTolerant()) {
+
+        this->config->optimizeAcknowledge = false;
+
+        std::auto_ptr< Iterator< Pointer<ActiveMQSessionKernel> > > iter( this->config->activeSessions.iterator() );
+
+        while (iter->hasNext()) {
+            iter->next()->setOptimizeAcknowledge(false);
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -996,6 +1091,7 @@ Pointer<Response> ActiveMQConnection::syncRequest(Pointer<Command> command, unsi
     try {
 
         checkClosedOrFailed();
+        checkNotDispatchingDirectly();
 
         Pointer<Response> response;
 
@@ -1026,6 +1122,51 @@ Pointer<Response> ActiveMQConnection::syncRequest(Pointer<Command> command, unsi
     AMQ_CATCHALL_THROW( ActiveMQException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::asyncRequest(Pointer<Command> command,
+                                      const Pointer<ResponseCallback>& onComplete,
+                                      unsigned int timeout) {
+
+    try {
+
+        checkClosedOrFailed();
+
+        if (onComplete == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "Response callback cannot be NULL");
+        }
+
+        Pointer<ResponseCallback> callback(new BrokerResponseCallback(onComplete));
+        this->config->transport->asyncRequest(command, callback, timeout);
+    }
+    AMQ_CATCH_RETHROW( ActiveMQException )
+    AMQ_CATCH_EXCEPTION_CONVERT( IOException, ActiveMQException )
+    AMQ_CATCH_EXCEPTION_CONVERT( decaf::lang::exceptions::UnsupportedOperationException, ActiveMQException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, ActiveMQException )
+    AMQ_CATCHALL_THROW( ActiveMQException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::beginDirectDispatch() {
+    this->config->directDispatchRefused.set(false);
+    this->config->directDispatchThread.set(Thread::currentThread());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::endDirectDispatch() {
+    this->config->directDispatchThread.set(NULL);
+    return this->config->directDispatchRefused.getAndSet(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::checkNotDispatchingDirectly() {
+    if (this->config->directDispatchThread.get() == Thread::currentThread()) {
+        this->config->directDispatchRefused.set(true);
+        throw decaf::lang::exceptions::IllegalStateException(__FILE__, __LINE__,
+            "A MessageListener run on the transport thread can't wait for the broker, "
+            "set alwaysSessionAsync to true to make blocking calls from the listener.");
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::checkClosed() const {
     if (this->isClosed()) {
@@ -1263,6 +1404,29 @@ void ActiveMQConnection::setAlwaysSyncSend(bool value) {
     this->config->alwaysSyncSend = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isAlwaysSessionAsync() const {
+    return this->config->alwaysSessionAsync;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setAlwaysSessionAsync(bool value) {
+    this->config->alwaysSessionAsync = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isTransportReaderShared() const {
+
+    if (this->config->transport == NULL) {
+        return false;
+    }
+
+    TcpTransport* tcpTransport =
+        dynamic_cast<TcpTransport*>(this->config->transport->narrow(typeid(TcpTransport)));
+
+    return tcpTransport != NULL && tcpTransport->isUsingReactor();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQConnection::isUseAsyncSend() const {
     return this->config->useAsyncSend;
@@ -1358,6 +1522,106 @@ void ActiveMQConnection::setMessagePrioritySupported(bool value) {
     this->config->messagePrioritySupported = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isUseRingBufferDispatchChannel() const {
+    return this->config->useRingBufferDispatchChannel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setUseRingBufferDispatchChannel(bool value) {
+    this->config->useRingBufferDispatchChannel = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isCopyMessageOnSend() const {
+    return this->config->copyMessageOnSend;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setCopyMessageOnSend(bool value) {
+    this->config->copyMessageOnSend = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isUseDedicatedTaskRunner() const {
+    return this->config->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setUseDedicatedTaskRunner(bool value) {
+    this->config->useDedicatedTaskRunner = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getSessionTaskRunnerPoolSize() const {
+    return this->config->sessionTaskRunnerPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setSessionTaskRunnerPoolSize(int value) {
+    this->config->sessionTaskRunnerPoolSize = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isOptimizeAcknowledge() const {
+    return this->config->optimizeAcknowledge;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setOptimizeAcknowledge(bool value) {
+    this->config->optimizeAcknowledge = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnection::getOptimizeAcknowledgeTimeOut() const {
+    return this->config->optimizeAcknowledgeTimeOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setOptimizeAcknowledgeTimeOut(long long value) {
+    this->config->optimizeAcknowledgeTimeOut = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double ActiveMQConnection::getOptimizeAcknowledgeRatio() const {
+    return this->config->optimizeAcknowledgeRatio;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setOptimizeAcknowledgeRatio(double value) {
+    this->config->optimizeAcknowledgeRatio = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<TaskRunner> ActiveMQConnection::createSessionTaskRunner(Task* task) {
+
+    try {
+
+        if (this->config->useDedicatedTaskRunner) {
+            return Pointer<TaskRunner>(new DedicatedTaskRunner(task));
+        }
+
+        Pointer<ExecutorService> executor;
+
+        synchronized(&this->config->mutex) {
+            if (this->config->sessionExecutor == NULL) {
+                int poolSize = Math::max(1, this->config->sessionTaskRunnerPoolSize);
+                this->config->sessionExecutor.reset(new ThreadPoolExecutor(
+                    poolSize, poolSize, 5, TimeUnit::SECONDS, new LinkedBlockingQueue<Runnable*>()));
+            }
+
+            executor = this->config->sessionExecutor;
+        }
+
+        // Each Session hands its thread back to the pool after this many iterations so
+        // that a busy Session can't starve the others.
+        return Pointer<TaskRunner>(new PooledTaskRunner(executor, task, 1000));
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::setFirstFailureError(decaf::lang::Exception* error) {
 
@@ -30,6 +30,8 @@
 #include <activemq/transport/Transport.h>
 #include <activemq/transport/TransportListener.h>
 #include <activemq/threads/Scheduler.h>
+#include <activemq/threads/Task.h>
+#include <activemq/threads/TaskRunner.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <decaf/util/Properties.h>
@@ -402,6 +404,37 @@ namespace core{
          */
         void setDispatchAsync(bool value);
 
+        /**
+         * @returns true if every Session of this Connection delivers messages to its
+         *          consumers from its own dispatch thread.
+         */
+        bool isAlwaysSessionAsync() const;
+
+        /**
+         * Sets whether every Session delivers messages from its own dispatch thread.  When
+         * false an AUTO_ACKNOWLEDGE or DUPS_OK_ACKNOWLEDGE Session whose only consumer has a
+         * MessageListener runs the listener directly on the thread that received the message
+         * from the transport, saving a queue hop and a thread handoff per message.  Since the
+         * transport thread is shared by every Session of the Connection a slow listener then
+         * delays delivery to the others.  Such a listener must not wait for the broker, a
+         * synchronous send, commit or createConsumer call fails with an IllegalStateException
+         * instead of deadlocking the transport and its Session then goes back to delivering
+         * from its own thread.  Sessions created before the value is changed keep the mode
+         * they were created with, defaults to true.
+         *
+         * @param value
+         *      False to allow Sessions to dispatch on the transport thread.
+         */
+        void setAlwaysSessionAsync(bool value);
+
+        /**
+         * @returns true if the Connection's transport is read by a thread that is shared with
+         *          other Connections, as it is when a TCP transport sets transport.reactor=true.
+         *          Every Session then delivers messages from its own dispatch thread whatever
+         *          the value of alwaysSessionAsync.
+         */
+        bool isTransportReaderShared() const;
+
         /**
          * Gets if the Connection should always send things Synchronously.
          *
@@ -517,6 +550,141 @@ namespace core{
          */
         void setMessagePrioritySupported(bool value);
 
+        /**
+         * @returns true if the sessions and consumers of this Connection queue their
+         *          messages in a RingBufferMessageDispatchChannel.
+         */
+        bool isUseRingBufferDispatchChannel() const;
+
+        /**
+         * Sets whether the sessions and consumers of this Connection queue their messages
+         * in a RingBufferMessageDispatchChannel, whose ring is sized from the prefetch and
+         * whose producers do not take the lock the consumer dequeues under.  The channel
+         * does not order messages by priority so it is only used when message priority
+         * support is disabled, defaults to false.
+         *
+         * @param value
+         *      True to use the ring buffer based dispatch channel.
+         */
+        void setUseRingBufferDispatchChannel(bool value);
+
+        /**
+         * Gets if the Connection copies a Message before it is sent, this allows the
+         * application to reuse or modify the Message once the send method returns.
+         *
+         * @return true if Messages are copied before they are sent.
+         */
+        bool isCopyMessageOnSend() const;
+
+        /**
+         * Sets if the Connection copies a Message before it is sent.  When disabled the
+         * application hands the Message over to the Connection which sends it as it is
+         * and marks it read-only, the send then doesn't return until the transport is
+         * done with the Message.  A Message sent with a completion callback, or given
+         * more than once in a batch, is still copied.
+         *
+         * @param value
+         *      true if Messages should be copied before they are sent.
+         */
+        void setCopyMessageOnSend(bool value);
+
+        /**
+         * Gets if each Session dispatches its messages on a thread of its own, or if the
+         * Sessions share a pool of threads.
+         *
+         * @return true if each Session is given its own dispatch thread.
+         */
+        bool isUseDedicatedTaskRunner() const;
+
+        /**
+         * Sets if each Session dispatches its messages on a thread of its own, when disabled
+         * the Sessions of this Connection share a fixed size pool of dispatch threads.  In
+         * either case each Session's messages are delivered in order.  This setting applies
+         * to Sessions whose dispatch has not yet started.
+         *
+         * @param value
+         *      true if each Session should be given its own dispatch thread.
+         */
+        void setUseDedicatedTaskRunner(bool value);
+
+        /**
+         * Gets the number of threads in the pool shared by this Connection's Sessions when
+         * dedicated task runners are disabled.
+         *
+         * @return the number of pooled Session dispatch threads.
+         */
+        int getSessionTaskRunnerPoolSize() const;
+
+        /**
+         * Sets the number of threads in the pool shared by this Connection's Sessions when
+         * dedicated task runners are disabled, defaults to the number of processors.  This
+         * must be set before the pool is first used.
+         *
+         * @param value
+         *      The number of pooled Session dispatch threads.
+         */
+        void setSessionTaskRunnerPoolSize(int value);
+
+        /**
+         * Gets if the consumers of this Connection's auto acknowledge Sessions batch their
+         * acknowledgements rather than acknowledging each message as it is consumed.
+         *
+         * @return true if acknowledgements are batched.
+         */
+        bool isOptimizeAcknowledge() const;
+
+        /**
+         * Sets if the consumers of this Connection's auto acknowledge Sessions batch their
+         * acknowledgements.  When enabled a consumer acknowledges the messages it has consumed
+         * in a single MessageAck once the optimizeAcknowledgeRatio of its prefetch has been
+         * consumed or the optimizeAcknowledgeTimeOut has expired, messages that were consumed
+         * but not yet acknowledged are redelivered if the connection fails.  This setting
+         * applies to consumers created after it is changed.
+         *
+         * @param value
+         *      true if acknowledgements should be batched.
+         */
+        void setOptimizeAcknowledge(bool value);
+
+        /**
+         * Gets the time in milliseconds that a consumer holds back its batched
+         * acknowledgements when optimizeAcknowledge is enabled.
+         *
+         * @return the optimized acknowledge timeout in milliseconds.
+         */
+        long long getOptimizeAcknowledgeTimeOut() const;
+
+        /**
+         * Sets the time in milliseconds that a consumer holds back its batched
+         * acknowledgements when optimizeAcknowledge is enabled, once it expires the pending
+         * acknowledgements are sent even if the consumer is idle.  Zero disables the timeout
+         * and the acknowledgements are then only sent once enough messages are consumed.
+         * Defaults to 300 milliseconds.
+         *
+         * @param value
+         *      The optimized acknowledge timeout in milliseconds.
+         */
+        void setOptimizeAcknowledgeTimeOut(long long value);
+
+        /**
+         * Gets the fraction of a consumer's prefetch that must be consumed before its batched
+         * acknowledgements are sent when optimizeAcknowledge is enabled.
+         *
+         * @return the fraction of the prefetch that triggers an acknowledgement.
+         */
+        double getOptimizeAcknowledgeRatio() const;
+
+        /**
+         * Sets the fraction of a consumer's prefetch that must be consumed before its batched
+         * acknowledgements are sent when optimizeAcknowledge is enabled, defaults to 0.65.  The
+         * value should be less than one so that the broker can refill the prefetch before the
+         * consumer runs out of messages.
+         *
+         * @param value
+         *      The fraction of the prefetch that triggers an acknowledgement.
+         */
+        void setOptimizeAcknowledgeRatio(double value);
+
         /**
          * Get the Next Temporary Destination Id
          * @return the next id in the sequence.
@@ -626,6 +794,18 @@ namespace core{
          */
         Pointer<threads::Scheduler> getScheduler() const;
 
+        /**
+         * Creates the TaskRunner that a Session uses to dispatch its messages, depending on
+         * the configuration of this Connection it either has a thread of its own or it runs
+         * on the Connection's pool of Session threads.
+         *
+         * @param task
+         *      The Task that the new TaskRunner iterates, the caller retains ownership.
+         *
+         * @return a new TaskRunner for the given Task.
+         */
+        Pointer<threads::TaskRunner> createSessionTaskRunner(threads::Task* task);
+
         /**
          * Returns the Id of the Resource Manager that this client will use should
          * it be entered into an XA Transaction.
@@ -668,6 +848,50 @@ namespace core{
          */
         Pointer<commands::Response> syncRequest(Pointer<commands::Command> command, unsigned int timeout = 0);
 
+        /**
+         * Sends a request to the broker without waiting for the response, the callback is
+         * told of the outcome once the response arrives so that many requests can be in
+         * flight from a single thread.  Error responses from the broker are passed to the
+         * callback's onException method as a BrokerException.
+         *
+         * @param command
+         *      The Command object that is to be sent to the broker.
+         * @param onComplete
+         *      The callback that is notified of the response or failure of the request.
+         * @param timeout
+         *      The time in milliseconds to wait for a response, default is zero or infinite.
+         *
+         * @throws ActiveMQException if the Command could not be sent, in which case the
+         *         callback is not called.
+         */
+        void asyncRequest(Pointer<commands::Command> command,
+                          const Pointer<transport::ResponseCallback>& onComplete,
+                          unsigned int timeout = 0);
+
+        /**
+         * Marks the calling thread as delivering a message to a MessageListener straight
+         * from the transport.  Until endDirectDispatch is called any attempt by the thread
+         * to wait for the broker, which could only answer on this same thread, fails with
+         * an IllegalStateException rather than deadlocking the Connection.
+         */
+        void beginDirectDispatch();
+
+        /**
+         * Clears the mark set by beginDirectDispatch.
+         *
+         * @returns true if the thread tried to wait for the broker while it was marked, the
+         *          Session should then deliver its messages from its own thread from now on.
+         */
+        bool endDirectDispatch();
+
+        /**
+         * Checks that the calling thread may wait for a reply or a ProducerAck from the broker.
+         *
+         * @throws IllegalStateException if the thread is delivering a message to a
+         *         MessageListener straight from the transport.
+         */
+        void checkNotDispatchingDirectly();
+
         /**
          * Notify the exception listener
          * @param ex the exception to fire
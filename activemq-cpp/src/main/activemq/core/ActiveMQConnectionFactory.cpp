@@ -21,8 +21,11 @@
 #include <decaf/util/Properties.h>
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/Double.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <activemq/exceptions/ExceptionDefines.h>
 #include <activemq/transport/TransportRegistry.h>
@@ -71,9 +74,17 @@ namespace core{
         URI brokerURI;
 
         bool dispatchAsync;
+        bool alwaysSessionAsync;
         bool alwaysSyncSend;
         bool useAsyncSend;
         bool messagePrioritySupported;
+        bool useRingBufferDispatchChannel;
+        bool copyMessageOnSend;
+        bool useDedicatedTaskRunner;
+        int sessionTaskRunnerPoolSize;
+        bool optimizeAcknowledge;
+        long long optimizeAcknowledgeTimeOut;
+        double optimizeAcknowledgeRatio;
         bool useCompression;
         bool watchTopicAdvisories;
         int compressionLevel;
@@ -92,9 +103,17 @@ namespace core{
                             clientId(),
                             brokerURI(ActiveMQConnectionFactory::DEFAULT_URI),
                             dispatchAsync(true),
+                            alwaysSessionAsync(true),
                             alwaysSyncSend(false),
                             useAsyncSend(false),
                             messagePrioritySupported(true),
+                            useRingBufferDispatchChannel(false),
+                            copyMessageOnSend(true),
+                            useDedicatedTaskRunner(true),
+                            sessionTaskRunnerPoolSize(System::availableProcessors()),
+                            optimizeAcknowledge(false),
+                            optimizeAcknowledgeTimeOut(300),
+                            optimizeAcknowledgeRatio(0.65),
                             useCompression(false),
                             watchTopicAdvisories(true),
                             compressionLevel(-1),
@@ -150,11 +169,37 @@ namespace core{
             this->messagePrioritySupported = Boolean::parseBoolean(
                 properties->getProperty( "connection.messagePrioritySupported", "true" ) );
 
+            this->useRingBufferDispatchChannel = Boolean::parseBoolean(
+                properties->getProperty( "connection.useRingBufferDispatchChannel", "false" ) );
+
+            this->copyMessageOnSend = Boolean::parseBoolean(
+                properties->getProperty( "connection.copyMessageOnSend", "true" ) );
+
+            // Either "dedicated" for a thread per Session or "pooled" to share a pool of threads.
+            this->useDedicatedTaskRunner =
+                properties->getProperty( "connection.sessionTaskRunner", "dedicated" ) != "pooled";
+
+            this->sessionTaskRunnerPoolSize = Integer::parseInt(
+                properties->getProperty( "connection.sessionTaskRunnerPoolSize",
+                                         Integer::toString( System::availableProcessors() ) ) );
+
+            this->optimizeAcknowledge = Boolean::parseBoolean(
+                properties->getProperty( "connection.optimizeAcknowledge", "false" ) );
+
+            this->optimizeAcknowledgeTimeOut = Long::parseLong(
+                properties->getProperty( "connection.optimizeAcknowledgeTimeOut", "300" ) );
+
+            this->optimizeAcknowledgeRatio = Double::parseDouble(
+                properties->getProperty( "connection.optimizeAcknowledgeRatio", "0.65" ) );
+
             this->dispatchAsync = Boolean::parseBoolean(
                 properties->getProperty(
                     core::ActiveMQConstants::toString(
                         core::ActiveMQConstants::CONNECTION_DISPATCHASYNC ), "true" ) );
 
+            this->alwaysSessionAsync = Boolean::parseBoolean(
+                properties->getProperty( "connection.alwaysSessionAsync", "true" ) );
+
             this->producerWindowSize = Integer::parseInt(
                 properties->getProperty(
                     core::ActiveMQConstants::toString(
@@ -358,6 +403,7 @@ void ActiveMQConnectionFactory::configureConnection(ActiveMQConnection* connecti
     connection->setUsername(this->settings->username);
     connection->setPassword(this->settings->password);
     connection->setDispatchAsync(this->settings->dispatchAsync);
+    connection->setAlwaysSessionAsync(this->settings->alwaysSessionAsync);
     connection->setAlwaysSyncSend(this->settings->alwaysSyncSend);
     connection->setUseAsyncSend(this->settings->useAsyncSend);
     connection->setUseCompression(this->settings->useCompression);
@@ -368,6 +414,13 @@ void ActiveMQConnectionFactory::configureConnection(ActiveMQConnection* connecti
     connection->setPrefetchPolicy(this->settings->defaultPrefetchPolicy->clone());
     connection->setRedeliveryPolicy(this->settings->defaultRedeliveryPolicy->clone());
     connection->setMessagePrioritySupported(this->settings->messagePrioritySupported);
+    connection->setUseRingBufferDispatchChannel(this->settings->useRingBufferDispatchChannel);
+    connection->setCopyMessageOnSend(this->settings->copyMessageOnSend);
+    connection->setUseDedicatedTaskRunner(this->settings->useDedicatedTaskRunner);
+    connection->setSessionTaskRunnerPoolSize(this->settings->sessionTaskRunnerPoolSize);
+    connection->setOptimizeAcknowledge(this->settings->optimizeAcknowledge);
+    connection->setOptimizeAcknowledgeTimeOut(this->settings->optimizeAcknowledgeTimeOut);
+    connection->setOptimizeAcknowledgeRatio(this->settings->optimizeAcknowledgeRatio);
     connection->setWatchTopicAdvisories(this->settings->watchTopicAdvisories);
 
     if (this->settings->defaultListener) {
@@ -474,6 +527,16 @@ void ActiveMQConnectionFactory::setDispatchAsync(bool value) {
     this->settings->dispatchAsync = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isAlwaysSessionAsync() const {
+    return this->settings->alwaysSessionAsync;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setAlwaysSessionAsync(bool value) {
+    this->settings->alwaysSessionAsync = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQConnectionFactory::isAlwaysSyncSend() const {
     return this->settings->alwaysSyncSend;
@@ -559,6 +622,76 @@ void ActiveMQConnectionFactory::setMessagePrioritySupported(bool value) {
     this->settings->messagePrioritySupported = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isUseRingBufferDispatchChannel() const {
+    return this->settings->useRingBufferDispatchChannel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setUseRingBufferDispatchChannel(bool value) {
+    this->settings->useRingBufferDispatchChannel = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isCopyMessageOnSend() const {
+    return this->settings->copyMessageOnSend;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setCopyMessageOnSend(bool value) {
+    this->settings->copyMessageOnSend = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isUseDedicatedTaskRunner() const {
+    return this->settings->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setUseDedicatedTaskRunner(bool value) {
+    this->settings->useDedicatedTaskRunner = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnectionFactory::getSessionTaskRunnerPoolSize() const {
+    return this->settings->sessionTaskRunnerPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setSessionTaskRunnerPoolSize(int value) {
+    this->settings->sessionTaskRunnerPoolSize = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isOptimizeAcknowledge() const {
+    return this->settings->optimizeAcknowledge;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setOptimizeAcknowledge(bool value) {
+    this->settings->optimizeAcknowledge = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnectionFactory::getOptimizeAcknowledgeTimeOut() const {
+    return this->settings->optimizeAcknowledgeTimeOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setOptimizeAcknowledgeTimeOut(long long value) {
+    this->settings->optimizeAcknowledgeTimeOut = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double ActiveMQConnectionFactory::getOptimizeAcknowledgeRatio() const {
+    return this->settings->optimizeAcknowledgeRatio;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setOptimizeAcknowledgeRatio(double value) {
+    this->settings->optimizeAcknowledgeRatio = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQConnectionFactory::isWatchTopicAdvisories() const {
     return this->settings->watchTopicAdvisories;
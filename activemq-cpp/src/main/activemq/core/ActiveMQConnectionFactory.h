@@ -263,6 +263,23 @@ namespace core{
          */
         void setDispatchAsync(bool value);
 
+        /**
+         * @returns true if every Session of the Connections this factory creates delivers
+         *          messages to its consumers from its own dispatch thread.
+         */
+        bool isAlwaysSessionAsync() const;
+
+        /**
+         * Sets whether every Session of the Connections this factory creates delivers
+         * messages from its own dispatch thread.  When false an AUTO_ACKNOWLEDGE or
+         * DUPS_OK_ACKNOWLEDGE Session whose only consumer has a MessageListener runs the
+         * listener on the transport thread, see ActiveMQConnection::setAlwaysSessionAsync.
+         *
+         * @param value
+         *      False to allow Sessions to dispatch on the transport thread.
+         */
+        void setAlwaysSessionAsync(bool value);
+
         /**
          * Gets if the Connection should always send things Synchronously.
          *
@@ -378,6 +395,116 @@ namespace core{
          */
         void setMessagePrioritySupported(bool value);
 
+        /**
+         * @returns true if the Connections that this factory creates queue their session and
+         *          consumer messages in a RingBufferMessageDispatchChannel.
+         */
+        bool isUseRingBufferDispatchChannel() const;
+
+        /**
+         * Sets whether the Connections that this factory creates queue their session and
+         * consumer messages in a RingBufferMessageDispatchChannel.  The channel does not
+         * order messages by priority so it only takes effect when message priority support
+         * is disabled.
+         *
+         * @param value
+         *      True to use the ring buffer based dispatch channel.
+         */
+        void setUseRingBufferDispatchChannel(bool value);
+
+        /**
+         * @returns true if the Connections that this factory creates copy each Message
+         * before it is sent.
+         */
+        bool isCopyMessageOnSend() const;
+
+        /**
+         * Sets whether the Connections that this factory creates copy each Message before
+         * it is sent, disabling this avoids the copy for applications that do not reuse or
+         * modify a Message once it has been sent.
+         *
+         * @param value
+         *      Boolean indicating if Messages should be copied before being sent.
+         */
+        void setCopyMessageOnSend(bool value);
+
+        /**
+         * @returns true if each Session of the Connections that this factory creates
+         * dispatches its messages on a thread of its own.
+         */
+        bool isUseDedicatedTaskRunner() const;
+
+        /**
+         * Sets whether each Session of the Connections that this factory creates gets its
+         * own dispatch thread, or if the Sessions of a Connection share a fixed size pool of
+         * threads.  Set from the URI with connection.sessionTaskRunner=dedicated|pooled.
+         *
+         * @param value
+         *      Boolean indicating if each Session should have its own dispatch thread.
+         */
+        void setUseDedicatedTaskRunner(bool value);
+
+        /**
+         * @returns the number of threads in each Connection's pool of Session dispatch threads.
+         */
+        int getSessionTaskRunnerPoolSize() const;
+
+        /**
+         * Sets the number of threads in each Connection's pool of Session dispatch threads,
+         * only used when dedicated task runners are disabled.  Defaults to the number of
+         * processors.
+         *
+         * @param value
+         *      The number of pooled Session dispatch threads.
+         */
+        void setSessionTaskRunnerPoolSize(int value);
+
+        /**
+         * @returns true if the consumers of the Connections that this factory creates batch
+         * their acknowledgements in auto acknowledge mode.
+         */
+        bool isOptimizeAcknowledge() const;
+
+        /**
+         * Sets whether the consumers of the Connections that this factory creates batch their
+         * acknowledgements in auto acknowledge mode, which greatly reduces the number of
+         * acknowledgements sent to the broker at the cost of redelivering the messages that
+         * were not yet acknowledged when a connection fails.
+         *
+         * @param value
+         *      Boolean indicating if acknowledgements should be batched.
+         */
+        void setOptimizeAcknowledge(bool value);
+
+        /**
+         * @returns the time in milliseconds that batched acknowledgements are held back.
+         */
+        long long getOptimizeAcknowledgeTimeOut() const;
+
+        /**
+         * Sets the time in milliseconds that batched acknowledgements are held back before
+         * they are sent, zero disables the timeout.  Defaults to 300 milliseconds.
+         *
+         * @param value
+         *      The optimized acknowledge timeout in milliseconds.
+         */
+        void setOptimizeAcknowledgeTimeOut(long long value);
+
+        /**
+         * @returns the fraction of a consumer's prefetch that is consumed before its batched
+         * acknowledgements are sent.
+         */
+        double getOptimizeAcknowledgeRatio() const;
+
+        /**
+         * Sets the fraction of a consumer's prefetch that is consumed before its batched
+         * acknowledgements are sent, defaults to 0.65.
+         *
+         * @param value
+         *      The fraction of the prefetch that triggers an acknowledgement.
+         */
+        void setOptimizeAcknowledgeRatio(double value);
+
         /**
          * Is the Connection created by this factory configured to watch for advisory messages
          * that inform the Connection about temporary destination create / destroy.
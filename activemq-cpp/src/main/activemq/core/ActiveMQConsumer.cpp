@@ -151,6 +151,15 @@ cms::Message* ActiveMQConsumer::receiveNoWait() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConsumer::receive(std::vector<cms::Message*>& messages, int maxMessages, int millisecs) {
+
+    try {
+        return this->config->kernel->receive(messages, maxMessages, millisecs);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumer::setMessageListener(cms::MessageListener* listener) {
 
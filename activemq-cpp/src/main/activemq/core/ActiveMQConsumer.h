@@ -75,6 +75,8 @@ namespace core{
 
         virtual cms::Message* receiveNoWait();
 
+        virtual int receive(std::vector<cms::Message*>& messages, int maxMessages, int millisecs);
+
         virtual void setMessageListener(cms::MessageListener* listener);
 
         virtual cms::MessageListener* getMessageListener() const;
@@ -92,3 +92,52 @@ void ActiveMQProducer::send(const cms::Destination* destination, cms::Message* m
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::send(cms::Message* message, cms::AsyncCallback* onComplete) {
+
+    try {
+        this->kernel->send(message, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::send(cms::Message* message, int deliveryMode, int priority,
+                            long long timeToLive, cms::AsyncCallback* onComplete) {
+
+    try {
+        this->kernel->send(message, deliveryMode, priority, timeToLive, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::send(const cms::Destination* destination, cms::Message* message,
+                            cms::AsyncCallback* onComplete) {
+
+    try {
+        this->kernel->send(destination, message, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::send(const cms::Destination* destination, cms::Message* message,
+                            int deliveryMode, int priority, long long timeToLive,
+                            cms::AsyncCallback* onComplete) {
+
+    try {
+        this->kernel->send(destination, message, deliveryMode, priority, timeToLive, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::send(const std::vector<cms::Message*>& messages) {
+
+    try {
+        this->kernel->send(messages);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
@@ -69,6 +69,20 @@ namespace core{
         virtual void send(const cms::Destination* destination, cms::Message* message,
                           int deliveryMode, int priority, long long timeToLive);
 
+        virtual void send(cms::Message* message, cms::AsyncCallback* onComplete);
+
+        virtual void send(cms::Message* message, int deliveryMode, int priority,
+                          long long timeToLive, cms::AsyncCallback* onComplete);
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          cms::AsyncCallback* onComplete);
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          int deliveryMode, int priority, long long timeToLive,
+                          cms::AsyncCallback* onComplete);
+
+        virtual void send(const std::vector<cms::Message*>& messages);
+
         /**
          * Sets the delivery mode for this Producer
          * @param mode - The DeliveryMode to use for Message sends.
@@ -18,13 +18,14 @@
 #include "ActiveMQSessionExecutor.h"
 
 #include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/PrefetchPolicy.h>
 #include <activemq/core/kernels/ActiveMQConsumerKernel.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/RingBufferMessageDispatchChannel.h>
 #include <activemq/commands/ConsumerInfo.h>
-#include <activemq/threads/DedicatedTaskRunner.h>
 
 using namespace std;
 using namespace activemq;
@@ -38,10 +39,13 @@ using namespace decaf::util::concurrent;
 
 ////////////////////////////////////////////////////////////////////////////////
 ActiveMQSessionExecutor::ActiveMQSessionExecutor(ActiveMQSessionKernel* session) :
-    session(session), messageQueue(), taskRunner() {
+    session(session), messageQueue(), taskRunner(), iterating() {
 
     if (this->session->getConnection()->isMessagePrioritySupported()) {
         this->messageQueue.reset(new SimplePriorityMessageDispatchChannel());
+    } else if (this->session->getConnection()->isUseRingBufferDispatchChannel()) {
+        this->messageQueue.reset(new RingBufferMessageDispatchChannel(
+            this->session->getConnection()->getPrefetchPolicy()->getQueuePrefetch()));
     } else {
         this->messageQueue.reset(new FifoMessageDispatchChannel());
     }
@@ -67,6 +71,10 @@ ActiveMQSessionExecutor::~ActiveMQSessionExecutor() {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionExecutor::execute(const Pointer<MessageDispatch>& dispatch) {
 
+    if (!this->session->isSessionAsyncDispatch() && dispatchDirectly(dispatch)) {
+        return;
+    }
+
     // Add the data to the queue.
     this->messageQueue->enqueue(dispatch);
     this->wakeup();
@@ -86,7 +94,7 @@ void ActiveMQSessionExecutor::wakeup() {
     Pointer<TaskRunner> taskRunner = this->taskRunner;
     synchronized(messageQueue.get()) {
         if (this->taskRunner == NULL) {
-            this->taskRunner.reset(new DedicatedTaskRunner(this));
+            this->taskRunner = this->session->getConnection()->createSessionTaskRunner(this);
         }
 
         taskRunner = this->taskRunner;
@@ -147,9 +155,62 @@ void ActiveMQSessionExecutor::dispatch(const Pointer<MessageDispatch>& dispatch)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQSessionExecutor::dispatchDirectly(const Pointer<MessageDispatch>& dispatch) {
+
+    // Anything still queued on the session, or being delivered by the session
+    // thread, must reach the listener first to preserve message order.
+    if (!this->messageQueue->isRunning() || !this->messageQueue->isEmpty() || this->iterating.get()) {
+        return false;
+    }
+
+    Pointer<ActiveMQConsumerKernel> consumer;
+
+    synchronized(&(this->session->consumers)) {
+        if (this->session->consumers.size() != 1 ||
+            !this->session->consumers.containsKey(dispatch->getConsumerId())) {
+            return false;
+        }
+
+        consumer = this->session->consumers.get(dispatch->getConsumerId());
+    }
+
+    if (consumer->getMessageListener() == NULL || consumer->getMessageAvailableCount() != 0) {
+        return false;
+    }
+
+    ActiveMQConnection* connection = this->session->getConnection();
+
+    connection->beginDirectDispatch();
+    try {
+        this->dispatch(dispatch);
+    } catch (...) {
+        connection->endDirectDispatch();
+        throw;
+    }
+
+    // The listener tried to wait for the broker, which would deadlock the transport
+    // thread, so from now on it is run from the session thread where it can block.
+    if (connection->endDirectDispatch()) {
+        this->session->setSessionAsyncDispatch(true);
+    }
+
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQSessionExecutor::iterate() {
 
+    this->iterating.set(true);
+    bool result = doIterate();
+    this->iterating.set(false);
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQSessionExecutor::doIterate() {
+
     try {
 
         synchronized(&(this->session->consumers)) {
@@ -25,6 +25,7 @@
 #include <activemq/threads/Task.h>
 #include <activemq/threads/TaskRunner.h>
 #include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 
 namespace activemq{
 namespace core{
@@ -53,6 +54,9 @@ namespace kernels{
         /** The Dispatcher TaskRunner */
         Pointer<activemq::threads::TaskRunner> taskRunner;
 
+        /** Set while the session thread is delivering messages. */
+        decaf::util::concurrent::atomic::AtomicBoolean iterating;
+
     private:
 
         ActiveMQSessionExecutor(const ActiveMQSessionExecutor&);
@@ -72,7 +76,9 @@ namespace kernels{
 
         /**
          * Executes the dispatch.  Adds the given data to the
-         * end of the queue.
+         * end of the queue, or when the session does not require
+         * asynchronous dispatch and nothing is pending delivers it
+         * directly to its consumer on the calling thread.
          * @param data - the data to be dispatched.
          */
         virtual void execute(const Pointer<MessageDispatch>& data);
@@ -166,6 +172,19 @@ namespace kernels{
          */
         virtual void dispatch(const Pointer<MessageDispatch>& data);
 
+        /**
+         * Delivers the message on the calling thread if the session has a single
+         * consumer with a MessageListener and there are no messages pending that
+         * would have to be delivered before it.
+         *
+         * @param data - The message to be dispatched.
+         *
+         * @return true if the message was dispatched.
+         */
+        bool dispatchDirectly(const Pointer<MessageDispatch>& data);
+
+        bool doIterate();
+
     };
 
 }}
@@ -0,0 +1,101 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DispatchedMessageList.h"
+
+#include <decaf/util/NoSuchElementException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+DispatchedMessageList::DispatchedMessageList() : dispatches(), index(), mutex() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DispatchedMessageList::~DispatchedMessageList() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageList::addFirst( const Pointer<MessageDispatch>& dispatch ) {
+
+    DispatchIndex::iterator entry = this->index.find( dispatch.get() );
+    if( entry != this->index.end() ) {
+        this->dispatches.erase( entry->second );
+        this->index.erase( entry );
+    }
+
+    this->dispatches.push_front( dispatch );
+    this->index.insert( std::make_pair( dispatch.get(), this->dispatches.begin() ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DispatchedMessageList::remove( const Pointer<MessageDispatch>& dispatch ) {
+
+    DispatchIndex::iterator entry = this->index.find( dispatch.get() );
+    if( entry == this->index.end() ) {
+        return false;
+    }
+
+    this->dispatches.erase( entry->second );
+    this->index.erase( entry );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DispatchedMessageList::contains( const Pointer<MessageDispatch>& dispatch ) const {
+    return this->index.find( dispatch.get() ) != this->index.end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> DispatchedMessageList::getFirst() const {
+
+    if( this->index.empty() ) {
+        throw NoSuchElementException(
+            __FILE__, __LINE__, "No messages have been delivered." );
+    }
+
+    return this->dispatches.front();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> DispatchedMessageList::getLast() const {
+
+    if( this->index.empty() ) {
+        throw NoSuchElementException(
+            __FILE__, __LINE__, "No messages have been delivered." );
+    }
+
+    return this->dispatches.back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector< Pointer<MessageDispatch> > DispatchedMessageList::toArray() const {
+    return std::vector< Pointer<MessageDispatch> >( this->dispatches.begin(), this->dispatches.end() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageList::clear() {
+    this->index.clear();
+    this->dispatches.clear();
+}
@@ -0,0 +1,194 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_DISPATCHEDMESSAGELIST_H_
+#define _ACTIVEMQ_CORE_DISPATCHEDMESSAGELIST_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/commands/MessageDispatch.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Synchronizable.h>
+
+#include <list>
+#include <map>
+#include <vector>
+
+namespace activemq {
+namespace core {
+
+    using decaf::lang::Pointer;
+    using activemq::commands::MessageDispatch;
+
+    /**
+     * Holds the messages a consumer has delivered but not yet acknowledged, most recently
+     * delivered first.
+     *
+     * The messages are kept in a list in delivery order along with an index from each
+     * MessageDispatch to its place in the list, so checking whether a message is held and
+     * removing it no longer require a scan of the list, and the first and last messages
+     * needed to build an ack for all delivered messages are available directly.  Messages
+     * are identified by their MessageDispatch instance, as a redelivered message can carry
+     * the same MessageId as one that is already held.
+     *
+     * The list is not thread safe, callers synchronize on it while they use it.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API DispatchedMessageList : public decaf::util::concurrent::Synchronizable {
+    private:
+
+        typedef std::list< Pointer<MessageDispatch> > DispatchList;
+        typedef std::map< const MessageDispatch*, DispatchList::iterator > DispatchIndex;
+
+        DispatchList dispatches;
+        DispatchIndex index;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+    private:
+
+        DispatchedMessageList( const DispatchedMessageList& );
+        DispatchedMessageList& operator= ( const DispatchedMessageList& );
+
+    public:
+
+        DispatchedMessageList();
+
+        virtual ~DispatchedMessageList();
+
+        /**
+         * Adds a delivered message to the front of the list, if the message is already
+         * held it is moved to the front.
+         *
+         * @param dispatch
+         *      The MessageDispatch that was delivered.
+         */
+        void addFirst( const Pointer<MessageDispatch>& dispatch );
+
+        /**
+         * Removes the given message from the list.
+         *
+         * @param dispatch
+         *      The MessageDispatch to remove.
+         *
+         * @returns true if the message was held in the list.
+         */
+        bool remove( const Pointer<MessageDispatch>& dispatch );
+
+        /**
+         * @param dispatch
+         *      The MessageDispatch to look for.
+         *
+         * @returns true if the given message is held in the list.
+         */
+        bool contains( const Pointer<MessageDispatch>& dispatch ) const;
+
+        /**
+         * @returns the most recently delivered message.
+         *
+         * @throws NoSuchElementException if the list is empty.
+         */
+        Pointer<MessageDispatch> getFirst() const;
+
+        /**
+         * @returns the eldest delivered message.
+         *
+         * @throws NoSuchElementException if the list is empty.
+         */
+        Pointer<MessageDispatch> getLast() const;
+
+        /**
+         * @returns a copy of the messages held, most recently delivered first.
+         */
+        std::vector< Pointer<MessageDispatch> > toArray() const;
+
+        /**
+         * Removes all messages from the list.
+         */
+        void clear();
+
+        /**
+         * @returns the number of messages held.
+         */
+        int size() const {
+            return (int) this->index.size();
+        }
+
+        /**
+         * @returns true if no messages are held.
+         */
+        bool isEmpty() const {
+            return this->index.empty();
+        }
+
+    public:
+
+        virtual void lock() throw( decaf::lang::exceptions::RuntimeException ) {
+            mutex.lock();
+        }
+
+        virtual bool tryLock() throw( decaf::lang::exceptions::RuntimeException ) {
+            return mutex.tryLock();
+        }
+
+        virtual void unlock() throw( decaf::lang::exceptions::RuntimeException ) {
+            mutex.unlock();
+        }
+
+        virtual void wait() throw( decaf::lang::exceptions::RuntimeException,
+                                   decaf::lang::exceptions::IllegalMonitorStateException,
+                                   decaf::lang::exceptions::InterruptedException ) {
+
+            mutex.wait();
+        }
+
+        virtual void wait( long long millisecs )
+            throw( decaf::lang::exceptions::RuntimeException,
+                   decaf::lang::exceptions::IllegalMonitorStateException,
+                   decaf::lang::exceptions::InterruptedException ) {
+
+            mutex.wait( millisecs );
+        }
+
+        virtual void wait( long long millisecs, int nanos )
+            throw( decaf::lang::exceptions::RuntimeException,
+                   decaf::lang::exceptions::IllegalArgumentException,
+                   decaf::lang::exceptions::IllegalMonitorStateException,
+                   decaf::lang::exceptions::InterruptedException ) {
+
+            mutex.wait( millisecs, nanos );
+        }
+
+        virtual void notify() throw( decaf::lang::exceptions::RuntimeException,
+                                     decaf::lang::exceptions::IllegalMonitorStateException ) {
+
+            mutex.notify();
+        }
+
+        virtual void notifyAll() throw( decaf::lang::exceptions::RuntimeException,
+                                        decaf::lang::exceptions::IllegalMonitorStateException ) {
+
+            mutex.notifyAll();
+        }
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_DISPATCHEDMESSAGELIST_H_ */
@@ -96,6 +96,24 @@ Pointer<MessageDispatch> FifoMessageDispatchChannel::dequeueNoWait() {
     return Pointer<MessageDispatch>();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int FifoMessageDispatchChannel::dequeueAll( std::vector< Pointer<MessageDispatch> >& result, int maxMessages ) {
+    int count = 0;
+
+    synchronized( &channel ) {
+        if( closed || !running ) {
+            return 0;
+        }
+
+        while( !channel.isEmpty() && ( maxMessages <= 0 || count < maxMessages ) ) {
+            result.push_back( channel.pop() );
+            count++;
+        }
+    }
+
+    return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageDispatch> FifoMessageDispatchChannel::peek() const {
     synchronized( &channel ) {
@@ -64,6 +64,8 @@ namespace core {
 
         virtual Pointer<MessageDispatch> dequeueNoWait();
 
+        virtual int dequeueAll( std::vector< Pointer<MessageDispatch> >& result, int maxMessages );
+
         virtual Pointer<MessageDispatch> peek() const;
 
         virtual void start();
@@ -86,6 +86,21 @@ namespace core {
          */
         virtual Pointer<MessageDispatch> dequeueNoWait() = 0;
 
+        /**
+         * Removes the messages that are queued right now, in the order they would be
+         * returned from dequeueNoWait, and appends them to the given vector.  Unlike
+         * removeAll this method honors the running and closed state of the Channel and
+         * never blocks.
+         *
+         * @param result
+         *      The vector the dequeued messages are appended to.
+         * @param maxMessages
+         *      The maximum number of messages to dequeue, zero or less for no limit.
+         *
+         * @return the number of messages that were appended to the vector.
+         */
+        virtual int dequeueAll( std::vector< Pointer<MessageDispatch> >& result, int maxMessages ) = 0;
+
         /**
          * Peek in the Queue and return the first message in the Channel without removing
          * it from the channel.
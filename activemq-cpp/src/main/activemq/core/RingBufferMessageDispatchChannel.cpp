@@ -0,0 +1,346 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RingBufferMessageDispatchChannel.h"
+
+#include <decaf/internal/util/concurrent/Atomics.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::internal::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+const int RingBufferMessageDispatchChannel::MIN_CAPACITY = 16;
+const int RingBufferMessageDispatchChannel::MAX_CAPACITY = 8192;
+
+////////////////////////////////////////////////////////////////////////////////
+struct RingBufferMessageDispatchChannel::Slot {
+
+    Pointer<MessageDispatch> value;
+
+    // Equal to the position that may write this slot while it is free, and to that
+    // position plus one once the value written there can be read.
+    volatile int sequence;
+
+    Slot() : value(), sequence(0) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+RingBufferMessageDispatchChannel::RingBufferMessageDispatchChannel(int capacity) :
+    closed(false), running(false), capacity(MIN_CAPACITY), mask(0), ring(NULL), tail(0), head(0),
+    count(0), overflowCount(0), waiters(0), mutex(), dequeueLock(), front(), overflow() {
+
+    while (this->capacity < capacity && this->capacity < MAX_CAPACITY) {
+        this->capacity <<= 1;
+    }
+
+    this->mask = this->capacity - 1;
+    this->ring = new Slot[this->capacity];
+
+    for (int i = 0; i < this->capacity; ++i) {
+        this->ring[i].sequence = i;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+RingBufferMessageDispatchChannel::~RingBufferMessageDispatchChannel() {
+    delete [] this->ring;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannel::enqueue(const Pointer<MessageDispatch>& message) {
+
+    // Once a message has gone to the overflow list later ones must follow it there
+    // until it is drained or they would be delivered ahead of it.
+    if (this->overflowCount != 0 || !offer(message)) {
+        synchronized(&dequeueLock) {
+            this->overflow.addLast(message);
+            Atomics::incrementAndGet(&this->overflowCount);
+        }
+    }
+
+    added();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannel::enqueueFirst(const Pointer<MessageDispatch>& message) {
+
+    synchronized(&dequeueLock) {
+        this->front.addFirst(message);
+    }
+
+    added();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool RingBufferMessageDispatchChannel::isEmpty() const {
+    return this->count <= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> RingBufferMessageDispatchChannel::dequeue(long long timeout) {
+
+    Pointer<MessageDispatch> result;
+
+    while (!this->closed) {
+
+        if (this->running) {
+            synchronized(&dequeueLock) {
+                if (poll(result)) {
+                    return result;
+                }
+            }
+        }
+
+        if (timeout == 0) {
+            break;
+        }
+
+        // The dequeue lock is never held while waiting, producers that overflow the
+        // ring take it while the caller of enqueue can hold this channel's lock.
+        synchronized(&mutex) {
+            Atomics::incrementAndGet(&this->waiters);
+            try {
+                while (!this->closed && (this->count <= 0 || !this->running)) {
+                    if (timeout == -1) {
+                        mutex.wait();
+                    } else {
+                        mutex.wait((unsigned long) timeout);
+                        break;
+                    }
+                }
+            } catch (...) {
+                Atomics::decrementAndGet(&this->waiters);
+                throw;
+            }
+            Atomics::decrementAndGet(&this->waiters);
+        }
+
+        if (timeout != -1) {
+            if (!this->closed && this->running) {
+                synchronized(&dequeueLock) {
+                    poll(result);
+                }
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> RingBufferMessageDispatchChannel::dequeueNoWait() {
+
+    Pointer<MessageDispatch> result;
+
+    if (this->closed || !this->running) {
+        return result;
+    }
+
+    synchronized(&dequeueLock) {
+        poll(result);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int RingBufferMessageDispatchChannel::dequeueAll(std::vector< Pointer<MessageDispatch> >& result, int maxMessages) {
+
+    int dequeued = 0;
+
+    if (this->closed || !this->running) {
+        return dequeued;
+    }
+
+    synchronized(&dequeueLock) {
+        Pointer<MessageDispatch> message;
+        while ((maxMessages <= 0 || dequeued < maxMessages) && poll(message)) {
+            result.push_back(message);
+            dequeued++;
+        }
+    }
+
+    return dequeued;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> RingBufferMessageDispatchChannel::peek() const {
+
+    if (this->closed || !this->running) {
+        return Pointer<MessageDispatch>();
+    }
+
+    synchronized(&dequeueLock) {
+        if (!this->front.isEmpty()) {
+            return this->front.getFirst();
+        }
+
+        const Slot& slot = this->ring[this->head & this->mask];
+        if (slot.sequence == (int) ((unsigned int) this->head + 1)) {
+            return slot.value;
+        }
+
+        if (!this->overflow.isEmpty()) {
+            return this->overflow.getFirst();
+        }
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannel::start() {
+    synchronized(&mutex) {
+        if (!this->closed) {
+            this->running = true;
+            mutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannel::stop() {
+    synchronized(&mutex) {
+        this->running = false;
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannel::close() {
+    synchronized(&mutex) {
+        if (!this->closed) {
+            this->running = false;
+            this->closed = true;
+        }
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannel::clear() {
+    synchronized(&dequeueLock) {
+        Pointer<MessageDispatch> discard;
+        while (poll(discard)) {
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int RingBufferMessageDispatchChannel::size() const {
+    int size = this->count;
+    return size < 0 ? 0 : size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector< Pointer<MessageDispatch> > RingBufferMessageDispatchChannel::removeAll() {
+
+    std::vector< Pointer<MessageDispatch> > result;
+
+    synchronized(&dequeueLock) {
+        Pointer<MessageDispatch> message;
+        while (poll(message)) {
+            result.push_back(message);
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool RingBufferMessageDispatchChannel::offer(const Pointer<MessageDispatch>& message) {
+
+    while (true) {
+
+        int position = this->tail;
+        Slot& slot = this->ring[position & this->mask];
+        int difference = (int) ((unsigned int) slot.sequence - (unsigned int) position);
+
+        if (difference == 0) {
+            if (Atomics::compareAndSet32(&this->tail, position, (int) ((unsigned int) position + 1))) {
+                slot.value = message;
+                Atomics::getAndSet(&slot.sequence, (int) ((unsigned int) position + 1));
+                return true;
+            }
+        } else if (difference < 0) {
+            // The consumer has not yet freed this slot, the ring is full.
+            return false;
+        }
+
+        // Another producer claimed this position first, try the next one.
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool RingBufferMessageDispatchChannel::take(Pointer<MessageDispatch>& result) {
+
+    Slot& slot = this->ring[this->head & this->mask];
+
+    if (slot.sequence != (int) ((unsigned int) this->head + 1)) {
+        return false;
+    }
+
+    result = slot.value;
+    slot.value.reset(NULL);
+    Atomics::getAndSet(&slot.sequence, (int) ((unsigned int) this->head + this->capacity));
+    this->head = (int) ((unsigned int) this->head + 1);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool RingBufferMessageDispatchChannel::poll(Pointer<MessageDispatch>& result) {
+
+    // Called with the dequeue lock held.
+
+    if (!this->front.isEmpty()) {
+        result = this->front.removeFirst();
+    } else if (!take(result)) {
+
+        if (this->overflowCount == 0) {
+            return false;
+        }
+
+        result = this->overflow.removeFirst();
+        Atomics::decrementAndGet(&this->overflowCount);
+    }
+
+    Atomics::decrementAndGet(&this->count);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannel::added() {
+
+    // Only the add that makes the channel non-empty can have a thread waiting on it,
+    // a waiter rechecks the count after registering itself so it can't miss this.
+    if (Atomics::getAndIncrement(&this->count) == 0 && this->waiters > 0) {
+        synchronized(&mutex) {
+            mutex.notifyAll();
+        }
+    }
+}
@@ -0,0 +1,211 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_RINGBUFFERMESSAGEDISPATCHCHANNEL_H_
+#define _ACTIVEMQ_CORE_RINGBUFFERMESSAGEDISPATCHCHANNEL_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/core/MessageDispatchChannel.h>
+
+#include <decaf/util/LinkedList.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/Pointer.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * A FIFO MessageDispatchChannel that stores its messages in a bounded ring of
+     * preallocated slots instead of a linked list.
+     *
+     * Any number of threads can enqueue messages, a producer claims a slot with a
+     * single compare and swap and never takes a lock or allocates memory unless the
+     * ring is full.  The dequeue side is serialized by a lock of its own that the
+     * producers never take, so the thread that dispatches messages into the channel
+     * and the thread that removes them do not contend with each other.  Waiting
+     * consumers are only signaled when the channel goes from empty to non-empty.
+     *
+     * The ring is sized from the consumer's prefetch, the broker never dispatches more
+     * than that so in the normal case every message fits.  Messages that are enqueued
+     * while the ring is full, and those placed at the front of the channel with
+     * enqueueFirst, are held in linked lists guarded by the dequeue lock.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API RingBufferMessageDispatchChannel : public MessageDispatchChannel {
+    private:
+
+        struct Slot;
+
+        static const int MIN_CAPACITY;
+        static const int MAX_CAPACITY;
+
+        volatile bool closed;
+        volatile bool running;
+
+        int capacity;
+        int mask;
+        Slot* ring;
+
+        // Producer position, claimed with a compare and swap.
+        volatile int tail;
+
+        // Consumer position, guarded by the dequeue lock.
+        int head;
+
+        // Messages held in the ring and the lists, updated after each add and remove.
+        volatile int count;
+
+        // Messages in the overflow list, producers check this before using the ring.
+        volatile int overflowCount;
+
+        // Threads blocked in dequeue.
+        volatile int waiters;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+        mutable decaf::util::concurrent::Mutex dequeueLock;
+
+        decaf::util::LinkedList< Pointer<MessageDispatch> > front;
+        decaf::util::LinkedList< Pointer<MessageDispatch> > overflow;
+
+    private:
+
+        RingBufferMessageDispatchChannel( const RingBufferMessageDispatchChannel& );
+        RingBufferMessageDispatchChannel& operator= ( const RingBufferMessageDispatchChannel& );
+
+    public:
+
+        /**
+         * Creates a new channel whose ring can hold at least the given number of
+         * messages, the capacity is rounded up to a power of two and kept within
+         * the limits this class supports.
+         *
+         * @param capacity
+         *      The number of messages the channel is expected to hold at once,
+         *      normally the prefetch size of the consumer.
+         */
+        RingBufferMessageDispatchChannel( int capacity );
+
+        virtual ~RingBufferMessageDispatchChannel();
+
+        virtual void enqueue( const Pointer<MessageDispatch>& message );
+
+        virtual void enqueueFirst( const Pointer<MessageDispatch>& message );
+
+        virtual bool isEmpty() const;
+
+        virtual bool isClosed() const {
+            return this->closed;
+        }
+
+        virtual bool isRunning() const {
+            return this->running;
+        }
+
+        virtual Pointer<MessageDispatch> dequeue( long long timeout );
+
+        virtual Pointer<MessageDispatch> dequeueNoWait();
+
+        virtual int dequeueAll( std::vector< Pointer<MessageDispatch> >& result, int maxMessages );
+
+        virtual Pointer<MessageDispatch> peek() const;
+
+        virtual void start();
+
+        virtual void stop();
+
+        virtual void close();
+
+        virtual void clear();
+
+        virtual int size() const;
+
+        virtual std::vector< Pointer<MessageDispatch> > removeAll();
+
+        /**
+         * @returns the number of messages the ring holds before enqueued messages
+         *          are placed in the overflow list.
+         */
+        int getCapacity() const {
+            return this->capacity;
+        }
+
+    public:
+
+        virtual void lock() throw( decaf::lang::exceptions::RuntimeException ) {
+            mutex.lock();
+        }
+
+        virtual bool tryLock() throw( decaf::lang::exceptions::RuntimeException ) {
+            return mutex.tryLock();
+        }
+
+        virtual void unlock() throw( decaf::lang::exceptions::RuntimeException ) {
+            mutex.unlock();
+        }
+
+        virtual void wait() throw( decaf::lang::exceptions::RuntimeException,
+                                   decaf::lang::exceptions::IllegalMonitorStateException,
+                                   decaf::lang::exceptions::InterruptedException ) {
+
+            mutex.wait();
+        }
+
+        virtual void wait( long long millisecs )
+            throw( decaf::lang::exceptions::RuntimeException,
+                   decaf::lang::exceptions::IllegalMonitorStateException,
+                   decaf::lang::exceptions::InterruptedException ) {
+
+            mutex.wait( millisecs );
+        }
+
+        virtual void wait( long long millisecs, int nanos )
+            throw( decaf::lang::exceptions::RuntimeException,
+                   decaf::lang::exceptions::IllegalArgumentException,
+                   decaf::lang::exceptions::IllegalMonitorStateException,
+                   decaf::lang::exceptions::InterruptedException ) {
+
+            mutex.wait( millisecs, nanos );
+        }
+
+        virtual void notify() throw( decaf::lang::exceptions::RuntimeException,
+                                     decaf::lang::exceptions::IllegalMonitorStateException ) {
+
+            mutex.notify();
+        }
+
+        virtual void notifyAll() throw( decaf::lang::exceptions::RuntimeException,
+                                        decaf::lang::exceptions::IllegalMonitorStateException ) {
+
+            mutex.notifyAll();
+        }
+
+    private:
+
+        bool offer( const Pointer<MessageDispatch>& message );
+
+        bool poll( Pointer<MessageDispatch>& result );
+
+        bool take( Pointer<MessageDispatch>& result );
+
+        void added();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_RINGBUFFERMESSAGEDISPATCHCHANNEL_H_ */
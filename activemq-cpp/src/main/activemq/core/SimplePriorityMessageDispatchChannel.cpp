@@ -19,6 +19,7 @@
 
 #include <cms/Message.h>
 
+#include <decaf/lang/Integer.h>
 #include <decaf/lang/Math.h>
 
 using namespace std;
@@ -34,9 +35,110 @@ using namespace decaf::util::concurrent;
 ////////////////////////////////////////////////////////////////////////////////
 const int SimplePriorityMessageDispatchChannel::MAX_PRIORITIES = 10;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int INITIAL_RING_CAPACITY = 16;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * A double ended queue of messages held in a circular array whose capacity is a power
+ * of two, the array is allocated on the first add and doubled whenever it fills.
+ */
+class SimplePriorityMessageDispatchChannel::MessageRing {
+private:
+
+    Pointer<MessageDispatch>* elements;
+    int capacity;
+    int head;
+    int count;
+
+private:
+
+    MessageRing( const MessageRing& );
+    MessageRing& operator= ( const MessageRing& );
+
+public:
+
+    MessageRing() : elements( NULL ), capacity( 0 ), head( 0 ), count( 0 ) {}
+
+    ~MessageRing() {
+        delete [] this->elements;
+    }
+
+    bool isEmpty() const {
+        return this->count == 0;
+    }
+
+    int size() const {
+        return this->count;
+    }
+
+    void addLast( const Pointer<MessageDispatch>& message ) {
+        ensureCapacity();
+        this->elements[( this->head + this->count ) & ( this->capacity - 1 )] = message;
+        this->count++;
+    }
+
+    void addFirst( const Pointer<MessageDispatch>& message ) {
+        ensureCapacity();
+        this->head = ( this->head - 1 ) & ( this->capacity - 1 );
+        this->elements[this->head] = message;
+        this->count++;
+    }
+
+    Pointer<MessageDispatch> removeFirst() {
+        Pointer<MessageDispatch> result;
+        result.swap( this->elements[this->head] );
+        this->head = ( this->head + 1 ) & ( this->capacity - 1 );
+        this->count--;
+        return result;
+    }
+
+    const Pointer<MessageDispatch>& getFirst() const {
+        return this->elements[this->head];
+    }
+
+    void drainTo( std::vector< Pointer<MessageDispatch> >& result ) {
+        while( this->count > 0 ) {
+            result.push_back( removeFirst() );
+        }
+    }
+
+    void clear() {
+        while( this->count > 0 ) {
+            removeFirst();
+        }
+    }
+
+private:
+
+    void ensureCapacity() {
+
+        if( this->count < this->capacity ) {
+            return;
+        }
+
+        int newCapacity = this->capacity == 0 ? INITIAL_RING_CAPACITY : this->capacity * 2;
+        Pointer<MessageDispatch>* newElements = new Pointer<MessageDispatch>[newCapacity];
+
+        for( int i = 0; i < this->count; ++i ) {
+            newElements[i].swap( this->elements[( this->head + i ) & ( this->capacity - 1 )] );
+        }
+
+        delete [] this->elements;
+        this->elements = newElements;
+        this->capacity = newCapacity;
+        this->head = 0;
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 SimplePriorityMessageDispatchChannel::SimplePriorityMessageDispatchChannel() :
-    closed( false ), running( false ), mutex(), channels( MAX_PRIORITIES ), enqueued( 0 ) {
+    closed( false ), running( false ), mutex(), channels( MAX_PRIORITIES ), enqueued( 0 ),
+    nonEmpty( 0 ), highest( -1 ) {
 
 }
 
@@ -47,7 +149,9 @@ SimplePriorityMessageDispatchChannel::~SimplePriorityMessageDispatchChannel() {
 ////////////////////////////////////////////////////////////////////////////////
 void SimplePriorityMessageDispatchChannel::enqueue( const Pointer<MessageDispatch>& message ) {
     synchronized( &mutex ) {
-        this->getChannel( message ).addLast( message );
+        int priority = getPriority( message );
+        this->channels[priority].addLast( message );
+        markNonEmpty( priority );
         this->enqueued++;
         mutex.notify();
     }
@@ -56,7 +160,9 @@ void SimplePriorityMessageDispatchChannel::enqueue( const Pointer<MessageDispatc
 ////////////////////////////////////////////////////////////////////////////////
 void SimplePriorityMessageDispatchChannel::enqueueFirst( const Pointer<MessageDispatch>& message ) {
     synchronized( &mutex ) {
-        this->getChannel( message ).addFirst( message );
+        int priority = getPriority( message );
+        this->channels[priority].addFirst( message );
+        markNonEmpty( priority );
         this->enqueued++;
         mutex.notify();
     }
@@ -103,6 +209,24 @@ Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::dequeueNoWait() {
     return Pointer<MessageDispatch>();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int SimplePriorityMessageDispatchChannel::dequeueAll( std::vector< Pointer<MessageDispatch> >& result, int maxMessages ) {
+    int count = 0;
+
+    synchronized( &mutex ) {
+        if( closed || !running ) {
+            return 0;
+        }
+
+        while( !isEmpty() && ( maxMessages <= 0 || count < maxMessages ) ) {
+            result.push_back( removeFirst() );
+            count++;
+        }
+    }
+
+    return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::peek() const {
     synchronized( &mutex ) {
@@ -150,6 +274,9 @@ void SimplePriorityMessageDispatchChannel::clear() {
         for( int i = 0; i < MAX_PRIORITIES; i++ ) {
             this->channels[i].clear();
         }
+        this->enqueued = 0;
+        this->nonEmpty = 0;
+        this->highest = -1;
     }
 }
 
@@ -167,57 +294,66 @@ std::vector< Pointer<MessageDispatch> > SimplePriorityMessageDispatchChannel::re
     std::vector< Pointer<MessageDispatch> > result;
 
     synchronized( &mutex ) {
+        result.reserve( this->enqueued );
         for( int i = MAX_PRIORITIES - 1; i >= 0; --i ) {
-            std::vector< Pointer<MessageDispatch> > temp( channels[i].toArray() );
-            result.insert( result.end(), temp.begin(), temp.end() );
-            this->enqueued -= (int)temp.size();
-            channels[i].clear();
+            channels[i].drainTo( result );
         }
+        this->enqueued = 0;
+        this->nonEmpty = 0;
+        this->highest = -1;
     }
 
     return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-LinkedList< Pointer<MessageDispatch> >& SimplePriorityMessageDispatchChannel::getChannel( const Pointer<MessageDispatch>& dispatch ) {
+int SimplePriorityMessageDispatchChannel::getPriority( const Pointer<MessageDispatch>& dispatch ) const {
 
     int priority = cms::Message::DEFAULT_MSG_PRIORITY;
 
     if( dispatch->getMessage() != NULL ) {
-        priority = Math::max( dispatch->getMessage()->getPriority(), 0 );
-        priority = Math::min( dispatch->getMessage()->getPriority(), 9 );
+        priority = Math::max( (int)dispatch->getMessage()->getPriority(), 0 );
+        priority = Math::min( priority, MAX_PRIORITIES - 1 );
     }
 
-    return this->channels[priority];
+    return priority;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SimplePriorityMessageDispatchChannel::markNonEmpty( int priority ) {
+
+    this->nonEmpty |= ( 1 << priority );
+    if( priority > this->highest ) {
+        this->highest = priority;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::removeFirst() {
 
-    if( this->enqueued > 0 ) {
-        for( int i = MAX_PRIORITIES - 1; i >= 0; i-- ) {
-            LinkedList< Pointer<MessageDispatch> >& channel = channels[i];
-            if( !channel.isEmpty() ) {
-                this->enqueued--;
-                return channel.pop();
-            }
-        }
+    if( this->highest < 0 ) {
+        return Pointer<MessageDispatch>();
     }
 
-    return Pointer<MessageDispatch>();
+    MessageRing& channel = channels[this->highest];
+    Pointer<MessageDispatch> result = channel.removeFirst();
+    this->enqueued--;
+
+    // Only when a level empties does the next highest have to be found.
+    if( channel.isEmpty() ) {
+        this->nonEmpty &= ~( 1 << this->highest );
+        this->highest = this->nonEmpty == 0 ? -1 : 31 - Integer::numberOfLeadingZeros( this->nonEmpty );
+    }
+
+    return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::getFirst() const {
 
-    if( this->enqueued > 0 ) {
-        for( int i = MAX_PRIORITIES - 1; i >= 0; i-- ) {
-            LinkedList< Pointer<MessageDispatch> >& channel = channels[i];
-            if( !channel.isEmpty() ) {
-                return channel.getFirst();
-            }
-        }
+    if( this->highest < 0 ) {
+        return Pointer<MessageDispatch>();
     }
 
-    return Pointer<MessageDispatch>();
+    return channels[this->highest].getFirst();
 }
@@ -21,7 +21,6 @@
 #include <activemq/util/Config.h>
 #include <activemq/core/MessageDispatchChannel.h>
 
-#include <decaf/util/LinkedList.h>
 #include <decaf/lang/ArrayPointer.h>
 #include <decaf/util/concurrent/Mutex.h>
 
@@ -30,9 +29,21 @@ namespace core {
 
     using decaf::lang::ArrayPointer;
 
+    /**
+     * A MessageDispatchChannel that delivers messages in priority order, and in FIFO order
+     * within a priority.
+     *
+     * Each priority level keeps its messages in a ring buffer that grows on demand, and a
+     * bitmap records which levels are non-empty so the highest priority with a message is
+     * found without scanning every level.  The highest non-empty level is cached, so when
+     * all messages share one priority, which is the common case, enqueue and dequeue only
+     * touch that level's ring.
+     */
     class AMQCPP_API SimplePriorityMessageDispatchChannel : public MessageDispatchChannel {
     private:
 
+        class MessageRing;
+
         static const int MAX_PRIORITIES;
 
         bool closed;
@@ -40,10 +51,16 @@ namespace core {
 
         mutable decaf::util::concurrent::Mutex mutex;
 
-        mutable ArrayPointer< decaf::util::LinkedList< Pointer<MessageDispatch> > > channels;
+        mutable ArrayPointer<MessageRing> channels;
 
         int enqueued;
 
+        // Bit N is set while the channel for priority N holds messages.
+        int nonEmpty;
+
+        // The highest priority whose channel holds messages, or -1 when empty.
+        int highest;
+
     private:
 
         SimplePriorityMessageDispatchChannel( const SimplePriorityMessageDispatchChannel& );
@@ -72,6 +89,8 @@ namespace core {
 
         virtual Pointer<MessageDispatch> dequeueNoWait();
 
+        virtual int dequeueAll( std::vector< Pointer<MessageDispatch> >& result, int maxMessages );
+
         virtual Pointer<MessageDispatch> peek() const;
 
         virtual void start();
@@ -138,7 +157,9 @@ namespace core {
 
     private:
 
-        decaf::util::LinkedList< Pointer<MessageDispatch> >& getChannel( const Pointer<MessageDispatch>& dispatch );
+        int getPriority( const Pointer<MessageDispatch>& dispatch ) const;
+
+        void markNonEmpty( int priority );
 
         Pointer<MessageDispatch> removeFirst();
 
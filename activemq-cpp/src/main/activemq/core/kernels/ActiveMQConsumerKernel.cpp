@@ -41,11 +41,14 @@
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/ActiveMQTransactionContext.h>
 #include <activemq/core/ActiveMQAckHandler.h>
+#include <activemq/core/DispatchedMessageList.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/RingBufferMessageDispatchChannel.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/threads/Scheduler.h>
+#include <activemq/threads/TimerWheel.h>
 #include <cms/ExceptionListener.h>
 #include <cms/MessageTransformer.h>
 #include <memory>
@@ -82,7 +85,7 @@ namespace kernels {
         AtomicBoolean deliveringAcks;
         AtomicBoolean started;
         Pointer<MessageDispatchChannel> unconsumedMessages;
-        decaf::util::LinkedList< decaf::lang::Pointer<commands::MessageDispatch> > dispatchedMessages;
+        DispatchedMessageList dispatchedMessages;
         long long lastDeliveredSequenceId;
         Pointer<commands::MessageAck> pendingAck;
         int deliveredCounter;
@@ -94,6 +97,11 @@ namespace kernels {
         Pointer<RedeliveryPolicy> redeliveryPolicy;
         Pointer<Exception> failureError;
         Pointer<Scheduler> scheduler;
+        volatile bool optimizeAcknowledge;
+        long long optimizeAcknowledgeTimeOut;
+        double optimizeAcknowledgeRatio;
+        long long optimizeAckTimestamp;
+        Pointer<Runnable> optimizedAckTask;
 
         ActiveMQConsumerKernelConfig() : listener(NULL),
                                          transformer(NULL),
@@ -112,7 +120,12 @@ namespace kernels {
                                          redeliveryDelay(0),
                                          redeliveryPolicy(),
                                          failureError(),
-                                         scheduler() {
+                                         scheduler(),
+                                         optimizeAcknowledge(false),
+                                         optimizeAcknowledgeTimeOut(0),
+                                         optimizeAcknowledgeRatio(0),
+                                         optimizeAckTimestamp(0),
+                                         optimizedAckTask() {
         }
     };
 
@@ -302,6 +315,41 @@ namespace kernels {
         }
     };
 
+    /**
+     * Class used to periodically send the acks an optimized acknowledge consumer has
+     * batched, run from the shared TimerWheel.
+     */
+    class OptimizedAckTask : public Runnable {
+    private:
+
+        ActiveMQConsumerKernel* consumer;
+
+    private:
+
+        OptimizedAckTask(const OptimizedAckTask&);
+        OptimizedAckTask& operator=(const OptimizedAckTask&);
+
+    public:
+
+        OptimizedAckTask(ActiveMQConsumerKernel* consumer) : Runnable(), consumer(consumer) {
+
+            if (consumer == NULL) {
+                throw NullPointerException(
+                    __FILE__, __LINE__, "Optimized Ack Task Created with NULL Consumer.");
+            }
+        }
+
+        virtual ~OptimizedAckTask() {}
+
+        virtual void run() {
+            try {
+                this->consumer->deliverOptimizedAcks();
+            } catch(...) {
+                // The acks are sent again on the next run or when the consumer closes.
+            }
+        }
+    };
+
 }}}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -377,6 +425,8 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
 
     if (this->session->getConnection()->isMessagePrioritySupported()) {
         this->internal->unconsumedMessages.reset(new SimplePriorityMessageDispatchChannel());
+    } else if (this->session->getConnection()->isUseRingBufferDispatchChannel()) {
+        this->internal->unconsumedMessages.reset(new RingBufferMessageDispatchChannel(prefetch));
     } else {
         this->internal->unconsumedMessages.reset(new FifoMessageDispatchChannel());
     }
@@ -386,6 +436,26 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
     }
 
     applyDestinationOptions(this->consumerInfo);
+
+    // Acks can only be batched when they are sent for each message as it is consumed.
+    if (this->session->getConnection()->isOptimizeAcknowledge() &&
+        this->session->isAutoAcknowledge() && !this->consumerInfo->isBrowser()) {
+
+        this->internal->optimizeAcknowledge = true;
+        this->internal->optimizeAcknowledgeTimeOut = this->session->getConnection()->getOptimizeAcknowledgeTimeOut();
+        this->internal->optimizeAcknowledgeRatio = this->session->getConnection()->getOptimizeAcknowledgeRatio();
+        this->internal->optimizeAckTimestamp = System::currentTimeMillis();
+
+        if (this->internal->optimizeAcknowledgeTimeOut > 0) {
+            this->internal->optimizedAckTask.reset(new OptimizedAckTask(this));
+            TimerWheel::getInstance().scheduleAtFixedRate(
+                this->internal->optimizedAckTask.get(),
+                this->internal->optimizeAcknowledgeTimeOut,
+                this->internal->optimizeAcknowledgeTimeOut, false);
+        }
+    }
+
+    this->consumerInfo->setOptimizedAcknowledge(this->internal->optimizeAcknowledge);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -473,6 +543,11 @@ void ActiveMQConsumerKernel::dispose() {
 
         if (!this->isClosed()) {
 
+            // Waits for the task if it's running, the acks it would send are delivered below.
+            if (this->internal->optimizedAckTask != NULL) {
+                TimerWheel::getInstance().cancel(this->internal->optimizedAckTask.get());
+            }
+
             if (!session->isTransacted()) {
                 deliverAcks();
             }
@@ -501,9 +576,10 @@ void ActiveMQConsumerKernel::dispose() {
                 // For IndividualAck Mode we need to unlink the ack handler to remove a
                 // cyclic reference to the MessageDispatch that brought the message to us.
                 synchronized(&internal->dispatchedMessages) {
-                    std::auto_ptr<Iterator<Pointer<MessageDispatch> > > iter(this->internal->dispatchedMessages.iterator());
-                    while (iter->hasNext()) {
-                        iter->next()->getMessage()->setAckHandler(Pointer<ActiveMQAckHandler>());
+                    std::vector< Pointer<MessageDispatch> > dispatched = this->internal->dispatchedMessages.toArray();
+                    std::vector< Pointer<MessageDispatch> >::const_iterator iter = dispatched.begin();
+                    for (; iter != dispatched.end(); ++iter) {
+                        (*iter)->getMessage()->setAckHandler(Pointer<ActiveMQAckHandler>());
                     }
 
                     this->internal->dispatchedMessages.clear();
@@ -666,6 +742,93 @@ cms::Message* ActiveMQConsumerKernel::receiveNoWait() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConsumerKernel::receive(std::vector<cms::Message*>& messages, int maxMessages, int millisecs) {
+
+    try {
+
+        this->checkClosed();
+
+        if (maxMessages <= 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__,
+                "The maximum number of messages must be greater than zero: %d", maxMessages);
+        }
+
+        // Send a request for a new message if needed, using the same timeout the single
+        // message receive methods would.
+        this->sendPullRequest(millisecs < 0 ? 0 : (millisecs == 0 ? -1 : millisecs));
+
+        std::vector< Pointer<MessageDispatch> > dispatches;
+        std::vector< Pointer<MessageDispatch> > consumed;
+
+        // Take everything that has already arrived with a single pass over the channel,
+        // only when none of it can be delivered do we wait for the next message.
+        this->internal->unconsumedMessages->dequeueAll(dispatches, maxMessages);
+
+        if (consumeBatch(dispatches, consumed)) {
+
+            // The channel ended before any message, return nothing as dequeue would.
+            if (consumed.empty()) {
+                return 0;
+            }
+
+        } else if (consumed.empty()) {
+
+            Pointer<MessageDispatch> message = dequeue(millisecs < 0 ? -1 : millisecs);
+            if (message == NULL) {
+                return 0;
+            }
+
+            beforeMessageIsConsumed(message);
+            consumed.push_back(message);
+
+            if (maxMessages > 1) {
+                dispatches.clear();
+                this->internal->unconsumedMessages->dequeueAll(dispatches, maxMessages - 1);
+                consumeBatch(dispatches, consumed);
+            }
+        }
+
+        // Need to clone the messages because the user is responsible for freeing
+        // its copy of the message, createCMSMessage will do this for us.  They are
+        // all created before any is acknowledged, if one fails none is returned or
+        // acked and the whole batch stays unacknowledged to be redelivered.
+        std::vector<cms::Message*> received;
+
+        try {
+
+            std::vector< Pointer<MessageDispatch> >::const_iterator iter = consumed.begin();
+            for (; iter != consumed.end(); ++iter) {
+                received.push_back(createCMSMessage(*iter).release());
+            }
+
+            // In auto acknowledge mode the ack made after the last message covers every
+            // message in the batch, the other modes only record the messages here.
+            if (isAutoAcknowledgeEach()) {
+                afterMessageIsConsumed(consumed.back(), false);
+            } else {
+                for (iter = consumed.begin(); iter != consumed.end(); ++iter) {
+                    afterMessageIsConsumed(*iter, false);
+                }
+            }
+
+        } catch (...) {
+
+            std::vector<cms::Message*>::const_iterator iter = received.begin();
+            for (; iter != received.end(); ++iter) {
+                delete *iter;
+            }
+
+            throw;
+        }
+
+        messages.insert(messages.end(), received.begin(), received.end());
+
+        return (int) consumed.size();
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::setMessageListener(cms::MessageListener* listener) {
 
@@ -704,6 +867,39 @@ void ActiveMQConsumerKernel::setMessageListener(cms::MessageListener* listener)
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConsumerKernel::consumeBatch(const std::vector< Pointer<MessageDispatch> >& dispatches,
+                                          std::vector< Pointer<MessageDispatch> >& consumed) {
+
+    for (std::size_t i = 0; i < dispatches.size(); ++i) {
+
+        const Pointer<MessageDispatch>& dispatch = dispatches[i];
+
+        if (dispatch->getMessage() == NULL) {
+
+            // Nothing after the end of the channel is delivered in this batch, what follows
+            // goes back in order, along with the end itself if it must wait for the next
+            // receive because the messages gathered before it are returned first.
+            std::size_t first = consumed.empty() ? i + 1 : i;
+            for (std::size_t j = dispatches.size(); j > first; --j) {
+                this->internal->unconsumedMessages->enqueueFirst(dispatches[j - 1]);
+            }
+
+            return true;
+
+        } else if (dispatch->getMessage()->isExpired()) {
+            beforeMessageIsConsumed(dispatch);
+            afterMessageIsConsumed(dispatch, true);
+            continue;
+        }
+
+        beforeMessageIsConsumed(dispatch);
+        consumed.push_back(dispatch);
+    }
+
+    return false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::beforeMessageIsConsumed(const Pointer<MessageDispatch>& dispatch) {
 
@@ -747,11 +943,36 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(const Pointer<MessageDispatc
 
                 synchronized(&this->internal->dispatchedMessages) {
                     if (!this->internal->dispatchedMessages.isEmpty()) {
-                        Pointer<MessageAck> ack = makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
 
-                        if (ack != NULL) {
-                            this->internal->dispatchedMessages.clear();
-                            session->oneway(ack);
+                        if (this->internal->optimizeAcknowledge) {
+
+                            // Expired messages are counted too, otherwise the consumer can
+                            // stall with the prefetch filled by messages that weren't acked.
+                            int pending = (int) this->internal->dispatchedMessages.size() + this->internal->deliveredCounter;
+
+                            if (pending >= this->consumerInfo->getPrefetchSize() * this->internal->optimizeAcknowledgeRatio ||
+                                (this->internal->optimizeAcknowledgeTimeOut > 0 &&
+                                 System::currentTimeMillis() >= this->internal->optimizeAckTimestamp + this->internal->optimizeAcknowledgeTimeOut)) {
+
+                                sendOptimizedAck();
+
+                                // Send the ack for the expired messages now as well so that they
+                                // aren't acked one at a time from ackLater.
+                                if (this->internal->pendingAck != NULL && this->internal->deliveredCounter > 0) {
+                                    session->oneway(this->internal->pendingAck);
+                                    this->internal->pendingAck.reset(NULL);
+                                    this->internal->deliveredCounter = 0;
+                                }
+                            }
+
+                        } else {
+
+                            Pointer<MessageAck> ack = makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
+
+                            if (ack != NULL) {
+                                this->internal->dispatchedMessages.clear();
+                                session->oneway(ack);
+                            }
                         }
                     }
                 }
@@ -815,10 +1036,82 @@ void ActiveMQConsumerKernel::deliverAcks() {
                     this->session->oneway(ack);
                 } catch (...) {
                 }
+            }
 
-            } else {
+            this->internal->deliveringAcks.set(false);
+        }
+    }
+    AMQ_CATCH_RETHROW( ActiveMQException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, ActiveMQException )
+    AMQ_CATCHALL_THROW( ActiveMQException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::deliverOptimizedAcks() {
+
+    try {
+
+        if (this->internal->deliveringAcks.compareAndSet(false, true)) {
+
+            try {
+
+                synchronized(&this->internal->dispatchedMessages) {
+
+                    if (this->internal->optimizeAcknowledge &&
+                        !this->internal->dispatchedMessages.isEmpty() &&
+                        System::currentTimeMillis() >= this->internal->optimizeAckTimestamp + this->internal->optimizeAcknowledgeTimeOut) {
+
+                        sendOptimizedAck();
+                    }
+                }
+
+            } catch (...) {
                 this->internal->deliveringAcks.set(false);
+                throw;
             }
+
+            this->internal->deliveringAcks.set(false);
+        }
+    }
+    AMQ_CATCH_RETHROW( ActiveMQException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, ActiveMQException )
+    AMQ_CATCHALL_THROW( ActiveMQException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::sendOptimizedAck() {
+
+    Pointer<MessageAck> ack = makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
+
+    if (ack != NULL) {
+        this->internal->dispatchedMessages.clear();
+        session->oneway(ack);
+    }
+
+    this->internal->optimizeAckTimestamp = System::currentTimeMillis();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConsumerKernel::isOptimizeAcknowledge() const {
+    return this->internal->optimizeAcknowledge;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::setOptimizeAcknowledge(bool value) {
+
+    try {
+
+        // Whether batching applies depends on the acknowledge mode of the Session so it is
+        // decided when the consumer is created, here it can only be turned off.
+        if (this->internal->optimizeAcknowledge && !value) {
+
+            this->internal->optimizeAcknowledge = false;
+
+            if (this->internal->optimizedAckTask != NULL) {
+                TimerWheel::getInstance().cancel(this->internal->optimizedAckTask.get());
+            }
+
+            deliverAcks();
         }
     }
     AMQ_CATCH_RETHROW( ActiveMQException )
@@ -921,13 +1214,7 @@ void ActiveMQConsumerKernel::acknowledge(const Pointer<commands::MessageDispatch
             session->oneway(ack);
 
             synchronized(&this->internal->dispatchedMessages) {
-                std::auto_ptr< Iterator< Pointer<MessageDispatch> > > iter(this->internal->dispatchedMessages.iterator());
-                while(iter->hasNext()) {
-                    if (iter->next() == dispatch) {
-                        iter->remove();
-                        break;
-                    }
-                }
+                this->internal->dispatchedMessages.remove(dispatch);
             }
 
         } else {
@@ -1001,10 +1288,11 @@ void ActiveMQConsumerKernel::rollback() {
 
             Pointer<MessageId> firstMsgId = this->internal->dispatchedMessages.getLast()->getMessage()->getMessageId();
 
-            std::auto_ptr<Iterator<Pointer<MessageDispatch> > > iter(internal->dispatchedMessages.iterator());
+            std::vector< Pointer<MessageDispatch> > dispatched = this->internal->dispatchedMessages.toArray();
+            std::vector< Pointer<MessageDispatch> >::const_iterator iter = dispatched.begin();
 
-            while (iter->hasNext()) {
-                Pointer<Message> message = iter->next()->getMessage();
+            for (; iter != dispatched.end(); ++iter) {
+                Pointer<Message> message = (*iter)->getMessage();
                 message->setRedeliveryCounter(message->getRedeliveryCounter() + 1);
             }
 
@@ -1045,10 +1333,8 @@ void ActiveMQConsumerKernel::rollback() {
                 // stop the delivery of messages.
                 this->internal->unconsumedMessages->stop();
 
-                std::auto_ptr<Iterator<Pointer<MessageDispatch> > > iter(
-                    this->internal->dispatchedMessages.iterator());
-                while (iter->hasNext()) {
-                    this->internal->unconsumedMessages->enqueueFirst(iter->next());
+                for (iter = dispatched.begin(); iter != dispatched.end(); ++iter) {
+                    this->internal->unconsumedMessages->enqueueFirst(*iter);
                 }
 
                 if (internal->redeliveryDelay > 0 && !this->internal->unconsumedMessages->isClosed()) {
@@ -1239,6 +1525,15 @@ void ActiveMQConsumerKernel::clearMessagesInProgress() {
 
                 // TODO - Rollback duplicates.
 
+                // Acks batched by the optimizeAcknowledge mode are for the subscription that
+                // was lost, the broker redelivers those messages to the restored consumer.
+                if (this->internal->optimizeAcknowledge) {
+                    synchronized(&this->internal->dispatchedMessages) {
+                        this->internal->dispatchedMessages.clear();
+                        this->internal->optimizeAckTimestamp = System::currentTimeMillis();
+                    }
+                }
+
                 // allow dispatch on this connection to resume
                 this->session->getConnection()->setTransportInterruptionProcessingComplete();
                 this->internal->inProgressClearRequiredFlag = false;
@@ -98,6 +98,8 @@ namespace kernels {
 
         virtual cms::Message* receiveNoWait();
 
+        virtual int receive(std::vector<cms::Message*>& messages, int maxMessages, int millisecs);
+
         virtual void setMessageListener(cms::MessageListener* listener);
 
         virtual cms::MessageListener* getMessageListener() const;
@@ -194,6 +196,31 @@ namespace kernels {
          */
         void deliverAcks();
 
+        /**
+         * Sends the acknowledgements batched by the optimizeAcknowledge mode if they have
+         * been held back for longer than the optimizeAcknowledgeTimeOut, called periodically
+         * so that an idle consumer doesn't hold on to them.
+         *
+         * @throw ActiveMQException if an error occurs while performing the operation.
+         */
+        void deliverOptimizedAcks();
+
+        /**
+         * @returns true if this consumer batches its acknowledgements.
+         */
+        bool isOptimizeAcknowledge() const;
+
+        /**
+         * Sets whether this consumer batches its acknowledgements.  Batching is decided from
+         * the Connection's settings when the consumer is created and only applies to auto
+         * acknowledge Sessions, so this can only turn it off, in which case the batched
+         * acknowledgements are sent right away.
+         *
+         * @param value
+         *      true if acknowledgements should be batched.
+         */
+        void setOptimizeAcknowledge(bool value);
+
         /**
          * Called on a Failover to clear any pending messages.
          */
@@ -311,6 +338,13 @@ namespace kernels {
         // and configuring appropriate ack handlers.
         Pointer<cms::Message> createCMSMessage(Pointer<commands::MessageDispatch> dispatch);
 
+        // Runs the pre-consume processing for each message of a batch taken from the channel,
+        // expired messages are acked and dropped and the rest appended to consumed.  Stops at
+        // a dispatch without a message, which ends the channel, and puts back what follows it.
+        // Returns true if it stopped at such a dispatch.
+        bool consumeBatch(const std::vector< Pointer<commands::MessageDispatch> >& dispatches,
+                          std::vector< Pointer<commands::MessageDispatch> >& consumed);
+
         // Using options from the Destination URI override any settings that are
         // defined for this consumer.
         void applyDestinationOptions(const Pointer<commands::ConsumerInfo>& info);
@@ -340,6 +374,10 @@ namespace kernels {
         // Can Acks be batched for less network overhead.
         bool isAutoAcknowledgeBatch() const;
 
+        // Sends one ack for all the messages consumed since the last optimized ack was sent,
+        // must be called with the dispatchedMessages lock held.
+        void sendOptimizedAck();
+
     };
 
 }}}
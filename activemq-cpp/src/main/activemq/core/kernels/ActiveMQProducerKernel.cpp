@@ -165,6 +165,50 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
 void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Message* message,
                                   int deliveryMode, int priority, long long timeToLive) {
 
+    try {
+        this->checkClosed();
+        this->send(destination, message, deliveryMode, priority, timeToLive, NULL);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::send(cms::Message* message, cms::AsyncCallback* onComplete) {
+
+    try {
+        this->checkClosed();
+        this->send(this->destination.get(), message, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::send(cms::Message* message, int deliveryMode, int priority,
+                                  long long timeToLive, cms::AsyncCallback* onComplete) {
+
+    try {
+        this->checkClosed();
+        this->send(this->destination.get(), message, deliveryMode, priority, timeToLive, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Message* message,
+                                  cms::AsyncCallback* onComplete) {
+
+    try {
+        this->checkClosed();
+        this->send(destination, message, defaultDeliveryMode, defaultPriority, defaultTimeToLive, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Message* message,
+                                  int deliveryMode, int priority, long long timeToLive,
+                                  cms::AsyncCallback* onComplete) {
+
     try {
 
         this->checkClosed();
@@ -217,6 +261,7 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
         }
 
         if (this->memoryUsage.get() != NULL) {
+            this->session->getConnection()->checkNotDispatchingDirectly();
             try {
                 this->memoryUsage->waitForSpace();
             } catch (InterruptedException& e) {
@@ -225,7 +270,57 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
         }
 
         this->session->send(this, dest, outbound, deliveryMode, priority, timeToLive,
-                            this->memoryUsage.get(), this->sendTimeout);
+                            this->memoryUsage.get(), this->sendTimeout, onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::send(const std::vector<cms::Message*>& messages) {
+
+    try {
+
+        this->checkClosed();
+
+        if (this->producerInfo->getDestination() == NULL) {
+            throw cms::UnsupportedOperationException("A destination must be specified.", NULL);
+        }
+
+        if (messages.empty()) {
+            return;
+        }
+
+        std::vector<cms::Message*> outbound;
+        std::vector< Pointer<cms::Message> > scopedMessages;
+        outbound.reserve(messages.size());
+
+        std::vector<cms::Message*>::const_iterator iter = messages.begin();
+        for (; iter != messages.end(); ++iter) {
+
+            cms::Message* message = *iter;
+
+            if (message == NULL) {
+                throw NullPointerException(__FILE__, __LINE__, "Cannot send a NULL message");
+            }
+
+            if (this->transformer != NULL) {
+                if (this->transformer->producerTransform(this->session, this, *iter, &message)) {
+                    // The transformed messages must remain valid until the whole batch
+                    // has been sent or the send throws an exception.
+                    scopedMessages.push_back(Pointer<cms::Message>(message));
+                }
+                if (message == NULL) {
+                    throw NullPointerException(__FILE__, __LINE__, "MessageTransformer set transformed message to NULL");
+                }
+            }
+
+            outbound.push_back(message);
+        }
+
+        // The session reserves room in the producer window for the messages sent
+        // asynchronously, waiting for it without holding its send lock.
+        this->session->send(this, this->producerInfo->getDestination(), outbound, defaultDeliveryMode,
+                            defaultPriority, defaultTimeToLive, this->memoryUsage.get(), this->sendTimeout);
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
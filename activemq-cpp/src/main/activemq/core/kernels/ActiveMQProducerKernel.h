@@ -125,6 +125,20 @@ namespace kernels {
         virtual void send(const cms::Destination* destination, cms::Message* message,
                           int deliveryMode, int priority, long long timeToLive);
 
+        virtual void send(cms::Message* message, cms::AsyncCallback* onComplete);
+
+        virtual void send(cms::Message* message, int deliveryMode, int priority,
+                          long long timeToLive, cms::AsyncCallback* onComplete);
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          cms::AsyncCallback* onComplete);
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          int deliveryMode, int priority, long long timeToLive,
+                          cms::AsyncCallback* onComplete);
+
+        virtual void send(const std::vector<cms::Message*>& messages);
+
         /**
          * Set an MessageTransformer instance that is applied to all cms::Message objects before they
          * are sent on to the CMS bus.
@@ -55,9 +55,12 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/Thread.h>
 #include <decaf/util/Queue.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/lang/exceptions/InterruptedException.h>
 #include <decaf/lang/exceptions/InvalidStateException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 
@@ -103,12 +106,13 @@ namespace kernels{
         ConsumersMap consumers;
         Mutex sendMutex;
         cms::MessageTransformer* transformer;
+        bool sessionAsyncDispatch;
 
     public:
 
         SessionConfig() : synchronizationRegistered(false),
                           producers(), scheduler(), closeSync(),
-                          consumers(), sendMutex(), transformer(NULL) {}
+                          consumers(), sendMutex(), transformer(NULL), sessionAsyncDispatch(true) {}
         ~SessionConfig() {}
     };
 
@@ -188,6 +192,147 @@ namespace kernels{
         }
     };
 
+    /**
+     * Completes an asynchronous send by passing the broker's acknowledgement of the
+     * message on to the callback the application gave to the producer.
+     */
+    class AsyncSendCallback : public transport::ResponseCallback {
+    private:
+
+        cms::AsyncCallback* onComplete;
+
+    private:
+
+        AsyncSendCallback(const AsyncSendCallback&);
+        AsyncSendCallback& operator=(const AsyncSendCallback&);
+
+    public:
+
+        AsyncSendCallback(cms::AsyncCallback* onComplete) :
+            transport::ResponseCallback(), onComplete(onComplete) {}
+
+        virtual ~AsyncSendCallback() {}
+
+        virtual void onResponse(const Pointer<Response>& response AMQCPP_UNUSED) {
+            this->onComplete->onSuccess();
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex) {
+            this->onComplete->onException(CMSExceptionSupport::create(ex));
+        }
+    };
+
+
+    /**
+     * Collects the broker's acknowledgements for the messages of a batch send so that
+     * the sending thread can wait for all of them at once, the first failure reported
+     * is the one thrown to the sender.
+     */
+    class BatchSendCallback : public transport::ResponseCallback {
+    private:
+
+        CountDownLatch done;
+        Mutex mutex;
+        std::auto_ptr<decaf::lang::Exception> failure;
+
+    private:
+
+        BatchSendCallback(const BatchSendCallback&);
+        BatchSendCallback& operator=(const BatchSendCallback&);
+
+    public:
+
+        BatchSendCallback(int count) :
+            transport::ResponseCallback(), done(count), mutex(), failure() {}
+
+        virtual ~BatchSendCallback() {}
+
+        virtual void onResponse(const Pointer<Response>& response AMQCPP_UNUSED) {
+            this->done.countDown();
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex) {
+            synchronized(&this->mutex) {
+                if (this->failure.get() == NULL) {
+                    this->failure.reset(ex.clone());
+                }
+            }
+            this->done.countDown();
+        }
+
+        void await() {
+            this->done.await();
+
+            synchronized(&this->mutex) {
+                if (this->failure.get() != NULL) {
+                    throw CMSExceptionSupport::create(*this->failure);
+                }
+            }
+        }
+    };
+
+    /**
+     * Tracks the application's messages that a send passes to the transport without
+     * copying them when the connection isn't set to copy messages on send.
+     *
+     * The application still owns those messages, so the send must not return before the
+     * transport is done with them and the last reference the library holds must not
+     * destroy them.  The transport normally lets go of a message by the time it has been
+     * written, a transport that queues its writes or keeps a request for a later replay
+     * holds it a little longer and the send waits for that.  Declared ahead of anything
+     * else in the send that refers to the messages so it is destroyed after them.
+     */
+    class MessageHandOver {
+    private:
+
+        std::vector< Pointer<commands::Message> > messages;
+        std::vector<int> baseCounts;
+
+    private:
+
+        MessageHandOver(const MessageHandOver&);
+        MessageHandOver& operator=(const MessageHandOver&);
+
+    public:
+
+        MessageHandOver() : messages(), baseCounts() {}
+
+        ~MessageHandOver() {
+
+            for (std::size_t i = 0; i < this->messages.size(); ++i) {
+
+                // Only the reference held here is expected to remain, along with any the
+                // application itself held before the send.
+                int spins = 0;
+                while (this->messages[i]->getReferenceCount() > this->baseCounts[i] + 1) {
+                    if (++spins < 100) {
+                        Thread::yield();
+                    } else {
+                        Thread::sleep(1);
+                    }
+                }
+
+                // Drops the reference without destroying the message.
+                this->messages[i].release();
+            }
+        }
+
+        bool contains(const commands::Message* message) const {
+            for (std::size_t i = 0; i < this->messages.size(); ++i) {
+                if (this->messages[i].get() == message) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        Pointer<commands::Message> add(commands::Message* message) {
+            this->baseCounts.push_back(message->getReferenceCount());
+            this->messages.push_back(Pointer<commands::Message>(message));
+            return this->messages.back();
+        }
+    };
+
 }}}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -225,6 +370,12 @@ ActiveMQSessionKernel::ActiveMQSessionKernel(ActiveMQConnection* connection,
     // Create a Transaction objet
     this->transaction.reset(new ActiveMQTransactionContext(this, properties));
 
+    // Only sessions that acknowledge on their own can be dispatched to from the transport thread,
+    // and not when that thread is a reactor thread that other connections depend on.
+    this->config->sessionAsyncDispatch = this->connection->isAlwaysSessionAsync() ||
+                                         !(isAutoAcknowledge() || isDupsOkAcknowledge()) ||
+                                         this->connection->isTransportReaderShared();
+
     // Create the session executor object.
     this->executor.reset(new ActiveMQSessionExecutor(this));
 
@@ -480,6 +631,19 @@ void ActiveMQSessionKernel::deliverAcks() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::setOptimizeAcknowledge(bool value) {
+
+    synchronized(&this->consumers) {
+        std::vector< Pointer<ActiveMQConsumerKernel> > consumers = this->consumers.values();
+
+        std::vector< Pointer<ActiveMQConsumerKernel> >::iterator iter = consumers.begin();
+        for (; iter != consumers.end(); ++iter) {
+            (*iter)->setOptimizeAcknowledge(value);
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::MessageConsumer* ActiveMQSessionKernel::createConsumer(const cms::Destination* destination) {
 
@@ -845,7 +1009,8 @@ bool ActiveMQSessionKernel::isTransacted() const {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
                                  cms::Message* message, int deliveryMode, int priority, long long timeToLive,
-                                 util::MemoryUsage* producerWindow, long long sendTimeout) {
+                                 util::MemoryUsage* producerWindow, long long sendTimeout,
+                                 cms::AsyncCallback* onComplete) {
 
     try {
 
@@ -859,72 +1024,29 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
             }
         }
 
+        // A send that completes asynchronously always copies the message, the transport
+        // holds on to it until the broker has confirmed it.
+        MessageHandOver handOver;
+
         synchronized(&this->config->sendMutex) {
 
             // Ensure that a new transaction is started if this is the first message
             // sent since the last commit, Broker is notified of a new TX.
             doStartTransaction();
 
-            Pointer<TransactionId> txId = this->transaction->getTransactionId();
-            Pointer<ProducerInfo> producerInfo = producer->getProducerInfo();
-            Pointer<ProducerId> producerId = producerInfo->getProducerId();
-            long long sequenceId = producer->getNextMessageSequence();
-
-            // Set the "CMS" header fields on the original message, see JMS 1.1 spec section 3.4.11
-            message->setCMSDeliveryMode(deliveryMode);
-            long long expiration = 0LL;
-            if (!producer->getDisableMessageTimeStamp()) {
-                long long timeStamp = System::currentTimeMillis();
-                message->setCMSTimestamp(timeStamp);
-                if (timeToLive > 0) {
-                    expiration = timeToLive + timeStamp;
-                }
-            }
-            message->setCMSExpiration(expiration);
-            message->setCMSPriority(priority);
-            message->setCMSRedelivered(false);
-
-            // transform to our own message format here
-            commands::Message* transformed = NULL;
-            Pointer<commands::Message> amqMessage;
-
-            // Always assign the message ID, regardless of the disable flag.
-            // Not adding a message ID will cause an NPE at the broker.
-            decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId());
-            id->setProducerId(producerId);
-            id->setProducerSequenceId(sequenceId);
-
-            // NOTE:
-            // Now we copy the message before sending, this allows the user to reuse the
-            // message object without interfering with the copy that's being sent.  We
-            // could make this step optional to increase performance but for now we won't.
-            // To not do this implies that the user must never reuse the message object, or
-            // know that the configuration of Transports doesn't involve the message hanging
-            // around beyond the point that send returns.  When the transform step results in
-            // a new Message object being created we can just use that new instance, but when
-            // the original cms::Message pointer was already a commands::Message then we need
-            // to clone it.
-            if (ActiveMQMessageTransformation::transformMessage(message, connection, &transformed)) {
-                amqMessage.reset(transformed);
-                // Sets the Message ID on the original message per spec.
-                message->setCMSMessageID(id->toString());
-            } else {
-                amqMessage.reset(transformed->cloneDataStructure());
-            }
-
-            amqMessage->setMessageId(id);
-            amqMessage->getBrokerPath().clear();
-            amqMessage->setTransactionId(txId);
-            amqMessage->setConnection(this->connection);
+            Pointer<commands::Message> amqMessage =
+                createOutboundMessage(producer, destination, message, deliveryMode, priority, timeToLive,
+                                      onComplete == NULL ? &handOver : NULL);
 
-            // destination format is provider specific so only set on transformed message
-            amqMessage->setDestination(destination);
+            if (onComplete != NULL) {
 
-            amqMessage->onSend();
-            amqMessage->setProducerId(producerId);
+                // The broker still confirms the message, the callback is told when it does
+                // so the producer can keep sending in the meantime.
+                Pointer<transport::ResponseCallback> callback(new AsyncSendCallback(onComplete));
+                this->connection->asyncRequest(amqMessage, callback,
+                    sendTimeout > 0 ? (unsigned int)sendTimeout : 0);
 
-            if (sendTimeout <= 0 && !amqMessage->isResponseRequired() && !this->connection->isAlwaysSyncSend() &&
-                (!amqMessage->isPersistent() || this->connection->isUseAsyncSend() || amqMessage->getTransactionId() != NULL)) {
+            } else if (!isSyncSendRequired(amqMessage, sendTimeout)) {
 
                 if (producerWindow != NULL) {
                     producerWindow->enqueueUsage(amqMessage->getSize());
@@ -940,6 +1062,186 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+                                 const std::vector<cms::Message*>& messages, int deliveryMode, int priority,
+                                 long long timeToLive, util::MemoryUsage* producerWindow, long long sendTimeout) {
+
+    try {
+
+        this->checkClosed();
+
+        if (destination->isTemporary()) {
+            Pointer<ActiveMQTempDestination> tempDest = destination.dynamicCast<ActiveMQTempDestination>();
+            if (this->connection->isDeleted(tempDest)) {
+                throw cms::InvalidDestinationException(
+                    std::string("Cannot publish to a deleted Destination: ") + destination->toString());
+            }
+        }
+
+        MessageHandOver handOver;
+        std::vector< Pointer<commands::Message> > outbound;
+        outbound.reserve(messages.size());
+        Pointer<BatchSendCallback> callback;
+
+        synchronized(&this->config->sendMutex) {
+
+            // Ensure that a new transaction is started if this is the first message
+            // sent since the last commit, Broker is notified of a new TX.
+            doStartTransaction();
+
+            // Every message is stamped and copied before any of them is sent so that one
+            // that can't be converted fails the batch before anything reaches the broker,
+            // it also tells us up front how many sends the shared callback waits on.
+            int syncCount = 0;
+
+            std::vector<cms::Message*>::const_iterator iter = messages.begin();
+            for (; iter != messages.end(); ++iter) {
+                outbound.push_back(createOutboundMessage(
+                    producer, destination, *iter, deliveryMode, priority, timeToLive, &handOver));
+                if (isSyncSendRequired(outbound.back(), sendTimeout)) {
+                    syncCount++;
+                }
+            }
+
+            // The messages that need the broker's confirmation are sent as asynchronous
+            // requests, the callback is shared so they are all waited for together.
+            if (syncCount > 0) {
+                callback.reset(new BatchSendCallback(syncCount));
+            }
+        }
+
+        // Nothing is sent if the confirmations could never be read.
+        if (callback != NULL) {
+            this->connection->checkNotDispatchingDirectly();
+        }
+
+        // The messages are sent in runs that fit in the producer window, when it fills
+        // the send lock is released while waiting for space, as a single send does, so
+        // the batch can't overrun the window nor block the session while it is full.
+        std::size_t next = 0;
+        while (next < outbound.size()) {
+
+            if (producerWindow != NULL) {
+                this->connection->checkNotDispatchingDirectly();
+                try {
+                    producerWindow->waitForSpace();
+                } catch (InterruptedException& e) {
+                    throw cms::CMSException("Send aborted due to thread interrupt.");
+                }
+            }
+
+            synchronized(&this->config->sendMutex) {
+
+                for (; next < outbound.size(); ++next) {
+
+                    const Pointer<commands::Message>& amqMessage = outbound[next];
+
+                    if (isSyncSendRequired(amqMessage, sendTimeout)) {
+                        this->connection->asyncRequest(amqMessage, callback,
+                            sendTimeout > 0 ? (unsigned int)sendTimeout : 0);
+                    } else {
+
+                        if (producerWindow != NULL) {
+                            if (producerWindow->isFull()) {
+                                break;
+                            }
+
+                            producerWindow->increaseUsage(amqMessage->getSize());
+                        }
+
+                        // No Response Required, send is asynchronous.
+                        this->connection->oneway(amqMessage);
+                    }
+                }
+            }
+        }
+
+        // The send timeout, if any, is applied to each request by the transport so
+        // this wait always ends once every request has been answered or failed.
+        if (callback != NULL) {
+            callback->await();
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<commands::Message> ActiveMQSessionKernel::createOutboundMessage(kernels::ActiveMQProducerKernel* producer,
+                                                                       Pointer<commands::ActiveMQDestination> destination,
+                                                                       cms::Message* message, int deliveryMode,
+                                                                       int priority, long long timeToLive,
+                                                                       MessageHandOver* handOver) {
+
+    Pointer<TransactionId> txId = this->transaction->getTransactionId();
+    Pointer<ProducerInfo> producerInfo = producer->getProducerInfo();
+    Pointer<ProducerId> producerId = producerInfo->getProducerId();
+    long long sequenceId = producer->getNextMessageSequence();
+
+    // Set the "CMS" header fields on the original message, see JMS 1.1 spec section 3.4.11
+    message->setCMSDeliveryMode(deliveryMode);
+    long long expiration = 0LL;
+    if (!producer->getDisableMessageTimeStamp()) {
+        long long timeStamp = System::currentTimeMillis();
+        message->setCMSTimestamp(timeStamp);
+        if (timeToLive > 0) {
+            expiration = timeToLive + timeStamp;
+        }
+    }
+    message->setCMSExpiration(expiration);
+    message->setCMSPriority(priority);
+    message->setCMSRedelivered(false);
+
+    // transform to our own message format here
+    commands::Message* transformed = NULL;
+    Pointer<commands::Message> amqMessage;
+
+    // Always assign the message ID, regardless of the disable flag.
+    // Not adding a message ID will cause an NPE at the broker.
+    decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId());
+    id->setProducerId(producerId);
+    id->setProducerSequenceId(sequenceId);
+
+    // NOTE:
+    // Now we copy the message before sending, this allows the user to reuse the
+    // message object without interfering with the copy that's being sent.  When the
+    // transform step results in a new Message object being created we can just use
+    // that new instance, but when the original cms::Message pointer was already a
+    // commands::Message then we need to clone it.  If the connection isn't set to
+    // copy on send the application has handed the message over to us and it is sent
+    // as it is, unless it is already part of this send, the hand over keeps it from
+    // being destroyed by the transport.
+    if (ActiveMQMessageTransformation::transformMessage(message, connection, &transformed)) {
+        amqMessage.reset(transformed);
+        // Sets the Message ID on the original message per spec.
+        message->setCMSMessageID(id->toString());
+    } else if (this->connection->isCopyMessageOnSend() || handOver == NULL || handOver->contains(transformed)) {
+        amqMessage.reset(transformed->cloneDataStructure());
+    } else {
+        amqMessage = handOver->add(transformed);
+    }
+
+    amqMessage->setMessageId(id);
+    amqMessage->getBrokerPath().clear();
+    amqMessage->setTransactionId(txId);
+    amqMessage->setConnection(this->connection);
+
+    // destination format is provider specific so only set on transformed message
+    amqMessage->setDestination(destination);
+
+    amqMessage->onSend();
+    amqMessage->setProducerId(producerId);
+
+    return amqMessage;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQSessionKernel::isSyncSendRequired(const Pointer<commands::Message>& message, long long sendTimeout) const {
+
+    return sendTimeout > 0 || message->isResponseRequired() || this->connection->isAlwaysSyncSend() ||
+           (message->isPersistent() && !this->connection->isUseAsyncSend() && message->getTransactionId() == NULL);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::ExceptionListener* ActiveMQSessionKernel::getExceptionListener() {
 
@@ -965,6 +1267,16 @@ Pointer<Scheduler> ActiveMQSessionKernel::getScheduler() const {
     return this->config->scheduler;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQSessionKernel::isSessionAsyncDispatch() const {
+    return this->config->sessionAsyncDispatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::setSessionAsyncDispatch(bool value) {
+    this->config->sessionAsyncDispatch = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionKernel::unsubscribe(const std::string& name) {
 
@@ -28,6 +28,7 @@
 #include <activemq/core/kernels/ActiveMQConsumerKernel.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/commands/ActiveMQTempDestination.h>
+#include <activemq/commands/Message.h>
 #include <activemq/commands/Response.h>
 #include <activemq/commands/SessionInfo.h>
 #include <activemq/commands/ConsumerInfo.h>
@@ -62,6 +63,7 @@ namespace kernels {
     using decaf::util::concurrent::atomic::AtomicBoolean;
 
     class SessionConfig;
+    class MessageHandOver;
 
     class AMQCPP_API ActiveMQSessionKernel : public virtual cms::Session, public Dispatcher {
     private:
@@ -281,11 +283,45 @@ namespace kernels {
          *      of the given message.
          * @param sendTimeout
          *      The amount of time to block during send before failing, or 0 to wait forever.
+         * @param onComplete
+         *      If not NULL the send does not wait for the broker to confirm the message,
+         *      this callback is notified once it does or the send fails.
          *
          * @throws CMSException if an error occurs while sending the message.
          */
         void send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
                   cms::Message* message, int deliveryMode, int priority, long long timeToLive,
+                  util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete);
+
+        /**
+         * Sends a batch of messages from the Producer specified using this session's
+         * connection.  The messages are stamped and copied under a single acquisition of
+         * the session's send lock, those that need the broker's confirmation are sent
+         * without waiting in between and their responses are then waited for together.
+         *
+         * @param producer
+         *      The sending Producer
+         * @param destination
+         *      The target destination for the Messages.
+         * @param messages
+         *      The messages to send to the broker, in the order they are to be sent.
+         * @param deliveryMode
+         *      The delivery mode to assign to the outgoing messages.
+         * @param priority
+         *      The priority value to assign to the outgoing messages.
+         * @param timeToLive
+         *      The time to live for the outgoing messages.
+         * @param producerWindow
+         *      Pointer to a Usage tracker which if set is waited on for space before each
+         *      message that is sent asynchronously and then increased by its size.
+         * @param sendTimeout
+         *      The amount of time to wait for each message to be confirmed before failing,
+         *      or 0 to wait forever.
+         *
+         * @throws CMSException if an error occurs while sending any of the messages.
+         */
+        void send(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+                  const std::vector<cms::Message*>& messages, int deliveryMode, int priority, long long timeToLive,
                   util::MemoryUsage* producerWindow, long long sendTimeout);
 
         /**
@@ -346,6 +382,22 @@ namespace kernels {
          */
         Pointer<threads::Scheduler> getScheduler() const;
 
+        /**
+         * @returns true if this Session always delivers messages from its own dispatch
+         *          thread, false if it may deliver them on the thread that received them.
+         */
+        bool isSessionAsyncDispatch() const;
+
+        /**
+         * Sets whether this Session always delivers messages from its own dispatch thread,
+         * the initial value comes from the Connection's alwaysSessionAsync setting and the
+         * Session's acknowledgement mode.
+         *
+         * @param value
+         *      False to allow messages to be delivered on the thread that received them.
+         */
+        void setSessionAsyncDispatch(bool value);
+
         /**
          * Gets the currently set Last Delivered Sequence Id
          *
@@ -468,6 +520,16 @@ namespace kernels {
          */
         void deliverAcks();
 
+        /**
+         * Sets whether the consumers of this Session batch their acknowledgements, when
+         * disabled any acknowledgements a consumer has batched are sent right away.  A
+         * consumer that was created without batching is not changed.
+         *
+         * @param value
+         *      true if the consumers should batch their acknowledgements.
+         */
+        void setOptimizeAcknowledge(bool value);
+
         /**
          * Request that this Session inform all of its consumers to clear all messages that
          * are currently in progress.
@@ -546,6 +608,19 @@ namespace kernels {
        // Checks for the closed state and throws if so.
        void checkClosed() const;
 
+       // Stamps the CMS headers on the given message and creates the copy of it that is
+       // sent to the broker, must be called with the send lock held.  When the connection
+       // doesn't copy messages on send and a hand over is given the message itself is sent
+       // and registered with the hand over instead.
+       Pointer<commands::Message> createOutboundMessage(kernels::ActiveMQProducerKernel* producer,
+                                                        Pointer<commands::ActiveMQDestination> destination,
+                                                        cms::Message* message, int deliveryMode,
+                                                        int priority, long long timeToLive,
+                                                        MessageHandOver* handOver);
+
+       // Returns true if sending the given message must wait for the broker's response.
+       bool isSyncSendRequired(const Pointer<commands::Message>& message, long long sendTimeout) const;
+
        // Send the Destination Creation Request to the Broker, alerting it
        // that we've created a new Temporary Destination.
        // @param tempDestination - The new Temporary Destination
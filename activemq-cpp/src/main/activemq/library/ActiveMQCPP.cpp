@@ -22,6 +22,8 @@
 #include <activemq/transport/TransportRegistry.h>
 
 #include <activemq/util/IdGenerator.h>
+#include <activemq/threads/TimerWheel.h>
+#include <activemq/transport/inactivity/InactivityMonitor.h>
 
 #include <activemq/wireformat/stomp/StompWireFormatFactory.h>
 #include <activemq/wireformat/openwire/OpenWireFormatFactory.h>
@@ -29,15 +31,18 @@
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/transport/tcp/TcpTransportFactory.h>
 #include <activemq/transport/tcp/SslTransportFactory.h>
+#include <activemq/transport/tcp/TcpReactor.h>
 #include <activemq/transport/failover/FailoverTransportFactory.h>
 
 using namespace activemq;
 using namespace activemq::library;
 using namespace activemq::util;
+using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace activemq::transport::tcp;
 using namespace activemq::transport::mock;
 using namespace activemq::transport::failover;
+using namespace activemq::transport::inactivity;
 using namespace activemq::wireformat;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,6 +59,15 @@ void ActiveMQCPP::initializeLibrary( int argc, char** argv ) {
 
     // Start the IdGenerator Kernel
     IdGenerator::initialize();
+
+    // Create the Timer shared by all the Transports
+    TimerWheel::initialize();
+
+    // Create the pool that runs the work signaled by the Transports' inactivity checks
+    InactivityMonitor::initialize();
+
+    // Create the Reactor that TCP Transports can share for their reads
+    TcpReactor::initialize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,6 +78,15 @@ void ActiveMQCPP::initializeLibrary() {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQCPP::shutdownLibrary() {
 
+    // Stop the Reactor threads, every Transport registered with it should be closed by now
+    TcpReactor::shutdown();
+
+    // Stop the Timer shared by all the Transports, they should all be closed by now
+    TimerWheel::shutdown();
+
+    // Stop the inactivity checks' pool once nothing can signal it anymore
+    InactivityMonitor::shutdown();
+
     // Shutdown the IdGenerator Kernel
     IdGenerator::shutdown();
 
@@ -71,16 +71,14 @@ namespace state {
 ////////////////////////////////////////////////////////////////////////////////
 ConnectionStateTracker::ConnectionStateTracker() : TRACKED_RESPONSE_MARKER( new Tracked() ),
                                                    connectionStates(),
-                                                   messageCache(),
+                                                   messageCache(128 * 1024),
                                                    trackTransactions(false),
                                                    restoreSessions(true),
                                                    restoreConsumers(true),
                                                    restoreProducers(true),
                                                    restoreTransaction(true),
                                                    trackMessages(true),
-                                                   trackTransactionProducers(true),
-                                                   maxCacheSize(128 * 1024),
-                                                   currentCacheSize(0) {
+                                                   trackTransactionProducers(true) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,30 +102,6 @@ Pointer<Tracked> ConnectionStateTracker::track( const Pointer<Command>& command
     AMQ_CATCHALL_THROW( IOException )
 }
 
-////////////////////////////////////////////////////////////////////////////////
-void ConnectionStateTracker::trackBack( const Pointer<Command>& command ) {
-
-    try{
-        if (command != NULL) {
-            if (trackMessages && command->isMessage()) {
-                Pointer<Message> message = command.dynamicCast<Message>();
-                if (message->getTransactionId() == NULL) {
-                    currentCacheSize = currentCacheSize + message->getSize();
-                }
-            } else {
-                Pointer<MessagePull> messagePull = command.dynamicCast<MessagePull>();
-                if (messagePull != NULL) {
-                    // just needs to be a rough estimate of size, ~4 identifiers
-                    currentCacheSize += 400;
-                }
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW( ActiveMQException )
-    AMQ_CATCH_EXCEPTION_CONVERT( Exception, ActiveMQException )
-    AMQ_CATCHALL_THROW( ActiveMQException )
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 void ConnectionStateTracker::restore( const Pointer<transport::Transport>& transport ) {
 
@@ -588,8 +562,13 @@ Pointer<Command> ConnectionStateTracker::processMessage( Message* message ) {
                 }
                 return TRACKED_RESPONSE_MARKER;
             }else if( trackMessages ) {
+                // Tracking happens before the message is marshaled, marshal its properties
+                // now so they are part of the size it is cached with, the transport then
+                // finds them already done.
+                message->beforeMarshal( NULL );
                 messageCache.put( message->getMessageId(),
-                                  Pointer<Message>( message->cloneDataStructure() ) );
+                                  Pointer<Message>( message->cloneDataStructure() ),
+                                  (int)message->getSize() );
             }
         }
         return Pointer<Response>();
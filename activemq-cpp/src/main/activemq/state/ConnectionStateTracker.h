@@ -24,6 +24,7 @@
 #include <activemq/state/CommandVisitorAdapter.h>
 #include <activemq/state/ConnectionState.h>
 #include <activemq/state/ConsumerState.h>
+#include <activemq/state/MessageCache.h>
 #include <activemq/state/ProducerState.h>
 #include <activemq/state/SessionState.h>
 #include <activemq/state/TransactionState.h>
@@ -50,12 +51,8 @@ namespace state {
         ConcurrentStlMap< Pointer<ConnectionId>, Pointer<ConnectionState>,
                           ConnectionId::COMPARATOR > connectionStates;
 
-        // TODO - The Map doesn't have a way to automatically remove the eldest Entry
-        //        Either we need to implement something similar to LinkedHashMap or find
-        //        some other way of tracking the eldest entry into the map and removing it
-        //        if the cache size is exceeded.
-        ConcurrentStlMap< Pointer<MessageId>, Pointer<Command>,
-                          MessageId::COMPARATOR > messageCache;
+        /** Messages sent outside a transaction, the eldest are evicted beyond maxCacheSize bytes */
+        MessageCache messageCache;
 
         ConcurrentStlMap< std::string, Pointer<Command> > messagePullCache;
 
@@ -66,8 +63,6 @@ namespace state {
         bool restoreTransaction;
         bool trackMessages;
         bool trackTransactionProducers;
-        int maxCacheSize;
-        int currentCacheSize;
 
         friend class RemoveTransactionAction;
 
@@ -79,8 +74,6 @@ namespace state {
 
         Pointer<Tracked> track( const Pointer<Command>& command );
 
-        void trackBack( const Pointer<Command>& command );
-
         void restore( const Pointer<transport::Transport>& transport );
 
         void connectionInterruptProcessingComplete(
@@ -175,11 +168,18 @@ namespace state {
         }
 
         int getMaxCacheSize() const {
-            return this->maxCacheSize;
+            return (int)this->messageCache.getMaxSize();
         }
 
         void setMaxCacheSize( int maxCacheSize ) {
-            this->maxCacheSize = maxCacheSize;
+            this->messageCache.setMaxSize( maxCacheSize );
+        }
+
+        /**
+         * @returns the number of bytes of messages currently held for resending on failover.
+         */
+        long long getCurrentCacheSize() const {
+            return this->messageCache.getCurrentSize();
         }
 
         bool isTrackTransactionProducers() const {
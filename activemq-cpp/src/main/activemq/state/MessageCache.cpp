@@ -0,0 +1,252 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageCache.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/util/concurrent/Concurrent.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::state;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace state {
+
+    // A cached message, linked into the cache's insertion ordered list.
+    class MessageCacheEntry {
+    private:
+
+        MessageCacheEntry( const MessageCacheEntry& );
+        MessageCacheEntry& operator= ( const MessageCacheEntry& );
+
+    public:
+
+        Pointer<MessageId> id;
+        Pointer<Command> message;
+        int size;
+
+        MessageCacheEntry* prev;
+        MessageCacheEntry* next;
+
+        MessageCacheEntry( const Pointer<MessageId>& id, const Pointer<Command>& message, int size ) :
+            id( id ), message( message ), size( size ), prev( NULL ), next( NULL ) {
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageCache::MessageCache( long long maxSize ) : index(), head( NULL ), tail( NULL ),
+                                                  currentSize( 0 ), maxSize( maxSize ), mutex() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageCache::~MessageCache() {
+    try{
+        this->clear();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCache::put( const Pointer<MessageId>& id, const Pointer<Command>& message, int size ) {
+
+    // Allocated before taking the lock, the sending thread only holds it to link the entry.
+    MessageCacheEntry* entry = new MessageCacheEntry( id, message, size < 0 ? 0 : size );
+    std::vector<MessageCacheEntry*> released;
+
+    synchronized( &mutex ) {
+
+        std::pair<IndexMap::iterator, bool> result = this->index.insert( std::make_pair( id, entry ) );
+
+        if( !result.second ) {
+            this->unlink( result.first->second, released );
+            this->index.insert( std::make_pair( id, entry ) );
+        }
+
+        entry->prev = this->tail;
+        if( this->tail != NULL ) {
+            this->tail->next = entry;
+        } else {
+            this->head = entry;
+        }
+        this->tail = entry;
+
+        this->currentSize += entry->size;
+
+        this->evict( released );
+    }
+
+    destroy( released );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MessageCache::remove( const Pointer<MessageId>& id ) {
+
+    std::vector<MessageCacheEntry*> released;
+
+    synchronized( &mutex ) {
+
+        IndexMap::iterator iter = this->index.find( id );
+        if( iter != this->index.end() ) {
+            this->unlink( iter->second, released );
+        }
+    }
+
+    bool result = !released.empty();
+    destroy( released );
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector< Pointer<Command> > MessageCache::values() const {
+
+    std::vector< Pointer<Command> > result;
+
+    synchronized( &mutex ) {
+
+        result.reserve( this->index.size() );
+
+        for( MessageCacheEntry* entry = this->head; entry != NULL; entry = entry->next ) {
+            result.push_back( entry->message );
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCache::clear() {
+
+    std::vector<MessageCacheEntry*> released;
+
+    synchronized( &mutex ) {
+
+        for( MessageCacheEntry* entry = this->head; entry != NULL; entry = entry->next ) {
+            released.push_back( entry );
+        }
+
+        this->index.clear();
+        this->head = NULL;
+        this->tail = NULL;
+        this->currentSize = 0;
+    }
+
+    destroy( released );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageCache::size() const {
+
+    int result = 0;
+
+    synchronized( &mutex ) {
+        result = (int)this->index.size();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MessageCache::getCurrentSize() const {
+
+    long long result = 0;
+
+    synchronized( &mutex ) {
+        result = this->currentSize;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MessageCache::getMaxSize() const {
+
+    long long result = 0;
+
+    synchronized( &mutex ) {
+        result = this->maxSize;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCache::setMaxSize( long long maxSize ) {
+
+    std::vector<MessageCacheEntry*> released;
+
+    synchronized( &mutex ) {
+        this->maxSize = maxSize;
+        this->evict( released );
+    }
+
+    destroy( released );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCache::unlink( MessageCacheEntry* entry, std::vector<MessageCacheEntry*>& released ) {
+
+    if( entry->prev != NULL ) {
+        entry->prev->next = entry->next;
+    } else {
+        this->head = entry->next;
+    }
+
+    if( entry->next != NULL ) {
+        entry->next->prev = entry->prev;
+    } else {
+        this->tail = entry->prev;
+    }
+
+    entry->prev = NULL;
+    entry->next = NULL;
+
+    this->index.erase( entry->id );
+    this->currentSize -= entry->size;
+
+    released.push_back( entry );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCache::evict( std::vector<MessageCacheEntry*>& released ) {
+
+    // The newest entry stays even when it alone exceeds the maximum, otherwise the
+    // message that was just sent could never be replayed.
+    while( this->currentSize > this->maxSize && this->head != this->tail ) {
+        this->unlink( this->head, released );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCache::destroy( std::vector<MessageCacheEntry*>& released ) {
+
+    std::vector<MessageCacheEntry*>::iterator iter = released.begin();
+    for( ; iter != released.end(); ++iter ) {
+        delete *iter;
+    }
+
+    released.clear();
+}
@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_STATE_MESSAGECACHE_H_
+#define _ACTIVEMQ_STATE_MESSAGECACHE_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/commands/Command.h>
+#include <activemq/commands/MessageId.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <map>
+#include <vector>
+
+namespace activemq {
+namespace state {
+
+    using decaf::lang::Pointer;
+    using activemq::commands::Command;
+    using activemq::commands::MessageId;
+
+    class MessageCacheEntry;
+
+    /**
+     * Holds the messages sent outside of a transaction so that they can be resent after
+     * a failover, up to a maximum number of bytes.
+     *
+     * Messages are kept in the order they were added, once the total size of the cached
+     * messages exceeds the maximum the eldest ones are removed until it fits again, the
+     * most recently added message is always kept even if it is larger than the maximum.  The
+     * entries are linked in insertion order so evicting the eldest is a constant time
+     * operation, and messages that are evicted or replaced are released after the cache
+     * lock has been dropped so that the sending thread holds it as briefly as possible.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API MessageCache {
+    private:
+
+        typedef std::map< Pointer<MessageId>, MessageCacheEntry*, MessageId::COMPARATOR > IndexMap;
+
+        IndexMap index;
+
+        MessageCacheEntry* head;
+        MessageCacheEntry* tail;
+
+        long long currentSize;
+        long long maxSize;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+    private:
+
+        MessageCache( const MessageCache& );
+        MessageCache& operator= ( const MessageCache& );
+
+    public:
+
+        /**
+         * Creates a new MessageCache.
+         *
+         * @param maxSize
+         *      The maximum number of bytes of messages to hold.
+         */
+        MessageCache( long long maxSize );
+
+        virtual ~MessageCache();
+
+        /**
+         * Adds a message to the cache, replacing any message already cached with the same
+         * id, and then evicts the eldest messages until the cache is within its maximum
+         * size again or only the added message remains.
+         *
+         * @param id
+         *      The id of the message.
+         * @param message
+         *      The message to cache.
+         * @param size
+         *      The size in bytes that the message is accounted for.
+         */
+        void put( const Pointer<MessageId>& id, const Pointer<Command>& message, int size );
+
+        /**
+         * Removes the message with the given id from the cache.
+         *
+         * @param id
+         *      The id of the message to remove.
+         *
+         * @returns true if the message was in the cache.
+         */
+        bool remove( const Pointer<MessageId>& id );
+
+        /**
+         * @returns the cached messages, eldest first.
+         */
+        std::vector< Pointer<Command> > values() const;
+
+        /**
+         * Removes all the messages from the cache.
+         */
+        void clear();
+
+        /**
+         * @returns the number of messages in the cache.
+         */
+        int size() const;
+
+        /**
+         * @returns the total size in bytes of the messages in the cache.
+         */
+        long long getCurrentSize() const;
+
+        /**
+         * @returns the maximum number of bytes of messages the cache holds.
+         */
+        long long getMaxSize() const;
+
+        /**
+         * Sets the maximum number of bytes of messages the cache holds, if the cache is
+         * already larger the eldest messages are evicted, leaving at least the newest.
+         *
+         * @param maxSize
+         *      The new maximum size in bytes.
+         */
+        void setMaxSize( long long maxSize );
+
+    private:
+
+        // The following are called with the mutex held, unlinked entries are appended to
+        // the released list and are only destroyed once the mutex has been released.
+
+        void unlink( MessageCacheEntry* entry, std::vector<MessageCacheEntry*>& released );
+
+        void evict( std::vector<MessageCacheEntry*>& released );
+
+        static void destroy( std::vector<MessageCacheEntry*>& released );
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_STATE_MESSAGECACHE_H_ */
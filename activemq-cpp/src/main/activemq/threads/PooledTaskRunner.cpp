@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledTaskRunner.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace threads {
+
+    // The runner's state is shared with the jobs it queues on the executor so that a job
+    // that is still waiting in the executor's queue after the runner is destroyed, or that
+    // destroys the runner from within the task, never touches freed memory.
+    class PooledTaskRunnerState {
+    private:
+
+        PooledTaskRunnerState( const PooledTaskRunnerState& );
+        PooledTaskRunnerState& operator= ( const PooledTaskRunnerState& );
+
+    public:
+
+        Mutex mutex;
+        Pointer<ExecutorService> executor;
+        Task* task;
+        int maxIterationsPerRun;
+
+        Thread* runningThread;
+        bool queued;
+        bool iterating;
+        bool shutDown;
+
+        PooledTaskRunnerState( const Pointer<ExecutorService>& executor, Task* task, int maxIterationsPerRun ) :
+            mutex(), executor( executor ), task( task ), maxIterationsPerRun( maxIterationsPerRun ),
+            runningThread( NULL ), queued( false ), iterating( false ), shutDown( false ) {
+        }
+    };
+
+    class PooledTaskRunnerJob : public Runnable {
+    private:
+
+        Pointer<PooledTaskRunnerState> state;
+
+    private:
+
+        PooledTaskRunnerJob( const PooledTaskRunnerJob& );
+        PooledTaskRunnerJob& operator= ( const PooledTaskRunnerJob& );
+
+    public:
+
+        PooledTaskRunnerJob( const Pointer<PooledTaskRunnerState>& state ) : state( state ) {
+        }
+
+        virtual ~PooledTaskRunnerJob() {}
+
+        virtual void run() {
+
+            synchronized( &state->mutex ) {
+                state->queued = false;
+                if( state->shutDown ) {
+                    state->mutex.notifyAll();
+                    return;
+                }
+                state->iterating = true;
+                state->runningThread = Thread::currentThread();
+            }
+
+            // The lock isn't held while iterating so that wakeup calls don't block.
+            bool done = false;
+            try {
+                for( int i = 0; i < state->maxIterationsPerRun; ++i ) {
+                    if( !state->task->iterate() ) {
+                        done = true;
+                        break;
+                    }
+                }
+            }
+            AMQ_CATCH_NOTHROW( Exception )
+            AMQ_CATCHALL_NOTHROW()
+
+            synchronized( &state->mutex ) {
+                state->iterating = false;
+                state->runningThread = NULL;
+                state->mutex.notifyAll();
+
+                if( state->shutDown ) {
+                    state->queued = false;
+                    return;
+                }
+
+                // If the task still has work go to the back of the executor's queue so
+                // the other runners get a turn first.
+                if( !done ) {
+                    state->queued = true;
+                }
+
+                if( state->queued ) {
+                    try{
+                        state->executor->execute( new PooledTaskRunnerJob( state ) );
+                    } catch( Exception& ) {
+                        state->queued = false;
+                    }
+                }
+            }
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::PooledTaskRunner( const Pointer<ExecutorService>& executor, Task* task, int maxIterationsPerRun ) :
+    state() {
+
+    if( executor == NULL ) {
+        throw NullPointerException(
+            __FILE__, __LINE__, "Executor passed was null" );
+    }
+
+    if( task == NULL ) {
+        throw NullPointerException(
+            __FILE__, __LINE__, "Task passed was null" );
+    }
+
+    if( maxIterationsPerRun < 1 ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Max iterations per run must be at least one." );
+    }
+
+    this->state.reset( new PooledTaskRunnerState( executor, task, maxIterationsPerRun ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::~PooledTaskRunner() {
+    try{
+        this->shutdown();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown( unsigned int timeout ) {
+
+    synchronized( &state->mutex ) {
+        state->shutDown = true;
+
+        // Wait for the current iteration to finish, unless we are being shutdown
+        // from within it, in which case it would never finish.
+        if( state->iterating && state->runningThread != Thread::currentThread() ) {
+            state->mutex.wait( timeout );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown() {
+
+    synchronized( &state->mutex ) {
+        state->shutDown = true;
+
+        while( state->iterating && state->runningThread != Thread::currentThread() ) {
+            state->mutex.wait();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::wakeup() {
+
+    synchronized( &state->mutex ) {
+
+        if( state->queued || state->shutDown ) {
+            return;
+        }
+
+        state->queued = true;
+
+        // If the task is iterating the job will queue itself again once its done.
+        if( !state->iterating ) {
+            try{
+                state->executor->execute( new PooledTaskRunnerJob( state ) );
+            } catch( Exception& ) {
+                state->queued = false;
+                throw;
+            }
+        }
+    }
+}
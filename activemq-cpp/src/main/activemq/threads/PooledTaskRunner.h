@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+#define _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/threads/TaskRunner.h>
+#include <activemq/threads/Task.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/ExecutorService.h>
+
+namespace activemq {
+namespace threads {
+
+    using decaf::lang::Pointer;
+
+    class PooledTaskRunnerState;
+
+    /**
+     * A TaskRunner that iterates its Task on a thread borrowed from an ExecutorService
+     * rather than on a thread of its own, so any number of runners can share a fixed
+     * size pool of threads.
+     *
+     * A runner is never queued on the executor more than once, so its Task is only ever
+     * iterated by one thread at a time and the work it does is processed in order.  To
+     * keep a busy Task from starving the other runners that share the pool the runner
+     * gives up its thread after a configurable number of iterations and re-queues itself
+     * behind any runners that are waiting.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API PooledTaskRunner : public TaskRunner {
+    private:
+
+        Pointer<PooledTaskRunnerState> state;
+
+    private:
+
+        PooledTaskRunner( const PooledTaskRunner& );
+        PooledTaskRunner& operator= ( const PooledTaskRunner& );
+
+    public:
+
+        /**
+         * Creates a new PooledTaskRunner.
+         *
+         * @param executor
+         *      The ExecutorService whose threads are used to iterate the Task.
+         * @param task
+         *      The Task to iterate, the caller retains ownership.
+         * @param maxIterationsPerRun
+         *      The number of times the Task is iterated before its thread is returned
+         *      to the pool.
+         *
+         * @throws NullPointerException if the executor or task is NULL.
+         * @throws IllegalArgumentException if maxIterationsPerRun is less than one.
+         */
+        PooledTaskRunner( const Pointer<decaf::util::concurrent::ExecutorService>& executor,
+                          Task* task, int maxIterationsPerRun );
+
+        virtual ~PooledTaskRunner();
+
+        /**
+         * Shutdown after a timeout, does not guarantee that the task's iterate
+         * method has completed.
+         *
+         * @param timeout - Time in Milliseconds to wait for the task to stop.
+         */
+        virtual void shutdown( unsigned int timeout );
+
+        /**
+         * Shutdown once the task's current iteration, if any, has completed.
+         */
+        virtual void shutdown();
+
+        /**
+         * Signal the TaskRunner to wakeup and execute another iteration cycle on
+         * the task, the Task instance will be run until its iterate method has
+         * returned false indicating it is done.
+         */
+        virtual void wakeup();
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_*/
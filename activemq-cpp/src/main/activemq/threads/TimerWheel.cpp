@@ -0,0 +1,542 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimerWheel.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::threads;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+TimerWheel* TimerWheel::theOnlyInstance = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace threads {
+
+    // A task registered with the wheel, while waiting for its tick it is linked into
+    // one of the wheel's buckets and once expired it is moved onto the expired queue.
+    class TimerWheelTimeout {
+    private:
+
+        TimerWheelTimeout( const TimerWheelTimeout& );
+        TimerWheelTimeout& operator= ( const TimerWheelTimeout& );
+
+    public:
+
+        Runnable* task;
+        bool ownsTask;
+        long long deadline;
+        long long period;
+        long long rounds;
+        int bucket;
+        bool cancelled;
+
+        TimerWheelTimeout* prev;
+        TimerWheelTimeout* next;
+
+        TimerWheelTimeout( Runnable* task, long long period, bool ownsTask ) :
+            task( task ), ownsTask( ownsTask ), deadline( 0 ), period( period ), rounds( 0 ),
+            bucket( -1 ), cancelled( false ), prev( NULL ), next( NULL ) {
+        }
+    };
+
+    // Runs expired tasks until the wheel is shutdown.
+    class TimerWheelWorker : public Runnable {
+    private:
+
+        TimerWheelWorker( const TimerWheelWorker& );
+        TimerWheelWorker& operator= ( const TimerWheelWorker& );
+
+    public:
+
+        TimerWheel* parent;
+        TimerWheelTimeout* current;
+        Thread* thread;
+
+        TimerWheelWorker( TimerWheel* parent ) : parent( parent ), current( NULL ), thread( NULL ) {
+        }
+
+        virtual ~TimerWheelWorker() {}
+
+        virtual void run() {
+
+            TimerWheelTimeout* timeout = NULL;
+
+            while( ( timeout = parent->takeExpired( this ) ) != NULL ) {
+
+                try{
+                    timeout->task->run();
+                }
+                AMQ_CATCH_NOTHROW( Exception )
+                AMQ_CATCHALL_NOTHROW()
+
+                parent->completed( timeout );
+            }
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerWheel::TimerWheel( const std::string& name, long long tickDuration, int ticksPerWheel, int workerCount ) :
+    name( name ), tickDuration( tickDuration ), workerCount( workerCount ), mutex(), wheel(), timeouts(),
+    expiredHead( NULL ), expiredTail( NULL ), tick( 0 ), startTime( 0 ), waitingCount( 0 ),
+    started( false ), shutDown( false ), tickThread( NULL ), workerThreads(), workers() {
+
+    if( name.empty() ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "TimerWheel name must not be empty." );
+    }
+
+    if( tickDuration < 1 ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Tick duration must be at least one millisecond." );
+    }
+
+    if( ticksPerWheel < 1 || ticksPerWheel > ( 1 << 30 ) ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Invalid number of ticks per wheel: %d", ticksPerWheel );
+    }
+
+    if( workerCount < 1 ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Worker count must be at least one." );
+    }
+
+    // Using a power of two number of buckets lets a tick be mapped to its bucket with a mask.
+    int size = 1;
+    while( size < ticksPerWheel ) {
+        size <<= 1;
+    }
+
+    this->wheel.resize( size, NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerWheel::~TimerWheel() {
+    try{
+
+        synchronized( &mutex ) {
+            this->shutDown = true;
+            mutex.notifyAll();
+        }
+
+        if( this->tickThread != NULL ) {
+            this->tickThread->join();
+            delete this->tickThread;
+        }
+
+        for( std::size_t i = 0; i < this->workerThreads.size(); ++i ) {
+            this->workerThreads[i]->join();
+            delete this->workerThreads[i];
+            delete this->workers[i];
+        }
+
+        // The threads are gone, anything left is either in a bucket or on the expired queue.
+        for( std::size_t i = 0; i < this->wheel.size(); ++i ) {
+            TimerWheelTimeout* timeout = this->wheel[i];
+            while( timeout != NULL ) {
+                TimerWheelTimeout* next = timeout->next;
+                destroy( timeout );
+                timeout = next;
+            }
+        }
+
+        while( this->expiredHead != NULL ) {
+            TimerWheelTimeout* next = this->expiredHead->next;
+            destroy( this->expiredHead );
+            this->expiredHead = next;
+        }
+
+        this->timeouts.clear();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::schedule( Runnable* task, long long delay, bool ownsTask ) {
+
+    if( delay < 0 ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Task delay cannot be negative." );
+    }
+
+    this->doSchedule( task, delay, 0, ownsTask );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::scheduleAtFixedRate( Runnable* task, long long delay, long long period, bool ownsTask ) {
+
+    if( delay < 0 ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Task delay cannot be negative." );
+    }
+
+    if( period <= 0 ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Task period must be greater than zero." );
+    }
+
+    this->doSchedule( task, delay, period, ownsTask );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::doSchedule( Runnable* task, long long delay, long long period, bool ownsTask ) {
+
+    if( task == NULL ) {
+        throw NullPointerException( __FILE__, __LINE__, "Task to schedule cannot be NULL." );
+    }
+
+    synchronized( &mutex ) {
+
+        if( this->shutDown ) {
+            throw IllegalStateException( __FILE__, __LINE__, "TimerWheel has been shut down." );
+        }
+
+        if( this->timeouts.containsKey( task ) ) {
+            throw IllegalStateException( __FILE__, __LINE__, "Task is already scheduled." );
+        }
+
+        if( !this->started ) {
+            this->startThreads();
+        }
+
+        TimerWheelTimeout* timeout = new TimerWheelTimeout( task, period, ownsTask );
+        this->timeouts.put( task, timeout );
+        this->insert( timeout, ( currentTime() - this->startTime ) + delay );
+
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TimerWheel::cancel( Runnable* task ) {
+
+    if( task == NULL ) {
+        return false;
+    }
+
+    bool result = false;
+    TimerWheelTimeout* discarded = NULL;
+
+    synchronized( &mutex ) {
+
+        if( this->timeouts.containsKey( task ) ) {
+
+            TimerWheelTimeout* timeout = this->timeouts.remove( task );
+            timeout->cancelled = true;
+            result = true;
+
+            // Still waiting on its tick so it can be dropped now, otherwise its expired and
+            // the worker that takes it from the queue or is running it will dispose of it.
+            if( timeout->bucket >= 0 ) {
+                this->unlink( timeout );
+                discarded = timeout;
+            }
+        }
+
+        // Wait for any in progress run of the task to finish, unless called from one of
+        // our own workers, a task that waits on another task could tie up every worker.
+        Thread* self = Thread::currentThread();
+        bool running = true;
+        for( std::size_t i = 0; i < this->workers.size(); ++i ) {
+            if( this->workers[i]->thread == self ) {
+                running = false;
+            }
+        }
+
+        while( running ) {
+            running = false;
+            for( std::size_t i = 0; i < this->workers.size(); ++i ) {
+                TimerWheelWorker* worker = this->workers[i];
+                if( worker->current != NULL && worker->current->task == task ) {
+                    running = true;
+                }
+            }
+
+            if( running ) {
+                result = true;
+                mutex.wait();
+            }
+        }
+    }
+
+    if( discarded != NULL ) {
+        destroy( discarded );
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TimerWheel::getPendingCount() const {
+
+    int result = 0;
+
+    synchronized( &mutex ) {
+        result = this->timeouts.size();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::run() {
+
+    try{
+
+        synchronized( &mutex ) {
+
+            while( !this->shutDown ) {
+
+                // Nothing is waiting on a tick, sleep until something is scheduled.
+                if( this->waitingCount == 0 ) {
+                    mutex.wait();
+                    continue;
+                }
+
+                long long elapsed = currentTime() - this->startTime;
+                long long target = this->tick * this->tickDuration;
+
+                if( elapsed < target ) {
+                    mutex.wait( target - elapsed );
+                    continue;
+                }
+
+                this->expireTick( this->tick++ );
+            }
+        }
+    }
+    AMQ_CATCH_NOTHROW( Exception )
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::insert( TimerWheelTimeout* timeout, long long deadline ) {
+
+    // An empty wheel may not have been ticking, move it up to the present so the
+    // new timeout doesn't wait on all the ticks that were skipped while idle.
+    if( this->waitingCount == 0 ) {
+        long long current = ( currentTime() - this->startTime ) / this->tickDuration;
+        if( current > this->tick ) {
+            this->tick = current;
+        }
+    }
+
+    long long target = ( deadline + this->tickDuration - 1 ) / this->tickDuration;
+    if( target < this->tick ) {
+        target = this->tick;
+    }
+
+    long long size = (long long)this->wheel.size();
+
+    timeout->deadline = deadline;
+    timeout->rounds = ( target - this->tick ) / size;
+    timeout->bucket = (int)( target & ( size - 1 ) );
+    timeout->prev = NULL;
+    timeout->next = this->wheel[timeout->bucket];
+
+    if( timeout->next != NULL ) {
+        timeout->next->prev = timeout;
+    }
+
+    this->wheel[timeout->bucket] = timeout;
+    this->waitingCount++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::unlink( TimerWheelTimeout* timeout ) {
+
+    if( timeout->prev != NULL ) {
+        timeout->prev->next = timeout->next;
+    } else {
+        this->wheel[timeout->bucket] = timeout->next;
+    }
+
+    if( timeout->next != NULL ) {
+        timeout->next->prev = timeout->prev;
+    }
+
+    timeout->bucket = -1;
+    timeout->prev = NULL;
+    timeout->next = NULL;
+    this->waitingCount--;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::expireTick( long long tickToExpire ) {
+
+    long long size = (long long)this->wheel.size();
+    TimerWheelTimeout* timeout = this->wheel[(int)( tickToExpire & ( size - 1 ) )];
+    bool expired = false;
+
+    while( timeout != NULL ) {
+
+        TimerWheelTimeout* next = timeout->next;
+
+        if( timeout->rounds > 0 ) {
+            timeout->rounds--;
+        } else {
+            this->unlink( timeout );
+
+            if( this->expiredTail != NULL ) {
+                this->expiredTail->next = timeout;
+            } else {
+                this->expiredHead = timeout;
+            }
+            this->expiredTail = timeout;
+
+            expired = true;
+        }
+
+        timeout = next;
+    }
+
+    if( expired ) {
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerWheelTimeout* TimerWheel::takeExpired( TimerWheelWorker* worker ) {
+
+    synchronized( &mutex ) {
+
+        while( !this->shutDown ) {
+
+            if( this->expiredHead == NULL ) {
+                mutex.wait();
+                continue;
+            }
+
+            TimerWheelTimeout* timeout = this->expiredHead;
+            this->expiredHead = timeout->next;
+            if( this->expiredHead == NULL ) {
+                this->expiredTail = NULL;
+            }
+            timeout->next = NULL;
+
+            if( timeout->cancelled ) {
+                destroy( timeout );
+                continue;
+            }
+
+            // A one shot task is done with the wheel once it runs, so it can be scheduled
+            // again from within its own run method.
+            if( timeout->period == 0 ) {
+                this->timeouts.remove( timeout->task );
+            }
+
+            worker->current = timeout;
+            return timeout;
+        }
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::completed( TimerWheelTimeout* timeout ) {
+
+    bool dispose = true;
+
+    synchronized( &mutex ) {
+
+        for( std::size_t i = 0; i < this->workers.size(); ++i ) {
+            if( this->workers[i]->current == timeout ) {
+                this->workers[i]->current = NULL;
+            }
+        }
+
+        if( timeout->period > 0 && !timeout->cancelled && !this->shutDown ) {
+            this->insert( timeout, timeout->deadline + timeout->period );
+            dispose = false;
+        }
+
+        mutex.notifyAll();
+    }
+
+    if( dispose ) {
+        destroy( timeout );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::startThreads() {
+
+    this->startTime = currentTime();
+    this->tick = 0;
+    this->started = true;
+
+    this->tickThread = new Thread( this, this->name + " Tick" );
+
+    for( int i = 0; i < this->workerCount; ++i ) {
+        TimerWheelWorker* worker = new TimerWheelWorker( this );
+        worker->thread = new Thread( worker, this->name + " Worker " + Integer::toString( i + 1 ) );
+        this->workers.push_back( worker );
+        this->workerThreads.push_back( worker->thread );
+    }
+
+    this->tickThread->start();
+    for( int i = 0; i < this->workerCount; ++i ) {
+        this->workerThreads[i]->start();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long TimerWheel::currentTime() const {
+    return System::nanoTime() / 1000000;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::destroy( TimerWheelTimeout* timeout ) {
+
+    if( timeout->ownsTask ) {
+        delete timeout->task;
+    }
+
+    delete timeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerWheel& TimerWheel::getInstance() {
+
+    if( theOnlyInstance == NULL ) {
+        throw IllegalStateException( __FILE__, __LINE__, "Library is not initialized." );
+    }
+
+    return *theOnlyInstance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::initialize() {
+    theOnlyInstance = new TimerWheel( "ActiveMQ Timer" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheel::shutdown() {
+    delete theOnlyInstance;
+    theOnlyInstance = NULL;
+}
@@ -0,0 +1,239 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_TIMERWHEEL_H_
+#define _ACTIVEMQ_THREADS_TIMERWHEEL_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/StlMap.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace threads {
+
+    class TimerWheelTimeout;
+    class TimerWheelWorker;
+
+    /**
+     * A hashed timing wheel that runs Runnable tasks once after a delay or repeatedly at
+     * a fixed rate.
+     *
+     * Time is divided into ticks of a fixed duration, and the wheel is an array of buckets
+     * that each hold the tasks expiring on a given tick, so scheduling, canceling and
+     * expiring a task are all constant time operations no matter how many tasks are
+     * registered.  A single tick thread advances the wheel and hands expired tasks to a
+     * fixed number of worker threads that run them, the threads are only created once the
+     * first task is scheduled.
+     *
+     * Since the worker threads are shared by every task registered with the wheel a task's
+     * run method should complete quickly, a task that blocks delays the tasks that expire
+     * after it.  The library creates a single shared instance that is used by the transports
+     * for their periodic checks, it can be accessed with the getInstance method.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API TimerWheel : public decaf::lang::Runnable {
+    private:
+
+        friend class TimerWheelWorker;
+
+        std::string name;
+        long long tickDuration;
+        int workerCount;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+        std::vector<TimerWheelTimeout*> wheel;
+        decaf::util::StlMap<decaf::lang::Runnable*, TimerWheelTimeout*> timeouts;
+
+        TimerWheelTimeout* expiredHead;
+        TimerWheelTimeout* expiredTail;
+
+        long long tick;
+        long long startTime;
+        int waitingCount;
+        bool started;
+        bool shutDown;
+
+        decaf::lang::Thread* tickThread;
+        std::vector<decaf::lang::Thread*> workerThreads;
+        std::vector<TimerWheelWorker*> workers;
+
+        static TimerWheel* theOnlyInstance;
+
+    private:
+
+        TimerWheel( const TimerWheel& );
+        TimerWheel& operator= ( const TimerWheel& );
+
+    public:
+
+        /**
+         * Creates a new TimerWheel.
+         *
+         * @param name
+         *      The name given to the threads this wheel creates.
+         * @param tickDuration
+         *      The time in milliseconds between each tick of the wheel, delays are rounded
+         *      up to a multiple of this value.
+         * @param ticksPerWheel
+         *      The number of buckets in the wheel, rounded up to a power of two.
+         * @param workerCount
+         *      The number of threads that run the expired tasks.
+         *
+         * @throws IllegalArgumentException if the name is empty or any of the other
+         *         arguments is less than one.
+         */
+        TimerWheel( const std::string& name, long long tickDuration = 10,
+                    int ticksPerWheel = 512, int workerCount = 2 );
+
+        /**
+         * Stops the wheel's threads, any tasks that have not yet run are discarded and
+         * those that were given to the wheel are destroyed.
+         */
+        virtual ~TimerWheel();
+
+        /**
+         * Schedules the given task to run once after the given delay.
+         *
+         * @param task
+         *      The task to run, cannot be NULL.
+         * @param delay
+         *      The time in milliseconds to wait before the task is run.
+         * @param ownsTask
+         *      If true the wheel deletes the task once it has run or is canceled.
+         *
+         * @throws NullPointerException if the task is NULL.
+         * @throws IllegalArgumentException if the delay is negative.
+         * @throws IllegalStateException if the task is already scheduled with this wheel or
+         *         the wheel has been shut down.
+         */
+        void schedule( decaf::lang::Runnable* task, long long delay, bool ownsTask = true );
+
+        /**
+         * Schedules the given task to run repeatedly after the given delay, each subsequent
+         * execution is scheduled relative to the time the previous one should have started
+         * so that the task runs at a fixed rate.
+         *
+         * @param task
+         *      The task to run, cannot be NULL.
+         * @param delay
+         *      The time in milliseconds to wait before the task is first run.
+         * @param period
+         *      The time in milliseconds between successive runs of the task.
+         * @param ownsTask
+         *      If true the wheel deletes the task once it is canceled.
+         *
+         * @throws NullPointerException if the task is NULL.
+         * @throws IllegalArgumentException if the delay is negative or the period is not
+         *         greater than zero.
+         * @throws IllegalStateException if the task is already scheduled with this wheel or
+         *         the wheel has been shut down.
+         */
+        void scheduleAtFixedRate( decaf::lang::Runnable* task, long long delay,
+                                  long long period, bool ownsTask = true );
+
+        /**
+         * Cancels the given task.  If the task is running on one of the wheel's worker
+         * threads this method waits for that run to complete before returning, so that once
+         * it returns the caller is free to destroy any state the task refers to.  When called
+         * from a task running on this wheel it never waits, since the run it would wait on
+         * could itself be blocked waiting for a worker, the caller must then not destroy
+         * state the canceled task may still be using.
+         *
+         * @param task
+         *      The task to cancel.
+         *
+         * @returns true if the task was scheduled with this wheel.
+         */
+        bool cancel( decaf::lang::Runnable* task );
+
+        /**
+         * @returns the number of tasks currently scheduled with this wheel.
+         */
+        int getPendingCount() const;
+
+        /**
+         * @returns the time in milliseconds between each tick of the wheel.
+         */
+        long long getTickDuration() const {
+            return this->tickDuration;
+        }
+
+        /**
+         * @returns the number of worker threads that run the expired tasks.
+         */
+        int getWorkerCount() const {
+            return this->workerCount;
+        }
+
+        /**
+         * Advances the wheel, this is the body of the tick thread and should not be called
+         * directly.
+         */
+        virtual void run();
+
+    public:
+
+        /**
+         * Gets the TimerWheel shared by every connection in this process.
+         *
+         * @returns a reference to the shared TimerWheel.
+         */
+        static TimerWheel& getInstance();
+
+        /**
+         * Creates the shared TimerWheel, called from the library initialization code.
+         */
+        static void initialize();
+
+        /**
+         * Destroys the shared TimerWheel, called from the library shutdown code.
+         */
+        static void shutdown();
+
+    private:
+
+        void doSchedule( decaf::lang::Runnable* task, long long delay, long long period, bool ownsTask );
+
+        void insert( TimerWheelTimeout* timeout, long long deadline );
+
+        void unlink( TimerWheelTimeout* timeout );
+
+        void expireTick( long long tickToExpire );
+
+        TimerWheelTimeout* takeExpired( TimerWheelWorker* worker );
+
+        void completed( TimerWheelTimeout* timeout );
+
+        void startThreads();
+
+        long long currentTime() const;
+
+        static void destroy( TimerWheelTimeout* timeout );
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_THREADS_TIMERWHEEL_H_ */
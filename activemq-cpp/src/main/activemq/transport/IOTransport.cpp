@@ -18,11 +18,17 @@
 #include "IOTransport.h"
 
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/EOFException.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/util/Config.h>
 #include <typeinfo>
+#include <algorithm>
+#include <cstring>
 
 using namespace activemq;
 using namespace activemq::transport;
@@ -33,17 +39,77 @@ using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util::concurrent;
+using namespace decaf::internal::util::concurrent;
+using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
 LOGDECAF_INITIALIZE( logger, IOTransport, "activemq.transport.IOTransport" )
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // The most bytes taken from the input stream by one call to readAvailable, anything
+    // beyond this is read on the next call so that other channels get their turn.
+    const int MAX_NON_BLOCKING_READ = 65536;
+
+    // The size of the OpenWire frame size prefix.
+    const int FRAME_SIZE_PREFIX = 4;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+class IOTransport::AsyncWriter : public decaf::lang::Runnable {
+private:
+
+    IOTransport* parent;
+
+private:
+
+    AsyncWriter( const AsyncWriter& );
+    AsyncWriter& operator= ( const AsyncWriter& );
+
+public:
+
+    AsyncWriter( IOTransport* parent ) : Runnable(), parent( parent ) {}
+    virtual ~AsyncWriter() {}
+
+    virtual void run() {
+        this->parent->runWriter();
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 IOTransport::IOTransport() : wireFormat(),
                              listener(NULL),
                              inputStream(NULL),
                              outputStream(NULL),
                              thread(),
-                             closed(false) {
+                             started(false),
+                             closed(false),
+                             nonBlockingRead(false),
+                             readBuffer(),
+                             readPosition(0),
+                             readLimit(0),
+                             writeCoalescing(false),
+                             writeCoalescingMaxDelay(0),
+                             writeCoalescingMaxBytes(8192),
+                             coalescingMutex(),
+                             coalescingWriterActive(false),
+                             coalescingFailed(false),
+                             pendingBatch(1),
+                             writtenBatch(0),
+                             pendingBuffer(),
+                             pendingDataOut(),
+                             writingBuffer(),
+                             writingDataOut(),
+                             asyncWriter(false),
+                             asyncWriterQueueSize(1000),
+                             writer(),
+                             writerThread(),
+                             writerQueue(),
+                             writerQueued(),
+                             writerMutex(),
+                             writerFailed(false),
+                             writerStopped(false) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -52,7 +118,33 @@ IOTransport::IOTransport( const Pointer<WireFormat>& wireFormat ) : wireFormat(w
                                                                     inputStream(NULL),
                                                                     outputStream(NULL),
                                                                     thread(),
-                                                                    closed(false) {
+                                                                    started(false),
+                                                                    closed(false),
+                                                                    nonBlockingRead(false),
+                                                                    readBuffer(),
+                                                                    readPosition(0),
+                                                                    readLimit(0),
+                                                                    writeCoalescing(false),
+                                                                    writeCoalescingMaxDelay(0),
+                                                                    writeCoalescingMaxBytes(8192),
+                                                                    coalescingMutex(),
+                                                                    coalescingWriterActive(false),
+                                                                    coalescingFailed(false),
+                                                                    pendingBatch(1),
+                                                                    writtenBatch(0),
+                                                                    pendingBuffer(),
+                                                                    pendingDataOut(),
+                                                                    writingBuffer(),
+                                                                    writingDataOut(),
+                                                                    asyncWriter(false),
+                                                                    asyncWriterQueueSize(1000),
+                                                                    writer(),
+                                                                    writerThread(),
+                                                                    writerQueue(),
+                                                                    writerQueued(),
+                                                                    writerMutex(),
+                                                                    writerFailed(false),
+                                                                    writerStopped(false) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -102,8 +194,8 @@ void IOTransport::oneway( const Pointer<Command>& command ) {
                 "IOTransport::oneway() - transport is closed!" );
         }
 
-        // Make sure the thread has been started.
-        if( thread == NULL ){
+        // Make sure the transport has been started.
+        if( !started ){
             throw IOException(
                 __FILE__, __LINE__,
                 "IOTransport::oneway() - transport is not started" );
@@ -123,6 +215,16 @@ void IOTransport::oneway( const Pointer<Command>& command ) {
                 "IOTransport::oneway() - invalid output stream" );
         }
 
+        if( this->asyncWriter ) {
+            asyncOneway( command );
+            return;
+        }
+
+        if( this->writeCoalescing ) {
+            coalescedOneway( command );
+            return;
+        }
+
         synchronized( outputStream ){
             // Write the command to the output stream.
             this->wireFormat->marshal( command, this, this->outputStream );
@@ -134,6 +236,274 @@ void IOTransport::oneway( const Pointer<Command>& command ) {
     AMQ_CATCHALL_THROW( IOException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::coalescedOneway( const Pointer<Command>& command ) {
+
+    bool handedOver = false;
+    long long batch = 0;
+
+    synchronized( &coalescingMutex ) {
+
+        // Hold senders back while a full batch is waiting on the active writer.
+        while( this->coalescingWriterActive && !this->coalescingFailed &&
+               this->pendingBuffer->size() >= this->writeCoalescingMaxBytes ) {
+
+            coalescingMutex.wait();
+        }
+
+        if( this->coalescingFailed ) {
+            throw IOException( __FILE__, __LINE__,
+                "IOTransport::oneway() - a coalesced write has failed" );
+        }
+
+        this->wireFormat->marshal( command, this, this->pendingDataOut.get() );
+        batch = this->pendingBatch;
+
+        // Another sender is writing, wait for it to write the batch this frame went
+        // into or to hand the writer role over to us.
+        if( this->coalescingWriterActive ) {
+
+            if( this->pendingBuffer->size() >= this->writeCoalescingMaxBytes ) {
+                coalescingMutex.notifyAll();
+            }
+
+            while( this->coalescingWriterActive && !this->coalescingFailed &&
+                   this->writtenBatch < batch ) {
+
+                coalescingMutex.wait();
+            }
+
+            if( this->coalescingFailed ) {
+                throw IOException( __FILE__, __LINE__,
+                    "IOTransport::oneway() - a coalesced write has failed" );
+            }
+
+            if( this->writtenBatch >= batch ) {
+                return;
+            }
+
+            handedOver = true;
+        }
+
+        this->coalescingWriterActive = true;
+
+        // A batch that filled up while the last one was written goes out right away.
+        if( !handedOver && this->writeCoalescingMaxDelay > 0 &&
+            this->pendingBuffer->size() < this->writeCoalescingMaxBytes ) {
+
+            coalescingMutex.wait( this->writeCoalescingMaxDelay );
+        }
+
+        this->pendingBuffer.swap( this->writingBuffer );
+        this->pendingDataOut.swap( this->writingDataOut );
+        this->pendingBatch++;
+    }
+
+    // Only the one batch is written, frames queued behind it are written by one of
+    // their own senders once the writer role is handed over.
+    try{
+
+        synchronized( outputStream ){
+            this->writingBuffer->writeTo( this->outputStream );
+            this->outputStream->flush();
+        }
+
+        // A batch only goes past the limit by its last frame, don't hold on to the
+        // room a large one needed.
+        this->writingBuffer->resetAndTrim( std::max( this->writeCoalescingMaxBytes, 1 ) );
+
+    } catch(...) {
+
+        synchronized( &coalescingMutex ) {
+            this->coalescingFailed = true;
+            this->coalescingWriterActive = false;
+            coalescingMutex.notifyAll();
+        }
+
+        throw;
+    }
+
+    synchronized( &coalescingMutex ) {
+        this->writtenBatch = batch;
+        this->coalescingWriterActive = false;
+        coalescingMutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::asyncOneway( const Pointer<Command>& command ) {
+
+    if( this->writerFailed ) {
+        throw IOException( __FILE__, __LINE__,
+            "IOTransport::oneway() - writer thread has failed" );
+    }
+
+    // Slow path, the writer is behind so wait for it to catch up.
+    if( this->writerQueued.get() >= this->asyncWriterQueueSize ) {
+
+        synchronized( &writerMutex ) {
+            while( this->writerQueued.get() >= this->asyncWriterQueueSize &&
+                   !this->closed && !this->writerFailed ) {
+
+                writerMutex.wait();
+            }
+        }
+
+        if( this->closed || this->writerFailed ) {
+            throw IOException( __FILE__, __LINE__,
+                "IOTransport::oneway() - transport closed while waiting to send" );
+        }
+    }
+
+    this->writerQueue->offer( command );
+
+    // Only the transition from empty needs to wake the writer, once closed the
+    // writer may already have drained the queue and exited.
+    if( this->writerQueued.incrementAndGet() == 1 || this->closed ) {
+        synchronized( &writerMutex ) {
+
+            if( this->writerStopped || this->writerFailed ) {
+                throw IOException( __FILE__, __LINE__,
+                    "IOTransport::oneway() - transport closed before the command was written" );
+            }
+
+            writerMutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::runWriter() {
+
+    try{
+
+        Pointer<Command> command;
+        bool done = false;
+
+        while( !done ) {
+
+            // On close everything that was queued is still written, the writer only
+            // stops once the queue is empty so that commands like the ShutdownInfo
+            // sent just before close reach the broker.
+            synchronized( &writerMutex ) {
+                while( this->writerQueued.get() <= 0 && !this->closed ) {
+                    writerMutex.wait();
+                }
+
+                if( this->writerQueued.get() <= 0 ) {
+                    this->writerStopped = true;
+                    done = true;
+                }
+            }
+
+            if( done ) {
+                break;
+            }
+
+            int drained = 0;
+
+            synchronized( outputStream ) {
+
+                while( this->writerQueue->poll( command ) ) {
+                    this->wireFormat->marshal( command, this, this->outputStream );
+                    command.reset( NULL );
+                    drained++;
+                }
+
+                if( drained > 0 ) {
+                    this->outputStream->flush();
+                }
+            }
+
+            if( drained == 0 ) {
+                // A sender has counted its command but not finished linking it.
+                Thread::yield();
+                continue;
+            }
+
+            int before = this->writerQueued.getAndAdd( -drained );
+            if( before >= this->asyncWriterQueueSize ) {
+                synchronized( &writerMutex ) {
+                    writerMutex.notifyAll();
+                }
+            }
+        }
+    }
+    catch( exceptions::ActiveMQException& ex ){
+        ex.setMark( __FILE__, __LINE__ );
+        onWriterFailed( ex );
+    }
+    catch( decaf::lang::Exception& ex ){
+        exceptions::ActiveMQException exl( ex );
+        exl.setMark( __FILE__, __LINE__ );
+        onWriterFailed( exl );
+    }
+    catch( ... ){
+        exceptions::ActiveMQException ex(
+            __FILE__, __LINE__,
+            "IOTransport::runWriter - caught unknown exception" );
+        onWriterFailed( ex );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::onWriterFailed( decaf::lang::Exception& ex ) {
+
+    synchronized( &writerMutex ) {
+        this->writerFailed = true;
+        writerMutex.notifyAll();
+    }
+
+    fire( ex );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setAsyncWriter( bool value ) {
+
+    if( this->started ) {
+        throw IllegalStateException(
+            __FILE__, __LINE__,
+            "IOTransport::setAsyncWriter() - cannot be changed after the transport is started" );
+    }
+
+    this->asyncWriter = value;
+
+    if( value && this->writerQueue == NULL ) {
+        this->writerQueue.reset( new MpscLinkedQueue< Pointer<Command> >() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setWriteCoalescing( bool value ) {
+
+    if( this->started ) {
+        throw IllegalStateException(
+            __FILE__, __LINE__,
+            "IOTransport::setWriteCoalescing() - cannot be changed after the transport is started" );
+    }
+
+    this->writeCoalescing = value;
+
+    if( value && this->pendingBuffer == NULL ) {
+        this->pendingBuffer.reset( new ByteArrayOutputStream() );
+        this->pendingDataOut.reset( new DataOutputStream( this->pendingBuffer.get() ) );
+        this->writingBuffer.reset( new ByteArrayOutputStream() );
+        this->writingDataOut.reset( new DataOutputStream( this->writingBuffer.get() ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setNonBlockingRead( bool value ) {
+
+    if( this->started ) {
+        throw IllegalStateException(
+            __FILE__, __LINE__,
+            "IOTransport::setNonBlockingRead() - cannot be changed after the transport is started" );
+    }
+
+    this->nonBlockingRead = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransport::start() {
 
@@ -147,7 +517,7 @@ void IOTransport::start() {
         }
 
         // If it's already started, do nothing.
-        if( thread != NULL ){
+        if( started ){
             return;
         }
 
@@ -159,9 +529,19 @@ void IOTransport::start() {
                 "IO streams and wireFormat instances must be set before calling start" );
         }
 
-        // Start the polling thread.
-        thread.reset( new Thread( this ) );
-        thread->start();
+        // Start the polling thread, in non-blocking read mode our owner reads for us.
+        if( !this->nonBlockingRead ) {
+            thread.reset( new Thread( this ) );
+            thread->start();
+        }
+
+        if( this->asyncWriter ) {
+            this->writer.reset( new AsyncWriter( this ) );
+            this->writerThread.reset( new Thread( this->writer.get() ) );
+            this->writerThread->start();
+        }
+
+        this->started = true;
     }
     AMQ_CATCH_RETHROW( IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
@@ -206,6 +586,19 @@ void IOTransport::close() {
             thread.reset( NULL );
         }
 
+        // Wake the writer thread and any senders waiting on it then wait for
+        // it to write what is still queued and exit before the output stream
+        // goes away.
+        if( writerThread != NULL ){
+
+            synchronized( &writerMutex ) {
+                writerMutex.notifyAll();
+            }
+
+            writerThread->join();
+            writerThread.reset( NULL );
+        }
+
         // Close the output stream.
         if( outputStream != NULL ){
             outputStream->close();
@@ -255,6 +648,121 @@ void IOTransport::run() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool IOTransport::readAvailable() {
+
+    try{
+
+        if( closed || inputStream == NULL ){
+            return false;
+        }
+
+        // Nothing reported as available means the peer has closed the connection or an
+        // error is pending, either way a single byte read returns without blocking.
+        int length = this->inputStream->available();
+        if( length <= 0 ) {
+            length = 1;
+        } else if( length > MAX_NON_BLOCKING_READ ) {
+            length = MAX_NON_BLOCKING_READ;
+        }
+
+        if( (int)this->readBuffer.size() - this->readLimit < length ) {
+
+            // Move the partial frame to the front before deciding if we need to grow.
+            if( this->readPosition > 0 ) {
+                int remaining = this->readLimit - this->readPosition;
+                if( remaining > 0 ) {
+                    std::memmove( &this->readBuffer[0], &this->readBuffer[this->readPosition], remaining );
+                }
+                this->readPosition = 0;
+                this->readLimit = remaining;
+            }
+
+            if( (int)this->readBuffer.size() - this->readLimit < length ) {
+                std::size_t size = std::max( this->readBuffer.size() * 2,
+                                             (std::size_t)( this->readLimit + length ) );
+                this->readBuffer.resize( size );
+            }
+        }
+
+        int count = this->inputStream->read(
+            &this->readBuffer[0], (int)this->readBuffer.size(), this->readLimit, length );
+
+        if( count == -1 ) {
+            throw EOFException(
+                __FILE__, __LINE__,
+                "IOTransport::readAvailable - connection closed by the remote peer" );
+        }
+
+        this->readLimit += count;
+
+        processFrames();
+
+        return !closed;
+    }
+    catch( exceptions::ActiveMQException& ex ){
+        ex.setMark( __FILE__, __LINE__ );
+        fire( ex );
+    }
+    catch( decaf::lang::Exception& ex ){
+        exceptions::ActiveMQException exl( ex );
+        exl.setMark( __FILE__, __LINE__ );
+        fire( exl );
+    }
+    catch( ... ){
+
+        exceptions::ActiveMQException ex(
+            __FILE__, __LINE__,
+            "IOTransport::readAvailable - caught unknown exception" );
+
+        LOGDECAF_WARN(logger, ex.getStackTraceString() );
+
+        fire( ex );
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::processFrames() {
+
+    while( !closed && this->readLimit - this->readPosition >= FRAME_SIZE_PREFIX ) {
+
+        const unsigned char* prefix = &this->readBuffer[this->readPosition];
+        int frameSize = ( ( prefix[0] & 0xFF ) << 24 ) | ( ( prefix[1] & 0xFF ) << 16 ) |
+                        ( ( prefix[2] & 0xFF ) << 8 ) | ( prefix[3] & 0xFF );
+
+        if( frameSize < 0 || frameSize > Integer::MAX_VALUE - FRAME_SIZE_PREFIX ) {
+            throw IOException(
+                __FILE__, __LINE__,
+                "IOTransport::processFrames - invalid frame size: %d", frameSize );
+        }
+
+        int frameLength = frameSize + FRAME_SIZE_PREFIX;
+
+        // Wait for the rest of the frame.
+        if( this->readLimit - this->readPosition < frameLength ) {
+            break;
+        }
+
+        // The wire format reads the size prefix itself.
+        ByteArrayInputStream bytesIn( &this->readBuffer[0], (int)this->readBuffer.size(),
+                                      this->readPosition, frameLength );
+        DataInputStream dataIn( &bytesIn );
+
+        Pointer<Command> command( wireFormat->unmarshal( this, &dataIn ) );
+        this->readPosition += frameLength;
+
+        // Notify the listener.
+        fire( command );
+    }
+
+    if( this->readPosition == this->readLimit ) {
+        this->readPosition = 0;
+        this->readLimit = 0;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> IOTransport::request( const Pointer<Command>& command AMQCPP_UNUSED ) {
 
@@ -270,3 +778,13 @@ Pointer<Response> IOTransport::request( const Pointer<Command>& command AMQCPP_U
         __FILE__, __LINE__,
         "IOTransport::request() - unsupported operation" );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::asyncRequest( const Pointer<Command>& command AMQCPP_UNUSED,
+                                const Pointer<ResponseCallback>& responseCallback AMQCPP_UNUSED,
+                                unsigned int timeout AMQCPP_UNUSED ) {
+
+    throw decaf::lang::exceptions::UnsupportedOperationException(
+        __FILE__, __LINE__,
+        "IOTransport::asyncRequest() - unsupported operation" );
+}
@@ -30,8 +30,13 @@
 #include <decaf/lang/Thread.h>
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/DataOutputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/internal/util/concurrent/MpscLinkedQueue.h>
 #include <decaf/util/logging/LoggerDefines.h>
 #include <memory>
+#include <vector>
 
 namespace activemq{
 namespace transport{
@@ -47,6 +52,9 @@ namespace transport{
      * A thread polls on the input stream for in-coming commands.  When
      * a command is received, the command listener is notified.  The
      * polling thread is not started until the start method is called.
+     * In non-blocking read mode no thread is started, the owner of the
+     * transport instead calls readAvailable whenever the input stream has
+     * data and the commands are framed from what could be read.
      * The close method will close the associated streams.  Close can
      * be called explicitly by the user, but is also called in the
      * destructor.  Once this object has been closed, it cannot be
@@ -84,11 +92,90 @@ namespace transport{
          */
         Pointer<decaf::lang::Thread> thread;
 
+        /**
+         * Flag marking this transport as started.
+         */
+        volatile bool started;
+
         /**
          * Flag marking this transport as closed.
          */
         volatile bool closed;
 
+        /**
+         * When true no polling thread is started and incoming commands are
+         * only read when readAvailable is called.
+         */
+        bool nonBlockingRead;
+
+        /**
+         * Bytes read in non-blocking read mode that do not yet form a whole
+         * frame, the unconsumed data lies between the position and the limit.
+         */
+        std::vector<unsigned char> readBuffer;
+        int readPosition;
+        int readLimit;
+
+        /**
+         * When true concurrent senders marshal into a shared pending buffer and
+         * one of them writes and flushes the whole batch to the output stream.
+         */
+        bool writeCoalescing;
+
+        /**
+         * Time in milliseconds the writer waits for more frames before it writes
+         * a batch, zero means only frames that arrive during a write are batched.
+         */
+        long long writeCoalescingMaxDelay;
+
+        /**
+         * Once the pending batch reaches this many bytes it is written without
+         * waiting out the remaining delay.
+         */
+        int writeCoalescingMaxBytes;
+
+        /**
+         * Write coalescing state, the pending buffer collects marshaled frames
+         * while the writing buffer is being written by the active writer.  Each
+         * sender waits until the batch its frame went into has been written, the
+         * batch numbers track which batch is pending and which was last written.
+         */
+        decaf::util::concurrent::Mutex coalescingMutex;
+        bool coalescingWriterActive;
+        bool coalescingFailed;
+        long long pendingBatch;
+        long long writtenBatch;
+        Pointer<decaf::io::ByteArrayOutputStream> pendingBuffer;
+        Pointer<decaf::io::DataOutputStream> pendingDataOut;
+        Pointer<decaf::io::ByteArrayOutputStream> writingBuffer;
+        Pointer<decaf::io::DataOutputStream> writingDataOut;
+
+        /**
+         * When true oneway only places the command on the writer queue and a
+         * dedicated writer thread marshals, writes and flushes queued commands.
+         */
+        bool asyncWriter;
+
+        /**
+         * Number of queued but unwritten commands at which senders block until
+         * the writer thread catches up.
+         */
+        int asyncWriterQueueSize;
+
+        /**
+         * Async writer state, the lock free queue is only ever drained by the
+         * writer thread, the mutex is used to park the writer when the queue is
+         * empty and senders when it is full.
+         */
+        class AsyncWriter;
+        Pointer<AsyncWriter> writer;
+        Pointer<decaf::lang::Thread> writerThread;
+        Pointer< decaf::internal::util::concurrent::MpscLinkedQueue< Pointer<Command> > > writerQueue;
+        decaf::util::concurrent::atomic::AtomicInteger writerQueued;
+        decaf::util::concurrent::Mutex writerMutex;
+        volatile bool writerFailed;
+        bool writerStopped;
+
     private:
 
         IOTransport( const IOTransport& );
@@ -108,6 +195,55 @@ namespace transport{
          */
         void fire( const Pointer<Command>& command );
 
+        /**
+         * Marshals the command into the pending batch and returns once that batch
+         * has been written.  If no other sender is currently writing then the
+         * calling thread becomes the writer and writes that one batch, otherwise
+         * it waits for the active writer to finish and takes over if its frame is
+         * still pending.  Senders block while a full batch is pending.
+         *
+         * @param command
+         *      The command to send.
+         *
+         * @throws IOException if an error occurs while marshaling or writing.
+         */
+        void coalescedOneway( const Pointer<Command>& command );
+
+        /**
+         * Places the command on the writer queue, blocking while the queue is
+         * at its configured limit.
+         *
+         * @param command
+         *      The command to send.
+         *
+         * @throws IOException if the writer has failed or the transport is closed.
+         */
+        void asyncOneway( const Pointer<Command>& command );
+
+        /**
+         * Runs the writer thread, drains the queue and flushes once per batch
+         * until a write fails or the transport is closed and nothing is left
+         * on the queue.
+         */
+        void runWriter();
+
+        /**
+         * Marks the writer as failed, wakes any blocked senders and notifies
+         * the listener of the error.
+         *
+         * @param ex
+         *      The error that stopped the writer thread.
+         */
+        void onWriterFailed( decaf::lang::Exception& ex );
+
+        /**
+         * Unmarshals and fires every complete frame in the read buffer, the
+         * frames must carry the OpenWire size prefix.
+         *
+         * @throws IOException if a frame is invalid or cannot be unmarshaled.
+         */
+        void processFrames();
+
     public:
 
         /**
@@ -146,6 +282,126 @@ namespace transport{
             this->outputStream = os;
         }
 
+        /**
+         * @returns true if writes from concurrent senders are coalesced.
+         */
+        bool isWriteCoalescing() const {
+            return this->writeCoalescing;
+        }
+
+        /**
+         * Enables or disables coalescing of writes from concurrent senders, this
+         * must be configured before the transport is started.
+         *
+         * @param value
+         *      True to batch frames from concurrent senders into a single write.
+         */
+        void setWriteCoalescing( bool value );
+
+        /**
+         * @returns the time in milliseconds a writer waits for more frames.
+         */
+        long long getWriteCoalescingMaxDelay() const {
+            return this->writeCoalescingMaxDelay;
+        }
+
+        /**
+         * Sets the time in milliseconds a writer waits for more frames to arrive
+         * before writing a batch, zero disables the wait.
+         *
+         * @param value
+         *      The maximum delay in milliseconds.
+         */
+        void setWriteCoalescingMaxDelay( long long value ) {
+            this->writeCoalescingMaxDelay = value;
+        }
+
+        /**
+         * @returns the batch size in bytes at which a writer stops waiting.
+         */
+        int getWriteCoalescingMaxBytes() const {
+            return this->writeCoalescingMaxBytes;
+        }
+
+        /**
+         * Sets the batch size in bytes at which a writer stops waiting for more
+         * frames and writes the batch.
+         *
+         * @param value
+         *      The maximum number of bytes to hold before writing.
+         */
+        void setWriteCoalescingMaxBytes( int value ) {
+            this->writeCoalescingMaxBytes = value;
+        }
+
+        /**
+         * @returns true if commands are written by a dedicated writer thread.
+         */
+        bool isAsyncWriter() const {
+            return this->asyncWriter;
+        }
+
+        /**
+         * Enables or disables the dedicated writer thread, this must be configured
+         * before the transport is started.  When enabled write coalescing has no
+         * effect since the writer already batches all queued commands.
+         *
+         * @param value
+         *      True to have oneway queue commands for a writer thread.
+         */
+        void setAsyncWriter( bool value );
+
+        /**
+         * @returns the number of unwritten commands at which senders block.
+         */
+        int getAsyncWriterQueueSize() const {
+            return this->asyncWriterQueueSize;
+        }
+
+        /**
+         * Sets the number of queued but unwritten commands at which senders block
+         * until the writer thread has caught up.
+         *
+         * @param value
+         *      The maximum number of commands to queue, must be greater than zero.
+         */
+        void setAsyncWriterQueueSize( int value ) {
+            this->asyncWriterQueueSize = value;
+        }
+
+        /**
+         * @returns true if incoming commands are read by calls to readAvailable.
+         */
+        bool isNonBlockingRead() const {
+            return this->nonBlockingRead;
+        }
+
+        /**
+         * Enables or disables non-blocking read mode, this must be configured
+         * before the transport is started.  When enabled start does not create
+         * a polling thread and the owner must call readAvailable each time the
+         * input stream has data.  The wire format must prefix each frame with
+         * its size.
+         *
+         * @param value
+         *      True to read incoming commands only when readAvailable is called.
+         */
+        void setNonBlockingRead( bool value );
+
+        /**
+         * Reads the bytes that are available from the input stream without
+         * blocking and notifies the listener of every command that has been
+         * completely received, partial frames are kept until the next call.
+         * This is only used in non-blocking read mode and must not be called
+         * concurrently.  The caller must know that the input stream has data
+         * or that the remote peer has closed the connection, otherwise the read
+         * of the first byte blocks.
+         *
+         * @returns false if the transport is closed or the read failed, in which
+         *          case the exception listener has already been notified.
+         */
+        bool readAvailable();
+
     public:  //Transport methods
 
         virtual void oneway( const Pointer<Command>& command );
@@ -164,6 +420,15 @@ namespace transport{
          */
         virtual Pointer<Response> request( const Pointer<Command>& command, unsigned int timeout );
 
+        /**
+         * {@inheritDoc}
+         *
+         * This method always thrown an UnsupportedOperationException.
+         */
+        virtual void asyncRequest( const Pointer<Command>& command,
+                                   const Pointer<ResponseCallback>& responseCallback,
+                                   unsigned int timeout );
+
         virtual Pointer<wireformat::WireFormat> getWireFormat() const {
         	return this->wireFormat;
         }
@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_RESPONSECALLBACK_H_
+#define _ACTIVEMQ_TRANSPORT_RESPONSECALLBACK_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/commands/Response.h>
+#include <decaf/lang/Exception.h>
+#include <decaf/lang/Pointer.h>
+
+namespace activemq{
+namespace transport{
+
+    using decaf::lang::Pointer;
+    using activemq::commands::Response;
+
+    /**
+     * Receives the outcome of a request sent with Transport::asyncRequest.  Exactly one
+     * of the two methods is called for each request, from the thread that received the
+     * response or detected the failure, so implementations should not block.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API ResponseCallback {
+    public:
+
+        virtual ~ResponseCallback() {}
+
+        /**
+         * Called when the response to the request is received.
+         *
+         * @param response
+         *      The Response that the broker sent for the request.
+         */
+        virtual void onResponse( const Pointer<Response>& response ) = 0;
+
+        /**
+         * Called when no response will arrive for the request, because the request
+         * timed out or the Transport failed or was closed before it was answered.
+         *
+         * @param ex
+         *      The exception describing why the request failed.
+         */
+        virtual void onException( const decaf::lang::Exception& ex ) = 0;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_RESPONSECALLBACK_H_ */
@@ -29,6 +29,7 @@
 #include <activemq/util/Config.h>
 #include <activemq/commands/Command.h>
 #include <activemq/commands/Response.h>
+#include <activemq/transport/ResponseCallback.h>
 #include <typeinfo>
 
 namespace activemq{
@@ -116,6 +117,28 @@ namespace transport{
          */
         virtual Pointer<Response> request( const Pointer<Command>& command, unsigned int timeout ) = 0;
 
+        /**
+         * Sends the given command to the broker without waiting for the response, the
+         * outcome of the request is passed to the given callback once the response
+         * arrives or the request fails.  Many requests can be outstanding at once.
+         *
+         * @param command
+         *      The command to be sent.
+         * @param responseCallback
+         *      The callback that is notified of the outcome of the request.
+         * @param timeout
+         *      The time in milliseconds to wait for the response, zero to wait for it
+         *      until the Transport fails or is closed.
+         *
+         * @throws IOException if an exception occurs while sending the command, in which
+         *         case the callback is not called.
+         * @throws UnsupportedOperationException if this method is not implemented
+         *         by this transport.
+         */
+        virtual void asyncRequest( const Pointer<Command>& command,
+                                   const Pointer<ResponseCallback>& responseCallback,
+                                   unsigned int timeout ) = 0;
+
         /**
          * Gets the WireFormat instance that is in use by this transport.  In the case of
          * nested transport this method delegates down to the lowest level transport that
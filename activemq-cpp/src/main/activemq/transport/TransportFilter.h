@@ -121,6 +121,12 @@ namespace transport{
             return next->request( command, timeout );
         }
 
+        virtual void asyncRequest( const Pointer<Command>& command,
+                                   const Pointer<ResponseCallback>& responseCallback,
+                                   unsigned int timeout ) {
+            next->asyncRequest( command, responseCallback, timeout );
+        }
+
         virtual void setTransportListener( TransportListener* listener ) {
             this->listener = listener;
         }
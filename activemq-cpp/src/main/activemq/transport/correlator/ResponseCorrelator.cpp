@@ -16,10 +16,16 @@
  */
 
 #include "ResponseCorrelator.h"
-#include <algorithm>
+
+#include <activemq/threads/TimerWheel.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <map>
+#include <vector>
 
 using namespace std;
 using namespace activemq;
+using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace activemq::transport::correlator;
 using namespace activemq::exceptions;
@@ -29,29 +35,195 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 using namespace decaf::util::concurrent;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq{
+namespace transport{
+namespace correlator{
+
+    /**
+     * An entry in the table of outstanding requests.  The slots embedded in a shard
+     * are reused by one request after another, only when a shard runs out of them
+     * does a request get a slot of its own.
+     */
+    class RequestSlot {
+    public:
+
+        unsigned int commandId;
+        bool inUse;
+        bool completed;
+        Pointer<Response> response;
+        Pointer<ResponseCallback> responseCallback;
+        Pointer<Runnable> timeoutTask;
+
+    public:
+
+        RequestSlot() : commandId( 0 ), inUse( false ), completed( false ),
+                        response(), responseCallback(), timeoutTask() {
+        }
+
+        void reset() {
+            this->inUse = false;
+            this->completed = false;
+            this->response.reset( NULL );
+            this->responseCallback.reset( NULL );
+            this->timeoutTask.reset( NULL );
+        }
+    };
+
+    /**
+     * One shard of the request table.  Command ids are handed out in sequence so
+     * consecutive requests land in different shards and, within a shard, in
+     * consecutive slots, a request only probes a few slots past its home slot
+     * before spilling into the overflow map.  All access is made with the shard's
+     * mutex held, threads waiting on a synchronous request wait on that mutex.
+     */
+    class RequestShard {
+    public:
+
+        static const int SLOT_COUNT = 64;
+        static const int MAX_PROBES = 4;
+
+        decaf::util::concurrent::Mutex mutex;
+        RequestSlot slots[SLOT_COUNT];
+        std::map<unsigned int, RequestSlot*> overflow;
+
+    private:
+
+        RequestShard( const RequestShard& );
+        RequestShard& operator= ( const RequestShard& );
+
+    public:
+
+        RequestShard() : mutex(), overflow() {
+        }
+
+        ~RequestShard() {
+            std::map<unsigned int, RequestSlot*>::iterator iter = overflow.begin();
+            for( ; iter != overflow.end(); ++iter ) {
+                delete iter->second;
+            }
+        }
+
+        RequestSlot* acquire( unsigned int commandId, unsigned int hash ) {
+
+            RequestSlot* slot = NULL;
+
+            for( int i = 0; i < MAX_PROBES && slot == NULL; ++i ) {
+                RequestSlot* candidate = &slots[( hash + i ) & ( SLOT_COUNT - 1 )];
+                if( !candidate->inUse ) {
+                    slot = candidate;
+                }
+            }
+
+            if( slot == NULL ) {
+                slot = new RequestSlot();
+                overflow.insert( make_pair( commandId, slot ) );
+            }
+
+            slot->commandId = commandId;
+            slot->inUse = true;
+
+            return slot;
+        }
+
+        RequestSlot* find( unsigned int commandId, unsigned int hash ) {
+
+            for( int i = 0; i < MAX_PROBES; ++i ) {
+                RequestSlot* candidate = &slots[( hash + i ) & ( SLOT_COUNT - 1 )];
+                if( candidate->inUse && candidate->commandId == commandId ) {
+                    return candidate;
+                }
+            }
+
+            if( !overflow.empty() ) {
+                std::map<unsigned int, RequestSlot*>::iterator iter = overflow.find( commandId );
+                if( iter != overflow.end() ) {
+                    return iter->second;
+                }
+            }
+
+            return NULL;
+        }
+
+        void release( RequestSlot* slot ) {
+
+            if( slot >= slots && slot < slots + SLOT_COUNT ) {
+                slot->reset();
+            } else {
+                overflow.erase( slot->commandId );
+                delete slot;
+            }
+        }
+    };
+
+    /**
+     * Scheduled with the TimerWheel to fail an asynchronous request that was not
+     * answered within its timeout.
+     */
+    class RequestTimeoutTask : public decaf::lang::Runnable {
+    private:
+
+        RequestTimeoutTask( const RequestTimeoutTask& );
+        RequestTimeoutTask& operator= ( const RequestTimeoutTask& );
+
+    private:
+
+        ResponseCorrelator* parent;
+        unsigned int commandId;
+
+    public:
+
+        RequestTimeoutTask( ResponseCorrelator* parent, unsigned int commandId ) :
+            Runnable(), parent( parent ), commandId( commandId ) {
+        }
+
+        virtual ~RequestTimeoutTask() {}
+
+        virtual void run() {
+            // Expiring the request releases the correlator's reference to this
+            // task, so nothing can be touched once this call returns.
+            parent->expireRequest( commandId );
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
 namespace {
 
-    class ResponseFinalizer {
+    const unsigned int SHARD_BITS = 4;
+    const unsigned int SHARD_COUNT = 1 << SHARD_BITS;
+
+    inline RequestShard& shardOf( RequestShard* shards, unsigned int commandId ) {
+        return shards[commandId & ( SHARD_COUNT - 1 )];
+    }
+
+    inline unsigned int slotHash( unsigned int commandId ) {
+        return commandId >> SHARD_BITS;
+    }
+
+    /**
+     * Returns a synchronous request's slot to its shard even if an exception is thrown.
+     */
+    class SlotFinalizer {
     private:
 
-        ResponseFinalizer( const ResponseFinalizer& );
-        ResponseFinalizer operator= ( const ResponseFinalizer& );
+        SlotFinalizer( const SlotFinalizer& );
+        SlotFinalizer operator= ( const SlotFinalizer& );
 
     private:
 
-        Mutex* mutex;
-        int commandId;
-        std::map<unsigned int, Pointer<FutureResponse> >* map;
+        RequestShard* shard;
+        RequestSlot* slot;
 
     public:
 
-        ResponseFinalizer( Mutex* mutex, int commandId, std::map<unsigned int, Pointer<FutureResponse> >* map ) :
-            mutex( mutex ), commandId( commandId ), map( map ) {
+        SlotFinalizer( RequestShard* shard, RequestSlot* slot ) : shard( shard ), slot( slot ) {
         }
 
-        ~ResponseFinalizer() {
-            synchronized( mutex ){
-                map->erase( commandId );
+        ~SlotFinalizer() {
+            synchronized( &shard->mutex ){
+                shard->release( slot );
             }
         }
     };
@@ -59,14 +231,19 @@ namespace {
 
 ////////////////////////////////////////////////////////////////////////////////
 ResponseCorrelator::ResponseCorrelator( const Pointer<Transport>& next ) :
-    TransportFilter( next ), nextCommandId(1), requestMap(), mapMutex(), closed( true ) {
+    TransportFilter( next ), nextCommandId(1), shards( new RequestShard[SHARD_COUNT] ), closed( true ) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ResponseCorrelator::~ResponseCorrelator(){
 
     // Close the transport and destroy it.
-    close();
+    try{
+        close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    delete [] shards;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,84 +271,155 @@ void ResponseCorrelator::oneway( const Pointer<Command>& command ) {
 Pointer<Response> ResponseCorrelator::request( const Pointer<Command>& command ) {
 
     try{
+        return doRequest( command, false, 0 );
+    }
+    AMQ_CATCH_RETHROW( UnsupportedOperationException )
+    AMQ_CATCH_RETHROW( IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( ActiveMQException, IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
+    AMQ_CATCHALL_THROW( IOException )
+}
 
-        command->setCommandId( nextCommandId.getAndIncrement() );
-        command->setResponseRequired( true );
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Response> ResponseCorrelator::request( const Pointer<Command>& command, unsigned int timeout ) {
 
-        // Add a future response object to the map indexed by this
-        // command id.
-        Pointer<FutureResponse> futureResponse( new FutureResponse() );
+    try{
+        return doRequest( command, true, timeout );
+    }
+    AMQ_CATCH_RETHROW( UnsupportedOperationException )
+    AMQ_CATCH_RETHROW( IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( ActiveMQException, IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
+    AMQ_CATCHALL_THROW( IOException )
+}
 
-        synchronized( &mapMutex ){
-            requestMap.insert( make_pair( (unsigned int)command->getCommandId(), futureResponse ) );
-        }
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Response> ResponseCorrelator::doRequest( const Pointer<Command>& command, bool timed, unsigned int timeout ) {
 
-        // The finalizer will cleanup the map even if an exception is thrown.
-        ResponseFinalizer finalizer( &mapMutex, command->getCommandId(), &requestMap );
+    command->setCommandId( nextCommandId.getAndIncrement() );
+    command->setResponseRequired( true );
 
-        // Wait to be notified of the response via the futureResponse
-        // object.
-        Pointer<commands::Response> response;
+    unsigned int commandId = (unsigned int)command->getCommandId();
+    RequestShard& shard = shardOf( shards, commandId );
+    RequestSlot* slot = NULL;
 
-        // Send the request.
-        next->oneway( command );
+    // Claim a slot in the table indexed by this command id.
+    synchronized( &shard.mutex ){
+        slot = shard.acquire( commandId, slotHash( commandId ) );
+    }
 
-        // Get the response.
-        response = futureResponse->getResponse();
+    // The finalizer will return the slot even if an exception is thrown.
+    SlotFinalizer finalizer( &shard, slot );
 
-        if( response == NULL ){
+    // Send the request.
+    next->oneway( command );
 
-            throw IOException( __FILE__, __LINE__,
-                "No valid response received for command: %s, check broker.",
-                command->toString().c_str() );
+    // Wait to be notified of the response.
+    Pointer<commands::Response> response;
+
+    synchronized( &shard.mutex ){
+
+        long long deadline = System::currentTimeMillis() + timeout;
+
+        while( !slot->completed ) {
+
+            if( !timed ) {
+                shard.mutex.wait();
+            } else {
+                long long remaining = deadline - System::currentTimeMillis();
+                if( remaining <= 0 ) {
+                    break;
+                }
+                shard.mutex.wait( remaining );
+            }
         }
 
-        return response;
+        response = slot->response;
     }
-    AMQ_CATCH_RETHROW( UnsupportedOperationException )
-    AMQ_CATCH_RETHROW( IOException )
-    AMQ_CATCH_EXCEPTION_CONVERT( ActiveMQException, IOException )
-    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
-    AMQ_CATCHALL_THROW( IOException )
+
+    if( response == NULL ){
+
+        throw IOException( __FILE__, __LINE__,
+            "No valid response received for command: %s, check broker.",
+            command->toString().c_str() );
+    }
+
+    return response;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Pointer<Response> ResponseCorrelator::request( const Pointer<Command>& command, unsigned int timeout ) {
+void ResponseCorrelator::asyncRequest( const Pointer<Command>& command,
+                                       const Pointer<ResponseCallback>& responseCallback,
+                                       unsigned int timeout ) {
 
     try{
+
+        if( responseCallback == NULL ) {
+            throw NullPointerException( __FILE__, __LINE__, "ResponseCallback cannot be NULL" );
+        }
+
+        if( closed || next == NULL ){
+            throw IOException( __FILE__, __LINE__,
+                "transport already closed" );
+        }
+
         command->setCommandId( nextCommandId.getAndIncrement() );
         command->setResponseRequired( true );
 
-        // Add a future response object to the map indexed by this
-        // command id.
-        Pointer<FutureResponse> futureResponse( new FutureResponse() );
+        unsigned int commandId = (unsigned int)command->getCommandId();
+        RequestShard& shard = shardOf( shards, commandId );
+
+        // The slot is released by whichever of the response, the timeout or a
+        // failure comes first.
+        Pointer<Runnable> timeoutTask;
 
-        synchronized( &mapMutex ){
-            requestMap.insert( make_pair( (unsigned int)command->getCommandId(), futureResponse ) );
+        if( timeout > 0 ) {
+            timeoutTask.reset( new RequestTimeoutTask( this, commandId ) );
         }
 
-        // The finalizer will cleanup the map even if an exception is thrown.
-        ResponseFinalizer finalizer( &mapMutex, command->getCommandId(), &requestMap );
+        // The timeout is scheduled before the slot is published, once the slot can be
+        // seen a failure may release it and cancel the task at any time.  The shard is
+        // locked so the task can't find the request missing if it fires right away.
+        synchronized( &shard.mutex ){
 
-        // Wait to be notified of the response via the futureResponse
-        // object.
-        Pointer<commands::Response> response;
+            if( timeoutTask != NULL ) {
+                TimerWheel::getInstance().schedule( timeoutTask.get(), timeout, false );
+            }
 
-        // Send the request.
-        next->oneway( command );
+            RequestSlot* slot = shard.acquire( commandId, slotHash( commandId ) );
+            slot->responseCallback = responseCallback;
+            slot->timeoutTask = timeoutTask;
+        }
 
-        // Get the response.
-        response = futureResponse->getResponse( timeout );
+        try{
 
-        if( response == NULL ){
+            // A close that raced with this call may have failed the outstanding requests
+            // before this one was published.
+            if( closed ){
+                throw IOException( __FILE__, __LINE__,
+                    "transport already closed" );
+            }
 
-            throw IOException( __FILE__, __LINE__,
-                "No valid response received for command: %s, check broker.",
-                command->toString().c_str() );
-        }
+            next->oneway( command );
 
-        return response;
+        } catch(...) {
+
+            // If the request already completed its callback has been told, otherwise
+            // the caller learns of the failure from the exception alone.
+            Pointer<ResponseCallback> callback;
+            Pointer<Runnable> task;
+            if( !removeAsyncRequest( commandId, callback, task ) ) {
+                return;
+            }
+
+            if( task != NULL ) {
+                TimerWheel::getInstance().cancel( task.get() );
+            }
+
+            throw;
+        }
     }
+    AMQ_CATCH_RETHROW( NullPointerException )
     AMQ_CATCH_RETHROW( UnsupportedOperationException )
     AMQ_CATCH_RETHROW( IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( ActiveMQException, IOException )
@@ -179,6 +427,105 @@ Pointer<Response> ResponseCorrelator::request( const Pointer<Command>& command,
     AMQ_CATCHALL_THROW( IOException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ResponseCorrelator::removeAsyncRequest( unsigned int commandId,
+                                             Pointer<ResponseCallback>& responseCallback,
+                                             Pointer<Runnable>& timeoutTask ) {
+
+    RequestShard& shard = shardOf( shards, commandId );
+
+    synchronized( &shard.mutex ){
+
+        RequestSlot* slot = shard.find( commandId, slotHash( commandId ) );
+        if( slot == NULL || slot->responseCallback == NULL ){
+            return false;
+        }
+
+        responseCallback = slot->responseCallback;
+        timeoutTask = slot->timeoutTask;
+        shard.release( slot );
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelator::expireRequest( unsigned int commandId ) {
+
+    Pointer<ResponseCallback> responseCallback;
+    Pointer<Runnable> timeoutTask;
+
+    if( !removeAsyncRequest( commandId, responseCallback, timeoutTask ) ) {
+        return;
+    }
+
+    try{
+        responseCallback->onException( IOException( __FILE__, __LINE__,
+            "No response received for request %u within the timeout, check broker.", commandId ) );
+    }
+    AMQ_CATCH_NOTHROW( Exception )
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelator::failOutstandingRequests( const decaf::lang::Exception& cause ) {
+
+    std::vector< Pointer<ResponseCallback> > failed;
+    std::vector< Pointer<Runnable> > timeoutTasks;
+
+    for( unsigned int i = 0; i < SHARD_COUNT; ++i ) {
+
+        RequestShard& shard = shards[i];
+
+        synchronized( &shard.mutex ){
+
+            std::vector<RequestSlot*> inUse;
+
+            for( int j = 0; j < RequestShard::SLOT_COUNT; ++j ) {
+                if( shard.slots[j].inUse ) {
+                    inUse.push_back( &shard.slots[j] );
+                }
+            }
+
+            std::map<unsigned int, RequestSlot*>::iterator iter = shard.overflow.begin();
+            for( ; iter != shard.overflow.end(); ++iter ){
+                inUse.push_back( iter->second );
+            }
+
+            // Synchronous requests are woken and clean up after themselves, the
+            // asynchronous ones are removed here and their callbacks told.
+            std::vector<RequestSlot*>::iterator slot = inUse.begin();
+            for( ; slot != inUse.end(); ++slot ){
+                if( (*slot)->responseCallback == NULL ) {
+                    (*slot)->completed = true;
+                } else {
+                    failed.push_back( (*slot)->responseCallback );
+                    if( (*slot)->timeoutTask != NULL ) {
+                        timeoutTasks.push_back( (*slot)->timeoutTask );
+                    }
+                    shard.release( *slot );
+                }
+            }
+
+            shard.mutex.notifyAll();
+        }
+    }
+
+    std::vector< Pointer<Runnable> >::iterator task = timeoutTasks.begin();
+    for( ; task != timeoutTasks.end(); ++task ){
+        TimerWheel::getInstance().cancel( task->get() );
+    }
+
+    std::vector< Pointer<ResponseCallback> >::iterator callback = failed.begin();
+    for( ; callback != failed.end(); ++callback ){
+        try{
+            (*callback)->onException( cause );
+        }
+        AMQ_CATCH_NOTHROW( Exception )
+        AMQ_CATCHALL_NOTHROW()
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ResponseCorrelator::onCommand( const Pointer<Command>& command ) {
 
@@ -193,13 +540,18 @@ void ResponseCorrelator::onCommand( const Pointer<Command>& command ) {
     Pointer<Response> response =
         command.dynamicCast< Response >();
 
+    unsigned int commandId = (unsigned int)response->getCorrelationId();
+    RequestShard& shard = shardOf( shards, commandId );
+
+    Pointer<ResponseCallback> responseCallback;
+    Pointer<Runnable> timeoutTask;
+
     // It is a response - let's correlate ...
-    synchronized( &mapMutex ){
+    synchronized( &shard.mutex ){
 
-        // Look the future request up based on the correlation id.
-        std::map< unsigned int, Pointer<FutureResponse> >::iterator iter =
-            requestMap.find( response->getCorrelationId() );
-        if( iter == requestMap.end() ){
+        // Look the request up based on the correlation id.
+        RequestSlot* slot = shard.find( commandId, slotHash( commandId ) );
+        if( slot == NULL ){
 
             // This is not terrible - just log it.
             //printf( "ResponseCorrelator::onCommand() - "
@@ -208,12 +560,30 @@ void ResponseCorrelator::onCommand( const Pointer<Command>& command ) {
             return;
         }
 
-        // Get the future response (if it's in the map, it's not NULL).
-        Pointer<FutureResponse> futureResponse = iter->second;
+        // Hand the response to the thread waiting on it.
+        if( slot->responseCallback == NULL ) {
+            slot->response = response;
+            slot->completed = true;
+            shard.mutex.notifyAll();
+            return;
+        }
+
+        // Asynchronous requests have no waiting thread to clean up after them.
+        responseCallback = slot->responseCallback;
+        timeoutTask = slot->timeoutTask;
+        shard.release( slot );
+    }
 
-        // Set the response property in the future response.
-        futureResponse->setResponse( response );
+    // The task may be running, in which case this waits for it to find the request gone.
+    if( timeoutTask != NULL ) {
+        TimerWheel::getInstance().cancel( timeoutTask.get() );
     }
+
+    try{
+        responseCallback->onResponse( response );
+    }
+    AMQ_CATCH_NOTHROW( Exception )
+    AMQ_CATCHALL_NOTHROW()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -252,19 +622,17 @@ void ResponseCorrelator::close() {
 
     try{
 
+        // Mark it closed first so that a request issued while the outstanding ones are
+        // failed either is failed with them or sees the close itself.
+        bool wasClosed = closed;
+        closed = true;
+
         // Wake-up any outstanding requests.
-        synchronized( &mapMutex ){
-            std::map<unsigned int, Pointer<FutureResponse> >::iterator iter = requestMap.begin();
-            for( ; iter != requestMap.end(); ++iter ){
-                iter->second->setResponse( Pointer<Response>() );
-            }
-        }
+        failOutstandingRequests( IOException( __FILE__, __LINE__, "Transport closed before a response was received." ) );
 
-        if( !closed && next != NULL ){
+        if( !wasClosed && next != NULL ){
             next->close();
         }
-
-        closed = true;
     }
     AMQ_CATCH_RETHROW( IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
@@ -277,12 +645,7 @@ void ResponseCorrelator::onTransportException( Transport* source AMQCPP_UNUSED,
 
     // Trigger each outstanding request to complete so that we don't hang
     // forever waiting for one that has been sent without timeout.
-    synchronized( &mapMutex ){
-        std::map< unsigned int, Pointer<FutureResponse> >::iterator iter = requestMap.begin();
-        for( ; iter != requestMap.end(); ++iter ){
-            iter->second->setResponse( Pointer<Response>() );
-        }
-    }
+    failOutstandingRequests( ex );
 
     fire( ex );
 }
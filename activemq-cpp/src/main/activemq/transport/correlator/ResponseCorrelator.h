@@ -20,12 +20,12 @@
 
 #include <activemq/util/Config.h>
 #include <activemq/transport/TransportFilter.h>
-#include <activemq/transport/correlator/FutureResponse.h>
 #include <activemq/commands/Command.h>
 #include <activemq/commands/Response.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/lang/Runnable.h>
 #include <map>
 #include <stdio.h>
 
@@ -37,29 +37,37 @@ namespace correlator{
     using activemq::commands::Command;
     using activemq::commands::Response;
 
+    class RequestShard;
+    class RequestTimeoutTask;
+
     /**
      * This type of transport filter is responsible for correlating
      * asynchronous responses with requests.  Non-response messages
      * are simply sent directly to the CommandListener.  It owns
      * the transport that it
+     *
+     * Outstanding requests are kept in a table that is split into shards
+     * by command id, each shard holds a fixed number of reusable slots
+     * that are addressed directly from the command id so that issuing a
+     * request and matching its response neither allocate nor contend on
+     * a lock shared by every request.  Asynchronous requests that are
+     * given a timeout are expired by tasks scheduled with the shared
+     * TimerWheel.
      */
     class AMQCPP_API ResponseCorrelator : public TransportFilter {
     private:
 
+        friend class RequestTimeoutTask;
+
         /**
          * The next command id for sent commands.
          */
         decaf::util::concurrent::atomic::AtomicInteger nextCommandId;
 
         /**
-         * Map of request ids to future response objects.
+         * The shards of the table of requests that are waiting for a response.
          */
-        std::map<unsigned int, Pointer<FutureResponse> > requestMap;
-
-        /**
-         * Sync object for accessing the request map.
-         */
-        decaf::util::concurrent::Mutex mapMutex;
+        RequestShard* shards;
 
         /**
          * Flag to indicate the closed state.
@@ -84,6 +92,10 @@ namespace correlator{
 
         virtual Pointer<Response> request( const Pointer<Command>& command, unsigned int timeout );
 
+        virtual void asyncRequest( const Pointer<Command>& command,
+                                   const Pointer<ResponseCallback>& responseCallback,
+                                   unsigned int timeout );
+
         virtual void start();
 
         virtual void close();
@@ -110,6 +122,21 @@ namespace correlator{
          */
         virtual void onTransportException( Transport* source, const decaf::lang::Exception& ex );
 
+    private:
+
+        ResponseCorrelator( const ResponseCorrelator& );
+        ResponseCorrelator& operator= ( const ResponseCorrelator& );
+
+        Pointer<Response> doRequest( const Pointer<Command>& command, bool timed, unsigned int timeout );
+
+        bool removeAsyncRequest( unsigned int commandId,
+                                 Pointer<ResponseCallback>& responseCallback,
+                                 Pointer<decaf::lang::Runnable>& timeoutTask );
+
+        void expireRequest( unsigned int commandId );
+
+        void failOutstandingRequests( const decaf::lang::Exception& cause );
+
     };
 
 }}}
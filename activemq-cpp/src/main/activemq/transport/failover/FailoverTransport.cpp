@@ -23,6 +23,7 @@
 #include <activemq/transport/TransportRegistry.h>
 #include <activemq/threads/DedicatedTaskRunner.h>
 #include <activemq/threads/CompositeTaskRunner.h>
+#include <activemq/threads/TimerWheel.h>
 #include <decaf/util/Random.h>
 #include <decaf/util/StringTokenizer.h>
 #include <decaf/lang/System.h>
@@ -31,6 +32,7 @@
 using namespace std;
 using namespace activemq;
 using namespace activemq::state;
+using namespace activemq::threads;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace activemq::transport;
@@ -39,9 +41,86 @@ using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::net;
 using namespace decaf::util;
+using namespace decaf::util::concurrent;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    // Scheduled with the shared TimerWheel to end the wait between reconnect attempts,
+    // the task runner thread is then free to run the other tasks while it waits.
+    class ReconnectDelayTask : public Runnable {
+    private:
+
+        FailoverTransport* parent;
+
+    private:
+
+        ReconnectDelayTask( const ReconnectDelayTask& );
+        ReconnectDelayTask& operator= ( const ReconnectDelayTask& );
+
+    public:
+
+        ReconnectDelayTask( FailoverTransport* parent ) : parent( parent ) {
+        }
+
+        virtual ~ReconnectDelayTask() {}
+
+        virtual void run() {
+
+            synchronized( &parent->reconnectMutex ) {
+                parent->reconnectDelayPending = false;
+            }
+
+            parent->taskRunner->wakeup();
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ActiveSendFinalizer {
+    private:
+
+        ActiveSendFinalizer( const ActiveSendFinalizer& );
+        ActiveSendFinalizer operator= ( const ActiveSendFinalizer& );
+
+    private:
+
+        Mutex* sendMutex;
+        Mutex* reconnectMutex;
+        int* activeSends;
+
+    public:
+
+        ActiveSendFinalizer( Mutex* sendMutex, Mutex* reconnectMutex, int* activeSends ) :
+            sendMutex( sendMutex ), reconnectMutex( reconnectMutex ), activeSends( activeSends ) {
+        }
+
+        ~ActiveSendFinalizer() {
+
+            bool last = false;
+
+            synchronized( sendMutex ) {
+                last = --( *activeSends ) == 0;
+            }
+
+            // The reconnect task waits on the reconnectMutex, it is taken after the
+            // sendMutex is released to keep the lock order used by the waiting side.
+            if( last ) {
+                synchronized( reconnectMutex ) {
+                    reconnectMutex->notifyAll();
+                }
+            }
+        }
+    };
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 FailoverTransport::FailoverTransport() : closed(false),
                                          connected(false),
@@ -63,9 +142,11 @@ FailoverTransport::FailoverTransport() : closed(false),
                                          firstConnection(true),
                                          updateURIsSupported(true),
                                          reconnectSupported(true),
+                                         reconnectDelayPending(false),
                                          reconnectMutex(),
-                                         sleepMutex(),
                                          listenerMutex(),
+                                         sendMutex(),
+                                         activeSends(0),
                                          stateTracker(),
                                          requestMap(),
                                          uris(new URIPool()),
@@ -76,6 +157,7 @@ FailoverTransport::FailoverTransport() : closed(false),
                                          backups(),
                                          closeTask(new CloseTransportsTask()),
                                          taskRunner(new CompositeTaskRunner()),
+                                         reconnectDelayTask(new ReconnectDelayTask( this )),
                                          disposedListener(),
                                          myTransportListener(new FailoverTransportListener( this )),
                                          transportListener(NULL) {
@@ -182,6 +264,20 @@ std::string FailoverTransport::getRemoteAddress() const {
 ////////////////////////////////////////////////////////////////////////////////
 void FailoverTransport::oneway( const Pointer<Command>& command ) {
 
+    // While connected the send doesn't need the reconnectMutex, it is only taken when
+    // the command must wait for a transport or be retried on a new one.
+    try {
+        if( onewayOnConnectedTransport( command ) ) {
+            return;
+        }
+    } catch( Exception& ex ) {
+        if( !closed ) {
+            ex.setMark( __FILE__, __LINE__ );
+            throw IOException( ex );
+        }
+        return;
+    }
+
     Pointer<Exception> error;
 
     try {
@@ -211,10 +307,13 @@ void FailoverTransport::oneway( const Pointer<Command>& command ) {
 
             // Keep trying until the message is sent.
             for( int i = 0; !closed; i++ ) {
+
+                Pointer<Transport> transport;
+
                 try {
 
                     // Wait for transport to be connected.
-                    Pointer<Transport> transport = connectedTransport;
+                    transport = connectedTransport;
                     long long start = System::currentTimeMillis();
                     bool timedout = false;
 
@@ -270,7 +369,6 @@ void FailoverTransport::oneway( const Pointer<Command>& command ) {
                     // Send the message.
                     try {
                         transport->oneway( command );
-                        stateTracker.trackBack( command );
                     } catch( IOException& e ) {
 
                         e.setMark( __FILE__, __LINE__ );
@@ -291,14 +389,14 @@ void FailoverTransport::oneway( const Pointer<Command>& command ) {
                         } else {
                             // Trigger the reconnect since we can't count on inactivity or
                             // other socket events to trip the failover condition.
-                            handleTransportFailure(e);
+                            handleTransportFailure( transport, e );
                         }
                     }
 
                     return;
                 } catch( IOException& e ) {
                     e.setMark( __FILE__, __LINE__ );
-                    handleTransportFailure( e );
+                    handleTransportFailure( transport, e );
                 }
             }
         }
@@ -328,6 +426,15 @@ Pointer<Response> FailoverTransport::request( const Pointer<Command>& command AM
         __FILE__, __LINE__, "FailoverTransport::request - Not Supported" );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::asyncRequest( const Pointer<Command>& command AMQCPP_UNUSED,
+                                      const Pointer<ResponseCallback>& responseCallback AMQCPP_UNUSED,
+                                      unsigned int timeout AMQCPP_UNUSED ) {
+
+    throw decaf::lang::exceptions::UnsupportedOperationException(
+        __FILE__, __LINE__, "FailoverTransport::asyncRequest - Not Supported" );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void FailoverTransport::start() {
 
@@ -386,16 +493,15 @@ void FailoverTransport::close() {
             backups->setEnabled( false );
             requestMap.clear();
 
-            if( connectedTransport != NULL ) {
+            synchronized( &sendMutex ) {
                 transportToStop.swap( connectedTransport );
             }
 
             reconnectMutex.notifyAll();
         }
 
-        synchronized( &sleepMutex ) {
-            sleepMutex.notifyAll();
-        }
+        // Waits for the task if its running so it can't wake a runner that is shutdown.
+        TimerWheel::getInstance().cancel( reconnectDelayTask.get() );
 
         taskRunner->shutdown( 2000 );
 
@@ -418,7 +524,9 @@ void FailoverTransport::reconnect( bool rebalance ) {
 
             if( rebalance ) {
 
-                transport.swap( this->connectedTransport );
+                synchronized( &sendMutex ) {
+                    transport.swap( this->connectedTransport );
+                }
 
                 if( transport != NULL ) {
 
@@ -470,11 +578,31 @@ void FailoverTransport::restoreTransport( const Pointer<Transport>& transport )
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void FailoverTransport::handleTransportFailure( const decaf::lang::Exception& error AMQCPP_UNUSED ) {
+void FailoverTransport::handleTransportFailure( const decaf::lang::Exception& error ) {
+
+    Pointer<Transport> transport;
+    synchronized( &reconnectMutex ) {
+        transport = connectedTransport;
+    }
+
+    if( transport != NULL ) {
+        handleTransportFailure( transport, error );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::handleTransportFailure( const Pointer<Transport>& failed,
+                                                const decaf::lang::Exception& error AMQCPP_UNUSED ) {
 
+    // Only the transport that failed is torn down, if a new one was connected since
+    // then the failure is stale and is ignored.
     Pointer<Transport> transport;
     synchronized( &reconnectMutex ) {
-        connectedTransport.swap( transport );
+        synchronized( &sendMutex ) {
+            if( connectedTransport == failed ) {
+                connectedTransport.swap( transport );
+            }
+        }
     }
 
     if( transport != NULL ) {
@@ -616,7 +744,7 @@ bool FailoverTransport::isPending() const {
     bool result = false;
 
     synchronized( &reconnectMutex ) {
-        if( this->connectedTransport == NULL && !closed && started ) {
+        if( this->connectedTransport == NULL && !closed && started && !reconnectDelayPending ) {
 
             int reconnectAttempts = 0;
             if( firstConnection ) {
@@ -654,6 +782,15 @@ bool FailoverTransport::iterate() {
             return false;
         } else {
 
+            // Sends still running on the old transport must finish first so that anything
+            // they tracked is part of the state that is restored on the new one.
+            waitForActiveSends();
+
+            if( closed || connectionFailure != NULL ) {
+                reconnectMutex.notifyAll();
+                return false;
+            }
+
             LinkedList<URI> failures;
             Pointer<Transport> transport;
             URI uri;
@@ -749,7 +886,9 @@ bool FailoverTransport::iterate() {
             if( transport != NULL ) {
                 reconnectDelay = initialReconnectDelay;
                 connectedTransportURI.reset( new URI( uri ) );
-                connectedTransport = transport;
+                synchronized( &sendMutex ) {
+                    connectedTransport = transport;
+                }
                 reconnectMutex.notifyAll();
                 connectFailures = 0;
                 connected = true;
@@ -818,8 +957,13 @@ bool FailoverTransport::iterate() {
 
     if( !closed ) {
 
-        synchronized( &sleepMutex ) {
-            sleepMutex.wait( (unsigned int)reconnectDelay );
+        // Rather than sleep here the next attempt is scheduled with the shared TimerWheel,
+        // isPending reports false until the delay task wakes the runner again.
+        synchronized( &reconnectMutex ) {
+            if( !closed ) {
+                reconnectDelayPending = true;
+                TimerWheel::getInstance().schedule( reconnectDelayTask.get(), reconnectDelay, false );
+            }
         }
 
         if( useExponentialBackOff ) {
@@ -920,6 +1064,83 @@ void FailoverTransport::processResponse(const Pointer<Response>& response) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool FailoverTransport::onewayOnConnectedTransport( const Pointer<Command>& command ) {
+
+    Pointer<Transport> transport;
+
+    synchronized( &sendMutex ) {
+        if( connectedTransport == NULL ) {
+            return false;
+        }
+
+        transport = connectedTransport;
+        activeSends++;
+    }
+
+    Pointer<Tracked> tracked;
+
+    {
+        ActiveSendFinalizer finalizer( &sendMutex, &reconnectMutex, &activeSends );
+
+        // If it was a request and it was not being tracked by the state tracker,
+        // then hold it in the requestMap so that we can replay it later.
+        tracked = stateTracker.track( command );
+        synchronized( &requestMap ) {
+            if( tracked != NULL && tracked->isWaitingForResponse() ) {
+                requestMap.put( command->getCommandId(), tracked );
+            } else if( tracked == NULL && command->isResponseRequired() ) {
+                requestMap.put( command->getCommandId(), command );
+            }
+        }
+
+        try {
+            transport->oneway( command );
+            return true;
+        } catch( IOException& e ) {
+
+            e.setMark( __FILE__, __LINE__ );
+
+            if( tracked == NULL ) {
+
+                // The caller retries an untracked command, take it out of the request map
+                // so that it is not sent 2 times on recovery.
+                if( command->isResponseRequired() ) {
+                    synchronized( &requestMap ) {
+                        requestMap.remove( command->getCommandId() );
+                    }
+                }
+            }
+
+            // The send stays counted as active until the failure has been handled so that
+            // iterate can't connect a new transport that this stale failure would then tear
+            // down.  Tracked commands are replayed when the state is restored, either way
+            // trigger the reconnect since we can't count on other socket events to trip it.
+            handleTransportFailure( transport, e );
+        }
+    }
+
+    return tracked != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::waitForActiveSends() {
+
+    // Called with the reconnectMutex held, a send that failed needs it to complete its
+    // failure handling before it stops counting as active so it is released while waiting.
+    // The last send to complete notifies the reconnectMutex, close notifies it as well.
+    while( !closed ) {
+
+        synchronized( &sendMutex ) {
+            if( activeSends == 0 ) {
+                return;
+            }
+        }
+
+        reconnectMutex.wait();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<wireformat::WireFormat> FailoverTransport::getWireFormat() const {
 
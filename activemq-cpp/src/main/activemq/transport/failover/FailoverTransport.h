@@ -51,11 +51,14 @@ namespace failover {
     using activemq::commands::Command;
     using activemq::commands::Response;
 
+    class ReconnectDelayTask;
+
     class AMQCPP_API FailoverTransport : public CompositeTransport,
                                          public activemq::threads::CompositeTask {
     private:
 
         friend class FailoverTransportListener;
+        friend class ReconnectDelayTask;
 
         bool closed;
         bool connected;
@@ -78,11 +81,17 @@ namespace failover {
         bool firstConnection;
         bool updateURIsSupported;
         bool reconnectSupported;
+        bool reconnectDelayPending;
 
         mutable decaf::util::concurrent::Mutex reconnectMutex;
-        mutable decaf::util::concurrent::Mutex sleepMutex;
         mutable decaf::util::concurrent::Mutex listenerMutex;
 
+        // Guards the connectedTransport for sends done outside the reconnectMutex, a send
+        // is counted in activeSends while it uses the transport so that the state isn't
+        // restored on a new transport until the sends on the old one have completed.
+        mutable decaf::util::concurrent::Mutex sendMutex;
+        int activeSends;
+
         state::ConnectionStateTracker stateTracker;
         decaf::util::StlMap<int, Pointer<Command> > requestMap;
 
@@ -94,6 +103,7 @@ namespace failover {
         Pointer<BackupTransportPool> backups;
         Pointer<CloseTransportsTask> closeTask;
         Pointer<CompositeTaskRunner> taskRunner;
+        Pointer<ReconnectDelayTask> reconnectDelayTask;
         Pointer<TransportListener> disposedListener;
         Pointer<TransportListener> myTransportListener;
         TransportListener* transportListener;
@@ -145,6 +155,10 @@ namespace failover {
 
         virtual Pointer<Response> request( const Pointer<Command>& command, unsigned int timeout );
 
+        virtual void asyncRequest( const Pointer<Command>& command,
+                                   const Pointer<ResponseCallback>& responseCallback,
+                                   unsigned int timeout );
+
         virtual Pointer<wireformat::WireFormat> getWireFormat() const;
 
         virtual void setWireFormat( const Pointer<wireformat::WireFormat>& wireFormat AMQCPP_UNUSED ) {}
@@ -278,6 +292,16 @@ namespace failover {
          */
         void handleTransportFailure( const decaf::lang::Exception& error );
 
+        /**
+         * Called when a send on the given Transport fails, the connected Transport is
+         * only torn down if it is still the one that failed.
+         * @param failed - The Transport that the failure occurred on.
+         * @param error - The CMS Exception that was thrown.
+         * @throw Exception if an error occurs.
+         */
+        void handleTransportFailure( const Pointer<Transport>& failed,
+                                     const decaf::lang::Exception& error );
+
         /**
          * Called when the Broker sends a ConnectionControl command which could
          * signal that this Client needs to reconnect in order to rebalance the
@@ -304,6 +328,27 @@ namespace failover {
 
         void processResponse(const Pointer<Response>& response);
 
+        /**
+         * Sends the command on the connected Transport without holding the reconnectMutex,
+         * if no Transport is connected or the send fails in a way that must be retried the
+         * caller falls back to waiting for a new Transport.
+         *
+         * @param command
+         *      The Command to send.
+         *
+         * @returns true if the command was handled, false if the caller must send it.
+         *
+         * @throw Exception if the command could not be tracked.
+         */
+        bool onewayOnConnectedTransport( const Pointer<Command>& command );
+
+        /**
+         * Waits for the in-flight sends on the connected Transport to complete, or for this
+         * Transport to be closed, must be called with the reconnectMutex held which is
+         * released while waiting.
+         */
+        void waitForActiveSends();
+
     };
 
 }}}
@@ -20,8 +20,9 @@
 #include "ReadChecker.h"
 #include "WriteChecker.h"
 
+#include <activemq/threads/TimerWheel.h>
 #include <activemq/threads/CompositeTask.h>
-#include <activemq/threads/CompositeTaskRunner.h>
+#include <activemq/threads/PooledTaskRunner.h>
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/commands/KeepAliveInfo.h>
 
@@ -29,6 +30,10 @@
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Boolean.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
 
 using namespace std;
 using namespace activemq;
@@ -46,11 +51,56 @@ using namespace decaf::util::concurrent::atomic;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer<ExecutorService> InactivityMonitor::asyncTasksExecutor;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // A blocked keep alive write holds one of these threads until the socket gives up,
+    // each monitor only ever occupies one so the others keep being served.
+    const int ASYNC_TASKS_POOL_SIZE = 4;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq{
 namespace transport{
 namespace inactivity{
 
+    // Iterates the read failure and keep alive tasks of one monitor on the shared pool.
+    class AsyncTasks : public Task {
+    private:
+
+        CompositeTask* readTask;
+        CompositeTask* writeTask;
+
+    private:
+
+        AsyncTasks( const AsyncTasks& );
+        AsyncTasks operator= ( const AsyncTasks& );
+
+    public:
+
+        AsyncTasks( CompositeTask* readTask, CompositeTask* writeTask ) :
+            readTask( readTask ), writeTask( writeTask ) {
+        }
+
+        virtual ~AsyncTasks() {}
+
+        virtual bool iterate() {
+
+            if( this->readTask->isPending() ) {
+                this->readTask->iterate();
+            }
+
+            if( this->writeTask->isPending() ) {
+                this->writeTask->iterate();
+            }
+
+            return this->readTask->isPending() || this->writeTask->isPending();
+        }
+    };
+
     class InactivityMonitorData {
     private:
 
@@ -66,16 +116,19 @@ namespace inactivity{
         Pointer<WireFormatInfo> localWireFormatInfo;
         Pointer<WireFormatInfo> remoteWireFormatInfo;
 
+        // The checks are run by the TimerWheel shared by all connections, they only
+        // signal this monitor's task runner which does any blocking work on a thread
+        // of the shared pool.
         Pointer<ReadChecker> readCheckerTask;
         Pointer<WriteChecker> writeCheckerTask;
 
-        Timer readCheckTimer;
-        Timer writeCheckTimer;
-
-        Pointer<CompositeTaskRunner> asyncTasks;
-
         Pointer<AsyncSignalReadErrorkTask> asyncReadTask;
         Pointer<AsyncWriteTask> asyncWriteTask;
+        Pointer<AsyncTasks> asyncTasksTask;
+
+        // Declared after the tasks so it is destroyed, waiting for any iteration still
+        // running on the pool, before they are.
+        Pointer<PooledTaskRunner> asyncTasks;
 
         AtomicBoolean monitorStarted;
 
@@ -100,11 +153,10 @@ namespace inactivity{
                                   remoteWireFormatInfo(),
                                   readCheckerTask(),
                                   writeCheckerTask(),
-                                  readCheckTimer(),
-                                  writeCheckTimer(),
-                                  asyncTasks(),
                                   asyncReadTask(),
                                   asyncWriteTask(),
+                                  asyncTasksTask(),
+                                  asyncTasks(),
                                   monitorStarted(),
                                   commandSent(),
                                   commandReceived(),
@@ -403,7 +455,8 @@ void InactivityMonitor::readCheck() {
 
     if( !this->members->commandReceived.get() ) {
 
-        // Set the failed state on our async Read Failure Task and wakeup its runner.
+        // Set the failed state on our async Read Failure Task and wakeup its runner, the
+        // failure isn't signaled from here since this runs on a shared TimerWheel thread.
         this->members->asyncReadTask->setFailed( true );
         this->members->asyncTasks->wakeup();
     }
@@ -420,6 +473,8 @@ void InactivityMonitor::writeCheck() {
 
     if( !this->members->commandSent.get() ) {
 
+        // The KeepAliveInfo write can block so it is left to our own task runner
+        // rather than tying up one of the shared TimerWheel threads.
         this->members->asyncWriteTask->setWrite( true );
         this->members->asyncTasks->wakeup();
     }
@@ -442,12 +497,20 @@ void InactivityMonitor::startMonitorThreads() {
             return;
         }
 
-        this->members->asyncTasks.reset( new CompositeTaskRunner() );
+        if( asyncTasksExecutor == NULL ) {
+            throw IllegalStateException( __FILE__, __LINE__, "Library is not initialized." );
+        }
+
+        // A runner left from an earlier start must be done with the tasks it iterates
+        // before they are replaced.
+        this->members->asyncTasks.reset( NULL );
+
         this->members->asyncReadTask.reset( new AsyncSignalReadErrorkTask( this, this->getRemoteAddress() ) );
         this->members->asyncWriteTask.reset( new AsyncWriteTask( this ) );
-
-        this->members->asyncTasks->addTask( this->members->asyncReadTask.get() );
-        this->members->asyncTasks->addTask( this->members->asyncWriteTask.get() );
+        this->members->asyncTasksTask.reset(
+            new AsyncTasks( this->members->asyncReadTask.get(), this->members->asyncWriteTask.get() ) );
+        this->members->asyncTasks.reset(
+            new PooledTaskRunner( asyncTasksExecutor, this->members->asyncTasksTask.get(), 1 ) );
 
         this->members->readCheckTime =
             Math::min( this->members->localWireFormatInfo->getMaxInactivityDuration(),
@@ -465,10 +528,12 @@ void InactivityMonitor::startMonitorThreads() {
             this->members->writeCheckTime = this->members->readCheckTime > 3 ?
                                                 this->members->readCheckTime / 3 : this->members->readCheckTime;
 
-            this->members->writeCheckTimer.scheduleAtFixedRate(
-                this->members->writeCheckerTask, this->members->initialDelayTime, this->members->writeCheckTime );
-            this->members->readCheckTimer.scheduleAtFixedRate(
-                this->members->readCheckerTask, this->members->initialDelayTime, this->members->readCheckTime );
+            TimerWheel& timer = TimerWheel::getInstance();
+
+            timer.scheduleAtFixedRate( this->members->writeCheckerTask.get(), this->members->initialDelayTime,
+                                       this->members->writeCheckTime, false );
+            timer.scheduleAtFixedRate( this->members->readCheckerTask.get(), this->members->initialDelayTime,
+                                       this->members->readCheckTime, false );
         }
     }
 }
@@ -476,19 +541,49 @@ void InactivityMonitor::startMonitorThreads() {
 ////////////////////////////////////////////////////////////////////////////////
 void InactivityMonitor::stopMonitorThreads() {
 
+    Pointer<ReadChecker> readChecker;
+    Pointer<WriteChecker> writeChecker;
+    Pointer<PooledTaskRunner> asyncTasks;
+
     synchronized( &this->members->monitor ) {
 
         if( this->members->monitorStarted.compareAndSet( true, false ) ) {
+            readChecker = this->members->readCheckerTask;
+            writeChecker = this->members->writeCheckerTask;
+            asyncTasks = this->members->asyncTasks;
+        }
+    }
 
-            this->members->readCheckerTask->cancel();
-            this->members->writeCheckerTask->cancel();
+    // The checks only signal the task runner so canceling them never waits for long,
+    // the runner's shutdown waits for an iteration running on the pool unless it is
+    // called from that iteration.
+    if( readChecker != NULL ) {
+        TimerWheel& timer = TimerWheel::getInstance();
+        timer.cancel( readChecker.get() );
+        timer.cancel( writeChecker.get() );
+    }
 
-            this->members->readCheckTimer.purge();
-            this->members->readCheckTimer.cancel();
-            this->members->writeCheckTimer.purge();
-            this->members->writeCheckTimer.cancel();
+    if( asyncTasks != NULL ) {
+        asyncTasks->shutdown();
+    }
+}
 
-            this->members->asyncTasks->shutdown();
-        }
+////////////////////////////////////////////////////////////////////////////////
+void InactivityMonitor::initialize() {
+
+    Pointer<ThreadPoolExecutor> executor( new ThreadPoolExecutor(
+        ASYNC_TASKS_POOL_SIZE, ASYNC_TASKS_POOL_SIZE, 30, TimeUnit::SECONDS, new LinkedBlockingQueue<Runnable*>() ) );
+    executor->allowCoreThreadTimeout( true );
+
+    asyncTasksExecutor = executor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void InactivityMonitor::shutdown() {
+
+    if( asyncTasksExecutor != NULL ) {
+        asyncTasksExecutor->shutdown();
+        asyncTasksExecutor->awaitTermination( 5, TimeUnit::SECONDS );
+        asyncTasksExecutor.reset( NULL );
     }
 }
@@ -27,8 +27,8 @@
 #include <activemq/wireformat/WireFormat.h>
 
 #include <decaf/lang/Pointer.h>
-#include <decaf/util/Timer.h>
 #include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/ExecutorService.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 
 namespace activemq {
@@ -49,6 +49,9 @@ namespace inactivity {
         // Internal Class used to house the data structures for this object
         InactivityMonitorData* members;
 
+        // The pool that runs the keep alive writes and failure notifications of every monitor.
+        static Pointer<decaf::util::concurrent::ExecutorService> asyncTasksExecutor;
+
         friend class ReadChecker;
         friend class AsyncSignalReadErrorkTask;
         friend class WriteChecker;
@@ -98,21 +101,37 @@ namespace inactivity {
 
         void setInitialDelayTime( long long value ) const;
 
+    public:
+
+        /**
+         * Creates the thread pool shared by every InactivityMonitor for the work its
+         * checks signal, called from the library initialization code.  The pool's
+         * threads are only created while there is work for them.
+         */
+        static void initialize();
+
+        /**
+         * Stops the shared thread pool, called from the library shutdown code.
+         */
+        static void shutdown();
+
     private:
 
         // Throttles read checking
         bool allowReadCheck( long long elapsed );
 
-        // Performs a Read Check on the current connection, called from a separate Thread.
+        // Performs a Read Check on the current connection, called from a TimerWheel worker Thread.
         void readCheck();
 
-        // Perform a Write Check on the current connection, called from a separate Thread.
+        // Perform a Write Check on the current connection, called from a TimerWheel worker Thread.
         void writeCheck();
 
-        // Stops all the monitoring Threads, cannot restart once called.
+        // Cancels the read and write checks and stops the task runner they signal.
         void stopMonitorThreads();
 
-        // Starts the monitoring Threads,
+        // Schedules the read and write checks with the shared TimerWheel and creates the
+        // task runner, on the shared pool, that handles the keep alive writes and failures
+        // they signal.
         void startMonitorThreads();
 
     };
@@ -31,7 +31,7 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-ReadChecker::ReadChecker( InactivityMonitor* parent ) : TimerTask(), parent( parent ), lastRunTime( 0 ) {
+ReadChecker::ReadChecker( InactivityMonitor* parent ) : Runnable(), parent( parent ), lastRunTime( 0 ) {
 
     if( this->parent == NULL ) {
         throw NullPointerException(
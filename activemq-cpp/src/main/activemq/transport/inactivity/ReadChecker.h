@@ -20,7 +20,7 @@
 
 #include <activemq/util/Config.h>
 
-#include <decaf/util/TimerTask.h>
+#include <decaf/lang/Runnable.h>
 
 namespace activemq {
 namespace transport {
@@ -34,7 +34,7 @@ namespace inactivity {
      *
      * @since 3.1
      */
-    class AMQCPP_API ReadChecker : public decaf::util::TimerTask {
+    class AMQCPP_API ReadChecker : public decaf::lang::Runnable {
     private:
 
         ReadChecker( const ReadChecker& );
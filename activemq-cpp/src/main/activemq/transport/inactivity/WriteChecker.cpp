@@ -31,7 +31,7 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-WriteChecker::WriteChecker( InactivityMonitor* parent ) : TimerTask(), parent( parent ), lastRunTime( 0 ) {
+WriteChecker::WriteChecker( InactivityMonitor* parent ) : Runnable(), parent( parent ), lastRunTime( 0 ) {
 
     if( this->parent == NULL ) {
         throw NullPointerException(
@@ -20,7 +20,7 @@
 
 #include <activemq/util/Config.h>
 
-#include <decaf/util/TimerTask.h>
+#include <decaf/lang/Runnable.h>
 
 namespace activemq {
 namespace transport {
@@ -35,7 +35,7 @@ namespace inactivity {
      *
      * @since 3.1.0
      */
-    class AMQCPP_API WriteChecker : public decaf::util::TimerTask {
+    class AMQCPP_API WriteChecker : public decaf::lang::Runnable {
     private:
 
         WriteChecker( const WriteChecker& );
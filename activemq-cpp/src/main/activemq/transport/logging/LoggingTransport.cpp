@@ -91,3 +91,21 @@ Pointer<Response> LoggingTransport::request( const Pointer<Command>& command, un
     AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
     AMQ_CATCHALL_THROW( IOException )
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransport::asyncRequest( const Pointer<Command>& command,
+                                     const Pointer<ResponseCallback>& responseCallback,
+                                     unsigned int timeout ) {
+
+    try {
+
+        std::cout << "SEND: " << command->toString() << std::endl;
+
+        // Delegate to the base class.
+        TransportFilter::asyncRequest( command, responseCallback, timeout );
+    }
+    AMQ_CATCH_RETHROW( IOException )
+    AMQ_CATCH_RETHROW( UnsupportedOperationException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
+    AMQ_CATCHALL_THROW( IOException )
+}
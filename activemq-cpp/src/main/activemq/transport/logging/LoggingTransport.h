@@ -64,6 +64,13 @@ namespace logging{
          */
         virtual Pointer<Response> request( const Pointer<Command>& command, unsigned int timeout );
 
+        /**
+         * {@inheritDoc}
+         */
+        virtual void asyncRequest( const Pointer<Command>& command,
+                                   const Pointer<ResponseCallback>& responseCallback,
+                                   unsigned int timeout );
+
     };
 
 }}}
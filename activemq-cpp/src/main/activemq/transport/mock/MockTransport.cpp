@@ -149,6 +149,21 @@ Pointer<Response> MockTransport::request( const Pointer<Command>& command,
     AMQ_CATCHALL_THROW( IOException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void MockTransport::asyncRequest( const Pointer<Command>& command,
+                                  const Pointer<ResponseCallback>& responseCallback,
+                                  unsigned int timeout AMQCPP_UNUSED ) {
+    try{
+        Pointer<Response> response = this->request( command );
+        responseCallback->onResponse( response );
+    }
+    AMQ_CATCH_RETHROW( IOException )
+    AMQ_CATCH_RETHROW( UnsupportedOperationException )
+    AMQ_CATCH_EXCEPTION_CONVERT( ActiveMQException, IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
+    AMQ_CATCHALL_THROW( IOException )
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void MockTransport::start() {
 
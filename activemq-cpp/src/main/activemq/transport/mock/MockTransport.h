@@ -163,6 +163,15 @@ namespace mock{
 
         virtual Pointer<Response> request( const Pointer<Command>& command, unsigned int timeout );
 
+        /**
+         * {@inheritDoc}
+         *
+         * The response is built and passed to the callback before this method returns.
+         */
+        virtual void asyncRequest( const Pointer<Command>& command,
+                                   const Pointer<ResponseCallback>& responseCallback,
+                                   unsigned int timeout );
+
         virtual void setWireFormat( const Pointer<wireformat::WireFormat>& wireFormat AMQCPP_UNUSED ) {}
 
         virtual void setTransportListener( TransportListener* listener ){
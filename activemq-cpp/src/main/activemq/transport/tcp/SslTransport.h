@@ -63,6 +63,16 @@ namespace tcp {
          */
         virtual void configureSocket( decaf::net::Socket* socket, decaf::util::Properties& properties );
 
+        /**
+         * {@inheritDoc}
+         *
+         * The SSL layer buffers decrypted data that the socket cannot report, so an
+         * SslTransport always reads with its own thread.
+         */
+        virtual bool isReactorSupported() const {
+            return false;
+        }
+
 
     };
 
@@ -0,0 +1,590 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TcpReactor.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/internal/AprPool.h>
+#include <decaf/internal/net/tcp/TcpSocket.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+#include <memory>
+
+#include <apr_version.h>
+#include <apr_poll.h>
+
+// A wakeable pollset lets a registration interrupt a blocked poll, on older APR versions
+// the reactor threads instead poll with a short timeout to pick up new registrations.
+#if APR_MAJOR_VERSION > 1 || ( APR_MAJOR_VERSION == 1 && APR_MINOR_VERSION >= 4 )
+    #define AMQ_TCP_REACTOR_WAKEABLE
+#endif
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::tcp;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::internal;
+using namespace decaf::internal::net::tcp;
+
+////////////////////////////////////////////////////////////////////////////////
+TcpReactor* TcpReactor::theOnlyInstance = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace tcp {
+
+    // A socket registered with one of the reactor threads, it stays allocated until the
+    // thread has removed it from its pollset since poll results refer to it.
+    class TcpReactorRegistration {
+    private:
+
+        TcpReactorRegistration( const TcpReactorRegistration& );
+        TcpReactorRegistration& operator= ( const TcpReactorRegistration& );
+
+    public:
+
+        TcpReactorChannel* channel;
+        apr_pollfd_t descriptor;
+        apr_status_t addResult;
+        bool pending;
+        bool added;
+        bool cancelled;
+
+        TcpReactorRegistration( TcpReactorChannel* channel, apr_socket_t* socket ) :
+            channel( channel ), descriptor(), addResult( APR_SUCCESS ),
+            pending( true ), added( false ), cancelled( false ) {
+
+            this->descriptor.p = NULL;
+            this->descriptor.desc_type = APR_POLL_SOCKET;
+            this->descriptor.reqevents = APR_POLLIN;
+            this->descriptor.rtnevents = 0;
+            this->descriptor.desc.s = socket;
+            this->descriptor.client_data = this;
+        }
+    };
+
+    // One reactor thread, only this thread adds and removes sockets from its pollset,
+    // other threads queue their changes, wake it up and wait for it to apply them.
+    class TcpReactorSelector : public Runnable {
+    private:
+
+        TcpReactorSelector( const TcpReactorSelector& );
+        TcpReactorSelector& operator= ( const TcpReactorSelector& );
+
+    public:
+
+        std::string name;
+        int capacity;
+
+        Mutex mutex;
+        AprPool pool;
+        apr_pollset_t* pollset;
+
+        StlMap<TcpReactorChannel*, TcpReactorRegistration*> registrations;
+        std::vector<TcpReactorRegistration*> pendingAdds;
+        std::vector<TcpReactorRegistration*> pendingRemoves;
+
+        TcpReactorRegistration* current;
+        Thread* thread;
+        bool shutDown;
+
+        TcpReactorSelector( const std::string& name, int capacity ) :
+            name( name ), capacity( capacity ), mutex(), pool(), pollset( NULL ), registrations(),
+            pendingAdds(), pendingRemoves(), current( NULL ), thread( NULL ), shutDown( false ) {
+
+            apr_uint32_t flags = 0;
+#ifdef AMQ_TCP_REACTOR_WAKEABLE
+            flags |= APR_POLLSET_WAKEABLE;
+#endif
+            apr_status_t result = apr_pollset_create(
+                &this->pollset, (apr_uint32_t)capacity, this->pool.getAprPool(), flags );
+
+            if( result != APR_SUCCESS ) {
+                throw IOException(
+                    __FILE__, __LINE__, "Failed to create the reactor pollset, status: %d", result );
+            }
+        }
+
+        virtual ~TcpReactorSelector() {
+
+            // The thread is gone, the pollset is destroyed along with the pool.
+            std::vector<TcpReactorRegistration*> remaining = this->registrations.values();
+            for( std::size_t i = 0; i < remaining.size(); ++i ) {
+                delete remaining[i];
+            }
+
+            for( std::size_t i = 0; i < this->pendingRemoves.size(); ++i ) {
+                delete this->pendingRemoves[i];
+            }
+        }
+
+        int size() {
+            int result = 0;
+            synchronized( &mutex ) {
+                result = this->registrations.size() + (int)this->pendingRemoves.size();
+            }
+            return result;
+        }
+
+        bool contains( TcpReactorChannel* channel ) {
+            bool result = false;
+            synchronized( &mutex ) {
+                result = this->registrations.containsKey( channel );
+            }
+            return result;
+        }
+
+        void start() {
+            this->thread = new Thread( this, this->name );
+            this->thread->start();
+        }
+
+        void stop() {
+
+            synchronized( &mutex ) {
+                this->shutDown = true;
+                this->wakeup();
+                mutex.notifyAll();
+            }
+
+            if( this->thread != NULL ) {
+                this->thread->join();
+                delete this->thread;
+                this->thread = NULL;
+            }
+        }
+
+        // Called with the mutex held.
+        void wakeup() {
+#ifdef AMQ_TCP_REACTOR_WAKEABLE
+            apr_pollset_wakeup( this->pollset );
+#endif
+        }
+
+        void add( TcpReactorChannel* channel, apr_socket_t* socket ) {
+
+            synchronized( &mutex ) {
+
+                if( this->shutDown ) {
+                    throw IllegalStateException( __FILE__, __LINE__, "TcpReactor has been shut down." );
+                }
+
+                if( this->registrations.size() + (int)this->pendingRemoves.size() >= this->capacity ) {
+                    throw IOException( __FILE__, __LINE__, "Reactor thread has no free capacity." );
+                }
+
+                TcpReactorRegistration* registration = new TcpReactorRegistration( channel, socket );
+                this->registrations.put( channel, registration );
+
+                if( Thread::currentThread() == this->thread ) {
+                    this->addToPollset( registration );
+                } else {
+                    this->pendingAdds.push_back( registration );
+                    this->wakeup();
+
+                    while( registration->pending && !this->shutDown ) {
+                        mutex.wait();
+                    }
+                }
+
+                if( !registration->added ) {
+
+                    apr_status_t result = registration->addResult;
+                    this->registrations.remove( channel );
+                    delete registration;
+
+                    throw IOException(
+                        __FILE__, __LINE__, "Failed to add the socket to the reactor pollset, status: %d", result );
+                }
+            }
+        }
+
+        bool remove( TcpReactorChannel* channel ) {
+
+            bool result = false;
+
+            synchronized( &mutex ) {
+
+                if( this->registrations.containsKey( channel ) ) {
+
+                    TcpReactorRegistration* registration = this->registrations.remove( channel );
+                    registration->cancelled = true;
+                    this->pendingRemoves.push_back( registration );
+                    result = true;
+
+                    if( Thread::currentThread() == this->thread ) {
+
+                        // Called from a channel on this thread, remove it now since the caller
+                        // is likely to close the socket as soon as this method returns.
+                        this->removeFromPollset( registration );
+
+                    } else {
+
+                        this->wakeup();
+
+                        while( !this->shutDown &&
+                               ( this->current == registration || this->isRemovePending( registration ) ) ) {
+                            mutex.wait();
+                        }
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        // Called with the mutex held.
+        bool isRemovePending( TcpReactorRegistration* registration ) const {
+            for( std::size_t i = 0; i < this->pendingRemoves.size(); ++i ) {
+                if( this->pendingRemoves[i] == registration ) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Called with the mutex held from the selector thread.
+        void addToPollset( TcpReactorRegistration* registration ) {
+            registration->addResult = apr_pollset_add( this->pollset, &registration->descriptor );
+            registration->added = registration->addResult == APR_SUCCESS;
+            registration->pending = false;
+        }
+
+        // Called with the mutex held from the selector thread.
+        void removeFromPollset( TcpReactorRegistration* registration ) {
+            if( registration->added ) {
+                apr_pollset_remove( this->pollset, &registration->descriptor );
+                registration->added = false;
+            }
+        }
+
+        // Called with the mutex held, applies the changes queued by other threads.  The
+        // removals go first so that a socket which has been closed and whose descriptor
+        // was reused for a new registration is not removed after the new one is added.
+        void processPending() {
+
+            if( this->pendingRemoves.empty() && this->pendingAdds.empty() ) {
+                return;
+            }
+
+            for( std::size_t i = 0; i < this->pendingRemoves.size(); ++i ) {
+                this->removeFromPollset( this->pendingRemoves[i] );
+                delete this->pendingRemoves[i];
+            }
+
+            this->pendingRemoves.clear();
+
+            for( std::size_t i = 0; i < this->pendingAdds.size(); ++i ) {
+                this->addToPollset( this->pendingAdds[i] );
+            }
+
+            this->pendingAdds.clear();
+
+            mutex.notifyAll();
+        }
+
+        void dispatch( TcpReactorRegistration* registration ) {
+
+            bool call = false;
+
+            synchronized( &mutex ) {
+                if( !registration->cancelled ) {
+                    this->current = registration;
+                    call = true;
+                }
+            }
+
+            if( !call ) {
+                return;
+            }
+
+            bool keep = false;
+
+            try{
+                keep = registration->channel->onReadable();
+            } catch(...) {
+            }
+
+            synchronized( &mutex ) {
+
+                this->current = NULL;
+
+                // A failed channel stops being polled but its owner still unregisters it.
+                if( !keep && !registration->cancelled ) {
+                    this->removeFromPollset( registration );
+                }
+
+                mutex.notifyAll();
+            }
+        }
+
+        virtual void run() {
+
+#ifdef AMQ_TCP_REACTOR_WAKEABLE
+            const apr_interval_time_t timeout = 1000000;
+#else
+            const apr_interval_time_t timeout = 10000;
+#endif
+
+            while( true ) {
+
+                bool done = false;
+
+                synchronized( &mutex ) {
+                    if( this->shutDown ) {
+                        done = true;
+                    } else {
+                        this->processPending();
+                    }
+                }
+
+                if( done ) {
+                    break;
+                }
+
+                apr_int32_t count = 0;
+                const apr_pollfd_t* results = NULL;
+
+                apr_status_t status = apr_pollset_poll( this->pollset, timeout, &count, &results );
+
+                if( status != APR_SUCCESS ) {
+
+                    if( !APR_STATUS_IS_EINTR( status ) && !APR_STATUS_IS_TIMEUP( status ) ) {
+                        // Nothing useful to do but back off rather than spin on the error.
+                        Thread::sleep( 10 );
+                    }
+
+                    continue;
+                }
+
+                for( apr_int32_t i = 0; i < count; ++i ) {
+                    this->dispatch( (TcpReactorRegistration*)results[i].client_data );
+                }
+            }
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+TcpReactor::TcpReactor( const std::string& name, int selectorCount, int selectorCapacity ) :
+    name( name ), maxSelectors( selectorCount ), selectorCapacity( selectorCapacity ), mutex(),
+    selectors(), shutDown( false ) {
+
+    if( name.empty() ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "TcpReactor name cannot be empty." );
+    }
+
+    if( selectorCount < 1 ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Selector count must be at least one." );
+    }
+
+    if( selectorCapacity < 1 ) {
+        throw IllegalArgumentException( __FILE__, __LINE__, "Selector capacity must be at least one." );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TcpReactor::~TcpReactor() {
+    try{
+
+        synchronized( &mutex ) {
+            this->shutDown = true;
+        }
+
+        for( std::size_t i = 0; i < this->selectors.size(); ++i ) {
+            this->selectors[i]->stop();
+            delete this->selectors[i];
+        }
+
+        this->selectors.clear();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactor::registerChannel( TcpSocket* socket, TcpReactorChannel* channel ) {
+
+    if( socket == NULL ) {
+        throw NullPointerException( __FILE__, __LINE__, "Socket to register cannot be NULL." );
+    }
+
+    if( channel == NULL ) {
+        throw NullPointerException( __FILE__, __LINE__, "Channel to register cannot be NULL." );
+    }
+
+    TcpReactorSelector* target = NULL;
+
+    synchronized( &mutex ) {
+
+        if( this->shutDown ) {
+            throw IllegalStateException( __FILE__, __LINE__, "TcpReactor has been shut down." );
+        }
+
+        int targetSize = 0;
+
+        for( std::size_t i = 0; i < this->selectors.size(); ++i ) {
+
+            if( this->selectors[i]->contains( channel ) ) {
+                throw IllegalStateException( __FILE__, __LINE__, "Channel is already registered." );
+            }
+
+            int size = this->selectors[i]->size();
+            if( target == NULL || size < targetSize ) {
+                target = this->selectors[i];
+                targetSize = size;
+            }
+        }
+
+        // Another thread is only started once every running one has a socket to poll.
+        if( ( target == NULL || targetSize > 0 ) && (int)this->selectors.size() < this->maxSelectors ) {
+
+            std::auto_ptr<TcpReactorSelector> selector( new TcpReactorSelector(
+                this->name + " Selector " + Integer::toString( (int)this->selectors.size() + 1 ),
+                this->selectorCapacity ) );
+
+            selector->start();
+            this->selectors.push_back( selector.get() );
+
+            target = selector.release();
+            targetSize = 0;
+        }
+
+        if( targetSize >= this->selectorCapacity ) {
+            throw IOException(
+                __FILE__, __LINE__, "TcpReactor is already polling the maximum number of sockets." );
+        }
+    }
+
+    // The selector thread applies the registration, wait for it outside of the reactor
+    // lock since a channel on that thread may be unregistering itself at the same time.
+    target->add( channel, socket->getSocketHandle() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TcpReactor::unregisterChannel( TcpReactorChannel* channel ) {
+
+    if( channel == NULL ) {
+        return false;
+    }
+
+    TcpReactorSelector* owner = NULL;
+
+    synchronized( &mutex ) {
+        for( std::size_t i = 0; i < this->selectors.size(); ++i ) {
+            if( this->selectors[i]->contains( channel ) ) {
+                owner = this->selectors[i];
+                break;
+            }
+        }
+    }
+
+    // Wait for the selector outside of the reactor lock so that other channels can
+    // still be registered while this one's last read completes.
+    if( owner != NULL ) {
+        return owner->remove( channel );
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TcpReactor::isRegistered( TcpReactorChannel* channel ) const {
+
+    bool result = false;
+
+    synchronized( &mutex ) {
+        for( std::size_t i = 0; i < this->selectors.size() && !result; ++i ) {
+            result = this->selectors[i]->contains( channel );
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TcpReactor::getChannelCount() const {
+
+    int count = 0;
+
+    synchronized( &mutex ) {
+        for( std::size_t i = 0; i < this->selectors.size(); ++i ) {
+            count += this->selectors[i]->size();
+        }
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TcpReactor::getSelectorCount() const {
+
+    int count = 0;
+
+    synchronized( &mutex ) {
+        count = (int)this->selectors.size();
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TcpReactor& TcpReactor::getInstance() {
+
+    if( theOnlyInstance == NULL ) {
+        throw IllegalStateException( __FILE__, __LINE__, "Library is not initialized." );
+    }
+
+    return *theOnlyInstance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactor::initialize() {
+
+    // A few threads are enough to keep up with the sockets, each one handles a share of
+    // the registered connections.
+    int selectorCount = System::availableProcessors();
+    if( selectorCount > 4 ) {
+        selectorCount = 4;
+    } else if( selectorCount < 1 ) {
+        selectorCount = 1;
+    }
+
+    theOnlyInstance = new TcpReactor( "ActiveMQ Reactor", selectorCount );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactor::shutdown() {
+    delete theOnlyInstance;
+    theOnlyInstance = NULL;
+}
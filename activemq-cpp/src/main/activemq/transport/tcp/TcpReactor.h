@@ -0,0 +1,193 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_TCP_TCPREACTOR_H_
+#define _ACTIVEMQ_TRANSPORT_TCP_TCPREACTOR_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/transport/tcp/TcpReactorChannel.h>
+
+#include <decaf/util/StlMap.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <string>
+#include <vector>
+
+namespace decaf {
+namespace internal {
+namespace net {
+namespace tcp {
+    class TcpSocket;
+}}}}
+
+namespace activemq {
+namespace transport {
+namespace tcp {
+
+    class TcpReactorSelector;
+
+    /**
+     * Multiplexes reads from many TCP sockets onto a small, bounded number of threads.
+     *
+     * Each reactor thread owns an APR pollset, which is backed by epoll on Linux and by
+     * the best readiness API available on other platforms, and calls the TcpReactorChannel
+     * registered for a socket whenever that socket becomes readable.  New sockets are
+     * assigned to the thread that is currently polling the fewest sockets and stay with
+     * that thread until they are unregistered, so a channel is never called concurrently.
+     *
+     * A thread and its pollset are only created when a socket is registered and every
+     * existing thread already polls at least one socket, up to the configured number of
+     * threads, so a process that registers few sockets only pays for few threads.  The
+     * channels are called on these shared threads, so a channel must hand anything that
+     * may block off to another thread rather than stall the other sockets.  The library
+     * creates a single shared instance that is used by TcpTransport when the option
+     * transport.reactor=true is set, it can be accessed with the getInstance method.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API TcpReactor {
+    private:
+
+        std::string name;
+        int maxSelectors;
+        int selectorCapacity;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+        std::vector<TcpReactorSelector*> selectors;
+        decaf::util::StlMap<TcpReactorChannel*, TcpReactorSelector*> channels;
+
+        bool shutDown;
+
+        static TcpReactor* theOnlyInstance;
+
+    private:
+
+        TcpReactor( const TcpReactor& );
+        TcpReactor& operator= ( const TcpReactor& );
+
+    public:
+
+        /**
+         * Creates a new TcpReactor.
+         *
+         * @param name
+         *      The name given to the threads this reactor creates.
+         * @param selectorCount
+         *      The maximum number of threads that poll the registered sockets.
+         * @param selectorCapacity
+         *      The maximum number of sockets each thread polls.
+         *
+         * @throws IllegalArgumentException if the name is empty or any of the other
+         *         arguments is less than one.
+         */
+        TcpReactor( const std::string& name, int selectorCount = 2, int selectorCapacity = 1024 );
+
+        /**
+         * Stops the reactor's threads, any channels that are still registered are no
+         * longer called.
+         */
+        virtual ~TcpReactor();
+
+        /**
+         * Registers the given socket, from now on the channel's onReadable method is called
+         * whenever the socket has data to read.
+         *
+         * @param socket
+         *      The connected socket to poll, it must remain open until the channel has been
+         *      unregistered.
+         * @param channel
+         *      The channel that reads from the socket, cannot be NULL.
+         *
+         * @throws NullPointerException if the socket or channel is NULL.
+         * @throws IllegalStateException if the channel is already registered with this reactor
+         *         or the reactor has been shut down.
+         * @throws IOException if every reactor thread is already polling as many sockets as
+         *         it can, or if the socket could not be registered.
+         */
+        void registerChannel( decaf::internal::net::tcp::TcpSocket* socket, TcpReactorChannel* channel );
+
+        /**
+         * Unregisters the given channel.  If the channel is being called on one of the
+         * reactor's threads this method waits for that call to complete before returning,
+         * unless it is called from the channel itself, and it also waits for the socket to
+         * be removed from its pollset so that once it returns the caller is free to close
+         * the socket and destroy the channel.
+         *
+         * @param channel
+         *      The channel to unregister.
+         *
+         * @returns true if the channel was registered with this reactor.
+         */
+        bool unregisterChannel( TcpReactorChannel* channel );
+
+        /**
+         * @param channel
+         *      The channel to look for.
+         *
+         * @returns true if the given channel is registered with this reactor.
+         */
+        bool isRegistered( TcpReactorChannel* channel ) const;
+
+        /**
+         * @returns the number of channels currently registered with this reactor.
+         */
+        int getChannelCount() const;
+
+        /**
+         * @returns the number of threads that have been started to poll the registered sockets.
+         */
+        int getSelectorCount() const;
+
+        /**
+         * @returns the maximum number of threads that poll the registered sockets.
+         */
+        int getMaxSelectorCount() const {
+            return this->maxSelectors;
+        }
+
+        /**
+         * @returns the maximum number of sockets each reactor thread polls.
+         */
+        int getSelectorCapacity() const {
+            return this->selectorCapacity;
+        }
+
+    public:
+
+        /**
+         * Gets the TcpReactor shared by every connection in this process.
+         *
+         * @returns a reference to the shared TcpReactor.
+         */
+        static TcpReactor& getInstance();
+
+        /**
+         * Creates the shared TcpReactor, called from the library initialization code.
+         */
+        static void initialize();
+
+        /**
+         * Destroys the shared TcpReactor, called from the library shutdown code.
+         */
+        static void shutdown();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_TCP_TCPREACTOR_H_ */
@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_TCP_TCPREACTORCHANNEL_H_
+#define _ACTIVEMQ_TRANSPORT_TCP_TCPREACTORCHANNEL_H_
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace transport {
+namespace tcp {
+
+    /**
+     * Interface implemented by objects that register a socket with a TcpReactor in order
+     * to be told when data can be read from it without blocking.
+     *
+     * @since 3.5.0
+     */
+    class AMQCPP_API TcpReactorChannel {
+    public:
+
+        virtual ~TcpReactorChannel() {}
+
+        /**
+         * Called from one of the reactor's threads when the registered socket has data
+         * waiting to be read or has been closed by the remote peer.  A channel is only ever
+         * called from one reactor thread at a time, the method should read what is available
+         * without blocking and return quickly since the thread is shared with the other
+         * channels registered with the reactor.
+         *
+         * @returns false if the channel has failed and should no longer be polled.
+         */
+        virtual bool onReadable() = 0;
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_TCP_TCPREACTORCHANNEL_H_ */
@@ -19,12 +19,15 @@
 
 #include <activemq/transport/IOTransport.h>
 #include <activemq/transport/TransportFactory.h>
+#include <activemq/transport/tcp/TcpReactor.h>
 
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Boolean.h>
+#include <decaf/lang/Long.h>
 #include <decaf/net/SocketFactory.h>
+#include <decaf/internal/net/tcp/TcpSocket.h>
 
 #include <memory>
 
@@ -40,10 +43,12 @@ using namespace decaf::util;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
+using namespace decaf::internal::net::tcp;
 
 ////////////////////////////////////////////////////////////////////////////////
 TcpTransport::TcpTransport( const Pointer<Transport>& next ) :
-    TransportFilter(next), connectTimeout(0), closed(false), socket(), dataInputStream(), dataOutputStream() {
+    TransportFilter(next), TcpReactorChannel(), connectTimeout(0), closed(false), socket(), dataInputStream(),
+    dataOutputStream(), ioTransport(NULL), reactor(NULL), reactorSocket(NULL) {
 
 }
 
@@ -65,6 +70,13 @@ void TcpTransport::close() {
 
         this->closed = true;
 
+        // Stop the reactor reading before the socket goes away, this waits for any read
+        // that is in progress on one of its threads.
+        if( this->reactor != NULL ) {
+            this->reactor->unregisterChannel( this );
+            this->reactor = NULL;
+        }
+
         // Close the socket.
         if( socket.get() != NULL ) {
             socket->close();
@@ -72,19 +84,65 @@ void TcpTransport::close() {
 
         // Invoke the paren't close first.
         TransportFilter::close();
+        this->ioTransport = NULL;
     }
     AMQ_CATCH_RETHROW( IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
     AMQ_CATCHALL_THROW( IOException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransport::start() {
+
+    try {
+
+        TransportFilter::start();
+
+        if( this->reactor != NULL && this->ioTransport != NULL &&
+            !this->closed && !this->reactor->isRegistered( this ) ) {
+
+            this->reactor->registerChannel( this->reactorSocket, this );
+        }
+    }
+    AMQ_CATCH_RETHROW( IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
+    AMQ_CATCHALL_THROW( IOException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TcpTransport::onReadable() {
+
+    // Hold the IOTransport in case a listener closes this transport from the reactor thread.
+    Pointer<Transport> keepAlive( this->next );
+    IOTransport* transport = this->ioTransport;
+
+    if( keepAlive == NULL || transport == NULL || this->closed ) {
+        return false;
+    }
+
+    return transport->readAvailable();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void TcpTransport::connect( const decaf::net::URI& uri,
                             const decaf::util::Properties& properties ) {
 
     try {
 
-        socket.reset( this->createSocket() );
+        // The reactor frames OpenWire commands using their size prefix, any other wire
+        // format is read with a thread as usual.
+        bool useReactor = this->isReactorSupported() &&
+            Boolean::parseBoolean( properties.getProperty( "transport.reactor", "false" ) ) &&
+            properties.getProperty( "wireFormat", "openwire" ) == "openwire" &&
+            !Boolean::parseBoolean( properties.getProperty( "wireFormat.sizePrefixDisabled", "false" ) );
+
+        if( useReactor ) {
+            // The reactor polls the TCP socket implementation directly.
+            this->reactorSocket = new TcpSocket();
+            socket.reset( new Socket( this->reactorSocket ) );
+        } else {
+            socket.reset( this->createSocket() );
+        }
 
         // Set all Socket Options from the URI options.
         this->configureSocket( socket.get(), properties );
@@ -130,25 +188,57 @@ void TcpTransport::connect( const decaf::net::URI& uri,
             outputStream = new LoggingOutputStream( outputStream );
 
             // Now wrap with the Buffered streams, we own the source streams
-            inputStream = new BufferedInputStream( inputStream, inputBufferSize, true );
+            if( !useReactor ) {
+                inputStream = new BufferedInputStream( inputStream, inputBufferSize, true );
+            }
             outputStream = new BufferedOutputStream( outputStream, outputBufferSize, true );
 
         } else {
 
             // Wrap with the Buffered streams, we don't own the source streams
-            inputStream = new BufferedInputStream( inputStream, inputBufferSize );
+            if( !useReactor ) {
+                inputStream = new BufferedInputStream( inputStream, inputBufferSize );
+            }
             outputStream = new BufferedOutputStream( outputStream, outputBufferSize );
         }
 
+        // The reactor only knows if the socket has data, so when reading on the reactor
+        // the input isn't buffered, the IOTransport keeps any partial frame itself.
+        bool ownInputStream = !useReactor ||
+            properties.getProperty( "transport.tcpTracingEnabled", "false" ) == "true";
+
         // Now wrap the Buffered Streams with DataInput based streams.  We own
         // the Source streams, all the streams in the chain that we own are
         // destroyed when these are.
-        this->dataInputStream.reset( new DataInputStream( inputStream, true ) );
+        this->dataInputStream.reset( new DataInputStream( inputStream, ownInputStream ) );
         this->dataOutputStream.reset( new DataOutputStream( outputStream, true ) );
 
         // Give the IOTransport the streams.
         ioTransport->setInputStream( dataInputStream.get() );
         ioTransport->setOutputStream( dataOutputStream.get() );
+
+        // Configure batching of writes from concurrent senders.
+        ioTransport->setWriteCoalescing( Boolean::parseBoolean(
+            properties.getProperty( "transport.writeCoalescing", "false" ) ) );
+        ioTransport->setWriteCoalescingMaxDelay( Long::parseLong(
+            properties.getProperty( "transport.writeCoalescingMaxDelay", "0" ) ) );
+        ioTransport->setWriteCoalescingMaxBytes( Integer::parseInt(
+            properties.getProperty( "transport.writeCoalescingMaxBytes",
+                                    Integer::toString( outputBufferSize ) ) ) );
+
+        // Configure the optional dedicated writer thread.
+        ioTransport->setAsyncWriterQueueSize( Integer::parseInt(
+            properties.getProperty( "transport.asyncWriterQueueSize", "1000" ) ) );
+        ioTransport->setAsyncWriter( Boolean::parseBoolean(
+            properties.getProperty( "transport.asyncWriter", "false" ) ) );
+
+        // Reads happen on the shared reactor once this transport is started.
+        ioTransport->setNonBlockingRead( useReactor );
+        this->ioTransport = ioTransport;
+
+        if( useReactor ) {
+            this->reactor = &TcpReactor::getInstance();
+        }
     }
     AMQ_CATCH_RETHROW( ActiveMQException )
     AMQ_CATCH_EXCEPTION_CONVERT( Exception, ActiveMQException )
@@ -22,6 +22,7 @@
 #include <activemq/io/LoggingOutputStream.h>
 #include <activemq/util/Config.h>
 #include <activemq/transport/TransportFilter.h>
+#include <activemq/transport/tcp/TcpReactorChannel.h>
 #include <decaf/net/Socket.h>
 #include <decaf/net/URI.h>
 #include <decaf/util/Properties.h>
@@ -32,19 +33,40 @@
 #include <decaf/io/DataOutputStream.h>
 #include <memory>
 
+namespace decaf {
+namespace internal {
+namespace net {
+namespace tcp {
+    class TcpSocket;
+}}}}
+
 namespace activemq{
 namespace transport{
+
+    class IOTransport;
+
 namespace tcp{
 
     using decaf::lang::Pointer;
 
+    class TcpReactor;
+
     /**
      * Implements a TCP/IP based transport filter, this transport
      * is meant to wrap an instance of an IOTransport.  The lower
      * level transport should take care of managing stream reads
      * and writes.
+     *
+     * When the option transport.reactor=true is set the IOTransport does
+     * not start a reader thread, instead the socket is registered with the
+     * shared TcpReactor whose threads read from it whenever data arrives.
+     * This lets a process hold many connections without a thread for each
+     * of them, but the transport listeners are then called on the reactor
+     * threads and must not block waiting for another command from the broker,
+     * which is why the Sessions of such a connection always deliver messages
+     * to their consumers from their own threads.
      */
-    class AMQCPP_API TcpTransport : public TransportFilter {
+    class AMQCPP_API TcpTransport : public TransportFilter, public TcpReactorChannel {
     private:
 
         /**
@@ -72,6 +94,22 @@ namespace tcp{
          */
         std::auto_ptr<decaf::io::DataOutputStream> dataOutputStream;
 
+        /**
+         * The IOTransport this transport feeds when reading on the reactor.
+         */
+        IOTransport* ioTransport;
+
+        /**
+         * The reactor that reads from the socket, NULL when the IOTransport
+         * reads with its own thread.
+         */
+        TcpReactor* reactor;
+
+        /**
+         * The socket implementation polled by the reactor, owned by the socket.
+         */
+        decaf::internal::net::tcp::TcpSocket* reactorSocket;
+
     private:
 
         TcpTransport( const TcpTransport& );
@@ -102,8 +140,17 @@ namespace tcp{
          */
         void connect( const decaf::net::URI& uri, const decaf::util::Properties& properties );
 
+        /**
+         * @returns true if the socket is read by the shared TcpReactor.
+         */
+        bool isUsingReactor() const {
+            return this->reactor != NULL;
+        }
+
     public:  // Transport Methods
 
+        virtual void start();
+
         virtual void close();
 
         virtual bool isFaultTolerant() const {
@@ -122,8 +169,23 @@ namespace tcp{
             return this->closed;
         }
 
+    public:  // TcpReactorChannel Methods
+
+        virtual bool onReadable();
+
     protected:
 
+        /**
+         * Indicates if this transport's socket can be read by the shared TcpReactor, the
+         * reactor polls the OS level socket directly so transports that layer another
+         * protocol over the raw socket should return false.
+         *
+         * @returns true if the transport.reactor option can be honored.
+         */
+        virtual bool isReactorSupported() const {
+            return true;
+        }
+
         /**
          * Create an unconnected Socket instance to be used by the transport to communicate
          * with the broker.
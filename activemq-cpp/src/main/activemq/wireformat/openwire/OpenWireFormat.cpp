@@ -22,12 +22,23 @@
 #include <decaf/lang/Long.h>
 #include <decaf/util/UUID.h>
 #include <decaf/lang/Math.h>
-#include <decaf/io/ByteArrayOutputStream.h>
 #include <activemq/wireformat/openwire/OpenWireFormatNegotiator.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
 #include <activemq/wireformat/MarshalAware.h>
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/commands/DataStructure.h>
+#include <activemq/commands/ActiveMQDestination.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTopic.h>
+#include <activemq/commands/ActiveMQTempQueue.h>
+#include <activemq/commands/ActiveMQTempTopic.h>
+#include <activemq/commands/BrokerId.h>
+#include <activemq/commands/ConnectionId.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/LocalTransactionId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/SessionId.h>
+#include <activemq/commands/XATransactionId.h>
 #include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/generated/MarshallerFactory.h>
 #include <activemq/exceptions/ActiveMQException.h>
@@ -51,6 +62,122 @@ using namespace decaf::lang::exceptions;
 const unsigned char OpenWireFormat::NULL_TYPE = 0;
 const int OpenWireFormat::DEFAULT_VERSION = 1;
 const int OpenWireFormat::MAX_SUPPORTED_VERSION = 6;
+const short OpenWireFormat::MARSHAL_CACHE_SIZE = 16383;
+const short OpenWireFormat::MARSHAL_CACHE_FREE_SPACE = 100;
+const int OpenWireFormat::MAX_LOOSE_BUFFER_CAPACITY = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    template<typename T>
+    int compareValues( const T& left, const T& right ) {
+        if( left < right ) {
+            return -1;
+        } else if( right < left ) {
+            return 1;
+        }
+        return 0;
+    }
+
+    bool isCacheableType( unsigned char type ) {
+
+        switch( type ) {
+            case ActiveMQQueue::ID_ACTIVEMQQUEUE:
+            case ActiveMQTopic::ID_ACTIVEMQTOPIC:
+            case ActiveMQTempQueue::ID_ACTIVEMQTEMPQUEUE:
+            case ActiveMQTempTopic::ID_ACTIVEMQTEMPTOPIC:
+            case BrokerId::ID_BROKERID:
+            case ConnectionId::ID_CONNECTIONID:
+            case SessionId::ID_SESSIONID:
+            case ProducerId::ID_PRODUCERID:
+            case ConsumerId::ID_CONSUMERID:
+            case LocalTransactionId::ID_LOCALTRANSACTIONID:
+            case XATransactionId::ID_XATRANSACTIONID:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    int compareCacheValues( const DataStructure* left, const DataStructure* right ) {
+
+        int result = compareValues( left->getDataStructureType(), right->getDataStructureType() );
+        if( result != 0 ) {
+            return result;
+        }
+
+        switch( left->getDataStructureType() ) {
+            case ActiveMQQueue::ID_ACTIVEMQQUEUE:
+            case ActiveMQTopic::ID_ACTIVEMQTOPIC:
+            case ActiveMQTempQueue::ID_ACTIVEMQTEMPQUEUE:
+            case ActiveMQTempTopic::ID_ACTIVEMQTEMPTOPIC: {
+                return dynamic_cast<const ActiveMQDestination*>( left )->getPhysicalName().compare(
+                       dynamic_cast<const ActiveMQDestination*>( right )->getPhysicalName() );
+            }
+            case BrokerId::ID_BROKERID: {
+                return dynamic_cast<const BrokerId*>( left )->getValue().compare(
+                       dynamic_cast<const BrokerId*>( right )->getValue() );
+            }
+            case ConnectionId::ID_CONNECTIONID: {
+                return dynamic_cast<const ConnectionId*>( left )->getValue().compare(
+                       dynamic_cast<const ConnectionId*>( right )->getValue() );
+            }
+            case SessionId::ID_SESSIONID: {
+                const SessionId* lhs = dynamic_cast<const SessionId*>( left );
+                const SessionId* rhs = dynamic_cast<const SessionId*>( right );
+                result = compareValues( lhs->getValue(), rhs->getValue() );
+                return result != 0 ? result : lhs->getConnectionId().compare( rhs->getConnectionId() );
+            }
+            case ProducerId::ID_PRODUCERID: {
+                const ProducerId* lhs = dynamic_cast<const ProducerId*>( left );
+                const ProducerId* rhs = dynamic_cast<const ProducerId*>( right );
+                result = compareValues( lhs->getValue(), rhs->getValue() );
+                if( result == 0 ) {
+                    result = compareValues( lhs->getSessionId(), rhs->getSessionId() );
+                }
+                return result != 0 ? result : lhs->getConnectionId().compare( rhs->getConnectionId() );
+            }
+            case ConsumerId::ID_CONSUMERID: {
+                const ConsumerId* lhs = dynamic_cast<const ConsumerId*>( left );
+                const ConsumerId* rhs = dynamic_cast<const ConsumerId*>( right );
+                result = compareValues( lhs->getValue(), rhs->getValue() );
+                if( result == 0 ) {
+                    result = compareValues( lhs->getSessionId(), rhs->getSessionId() );
+                }
+                return result != 0 ? result : lhs->getConnectionId().compare( rhs->getConnectionId() );
+            }
+            case LocalTransactionId::ID_LOCALTRANSACTIONID: {
+                const LocalTransactionId* lhs = dynamic_cast<const LocalTransactionId*>( left );
+                const LocalTransactionId* rhs = dynamic_cast<const LocalTransactionId*>( right );
+                result = compareValues( lhs->getValue(), rhs->getValue() );
+                if( result == 0 ) {
+                    result = compareValues( lhs->getConnectionId() != NULL, rhs->getConnectionId() != NULL );
+                }
+                if( result == 0 && lhs->getConnectionId() != NULL ) {
+                    result = lhs->getConnectionId()->getValue().compare( rhs->getConnectionId()->getValue() );
+                }
+                return result;
+            }
+            case XATransactionId::ID_XATRANSACTIONID: {
+                const XATransactionId* lhs = dynamic_cast<const XATransactionId*>( left );
+                const XATransactionId* rhs = dynamic_cast<const XATransactionId*>( right );
+                result = compareValues( lhs->getFormatId(), rhs->getFormatId() );
+                if( result == 0 ) {
+                    result = compareValues( lhs->getGlobalTransactionId(), rhs->getGlobalTransactionId() );
+                }
+                return result != 0 ? result : compareValues( lhs->getBranchQualifier(), rhs->getBranchQualifier() );
+            }
+            default:
+                return 0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool OpenWireFormat::CacheKeyComparator::operator()( const DataStructure* left,
+                                                     const DataStructure* right ) const {
+    return compareCacheValues( left, right ) < 0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 OpenWireFormat::OpenWireFormat( const decaf::util::Properties& properties ) :
@@ -67,7 +194,15 @@ OpenWireFormat::OpenWireFormat( const decaf::util::Properties& properties ) :
     tightEncodingEnabled(false),
     sizePrefixDisabled(false),
     maxInactivityDuration(30000),
-    maxInactivityDurationInitialDelay(10000) {
+    maxInactivityDurationInitialDelay(10000),
+    marshalCache(),
+    marshalCacheMap(),
+    nextMarshalCacheIndex(0),
+    nextMarshalCacheEvictionIndex(0),
+    unmarshalCache(),
+    unmarshalCacheFilled(),
+    looseBuffer(),
+    looseBufferOut( &looseBuffer ) {
 
     // initialize the universal marshalers, don't need to reset them again
     // after this so its safe to do this here.
@@ -163,6 +298,10 @@ void OpenWireFormat::marshal( const Pointer<commands::Command>& command,
 
         int size = 1;
 
+        if( cacheEnabled ) {
+            runMarshalCacheEvictionSweep();
+        }
+
         if( command != NULL ) {
 
             DataStructure* dataStructure =
@@ -194,29 +333,19 @@ void OpenWireFormat::marshal( const Pointer<commands::Command>& command,
 
             } else {
                 DataOutputStream* looseOut = dataOut;
-                ByteArrayOutputStream* baos = NULL;
 
                 if( !sizePrefixDisabled ) {
-                    baos = new ByteArrayOutputStream();
-                    looseOut = new DataOutputStream( baos );
+                    looseBuffer.reset();
+                    looseOut = &looseBufferOut;
                 }
 
                 looseOut->writeByte( type );
                 dsm->looseMarshal( this, dataStructure, looseOut );
 
                 if( !sizePrefixDisabled ) {
-                    looseOut->close();
-                    dataOut->writeInt( (int)baos->size() );
-
-                    if( baos->size() > 0 ) {
-                        std::pair<unsigned char*, int> array = baos->toByteArray();
-                        dataOut->write( array.first, array.second );
-                        delete [] array.first;
-                    }
-
-                    // Delete allocated resource
-                    delete baos;
-                    delete looseOut;
+                    dataOut->writeInt( (int)looseBuffer.size() );
+                    looseBuffer.writeTo( dataOut );
+                    looseBuffer.resetAndTrim( MAX_LOOSE_BUFFER_CAPACITY );
                 }
             }
         } else {
@@ -550,8 +679,134 @@ void OpenWireFormat::renegotiateWireFormat( const WireFormatInfo& info ) {
     this->sizePrefixDisabled = info.isSizePrefixDisabled() &&
                                preferedWireFormatInfo->isSizePrefixDisabled();
     this->cacheSize = min( info.getCacheSize(), preferedWireFormatInfo->getCacheSize() );
+    this->clearCaches();
     this->maxInactivityDuration = min( info.getMaxInactivityDuration(),
                                        preferedWireFormatInfo->getMaxInactivityDuration() );
     this->maxInactivityDurationInitialDelay = min( info.getMaxInactivityDurationInitalDelay(),
                                                    preferedWireFormatInfo->getMaxInactivityDurationInitalDelay() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+int OpenWireFormat::getMarshalCacheCapacity() const {
+    return Math::max( 0, Math::min( this->cacheSize, (int)MARSHAL_CACHE_SIZE ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+short OpenWireFormat::getMarshalCacheIndex( const DataStructure* object ) const {
+
+    if( object == NULL || !isCacheableType( object->getDataStructureType() ) ) {
+        return -1;
+    }
+
+    MarshalCacheMap::const_iterator iter = this->marshalCacheMap.find( object );
+    if( iter == this->marshalCacheMap.end() ) {
+        return -1;
+    }
+
+    return iter->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+short OpenWireFormat::addToMarshalCache( const DataStructure* object ) {
+
+    int capacity = getMarshalCacheCapacity();
+
+    if( object == NULL || capacity == 0 || !isCacheableType( object->getDataStructureType() ) ) {
+        return -1;
+    }
+
+    if( this->marshalCache.size() != (std::size_t)capacity ) {
+        this->marshalCache.resize( capacity );
+    }
+
+    short index = this->nextMarshalCacheIndex;
+
+    // The slot is only still in use when this command alone has filled the
+    // cache, the value then goes on the wire uncached.
+    if( this->marshalCache[index] != NULL ) {
+        return -1;
+    }
+
+    Pointer<DataStructure> copy( object->cloneDataStructure() );
+    this->marshalCache[index] = copy;
+    this->marshalCacheMap.insert( std::make_pair( copy.get(), index ) );
+
+    if( ++this->nextMarshalCacheIndex >= capacity ) {
+        this->nextMarshalCacheIndex = 0;
+    }
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::runMarshalCacheEvictionSweep() {
+
+    int capacity = getMarshalCacheCapacity();
+    std::size_t limit = (std::size_t)( capacity - Math::min( capacity, (int)MARSHAL_CACHE_FREE_SPACE ) );
+
+    while( this->marshalCacheMap.size() > limit ) {
+
+        Pointer<DataStructure>& entry = this->marshalCache[this->nextMarshalCacheEvictionIndex];
+        if( entry != NULL ) {
+            this->marshalCacheMap.erase( entry.get() );
+            entry.reset( NULL );
+        }
+
+        if( ++this->nextMarshalCacheEvictionIndex >= capacity ) {
+            this->nextMarshalCacheEvictionIndex = 0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::setInUnmarshalCache( short index, const DataStructure* object ) {
+
+    // The peer had no room to cache this value.
+    if( index == -1 ) {
+        return;
+    }
+
+    if( index < 0 || index >= MARSHAL_CACHE_SIZE ) {
+        throw IOException(
+            __FILE__, __LINE__,
+            "OpenWireFormat::setInUnmarshalCache - Invalid cache index: %d", (int)index );
+    }
+
+    if( this->unmarshalCache.size() <= (std::size_t)index ) {
+        this->unmarshalCache.resize( index + 1 );
+        this->unmarshalCacheFilled.resize( index + 1, false );
+    }
+
+    this->unmarshalCache[index].reset( object != NULL ? object->cloneDataStructure() : NULL );
+    this->unmarshalCacheFilled[index] = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* OpenWireFormat::getFromUnmarshalCache( short index ) const {
+
+    if( index < 0 || this->unmarshalCache.size() <= (std::size_t)index ) {
+        throw IOException(
+            __FILE__, __LINE__,
+            "OpenWireFormat::getFromUnmarshalCache - Invalid cache index: %d", (int)index );
+    }
+
+    if( !this->unmarshalCacheFilled[index] ) {
+        throw IOException(
+            __FILE__, __LINE__,
+            "OpenWireFormat::getFromUnmarshalCache - Nothing cached at index: %d", (int)index );
+    }
+
+    const Pointer<DataStructure>& entry = this->unmarshalCache[index];
+    return entry != NULL ? entry->cloneDataStructure() : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::clearCaches() {
+
+    this->marshalCacheMap.clear();
+    this->marshalCache.clear();
+    this->unmarshalCache.clear();
+    this->unmarshalCacheFilled.clear();
+    this->nextMarshalCacheIndex = 0;
+    this->nextMarshalCacheEvictionIndex = 0;
+}
@@ -25,10 +25,14 @@
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/Properties.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/lang/exceptions/IllegalStateException.h>
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <memory>
+#include <vector>
+#include <map>
 
 namespace activemq{
 namespace wireformat{
@@ -52,8 +56,32 @@ namespace marshal {
         // Defines the maximum supported openwire version
         static const int MAX_SUPPORTED_VERSION;
 
+        // Largest number of entries a peer may place in the cache, matches the broker.
+        static const short MARSHAL_CACHE_SIZE;
+
+        // Number of free slots the marshal cache keeps open before each command.
+        static const short MARSHAL_CACHE_FREE_SPACE;
+
+        // Largest buffer the loose encoding keeps between commands, a bigger one used
+        // for a large command is released once it has been written.
+        static const int MAX_LOOSE_BUFFER_CAPACITY;
+
     private:
 
+        /**
+         * Orders cacheable DataStructures by type and then by the values that are
+         * written on the wire, two objects that compare equal marshal identically.
+         */
+        class CacheKeyComparator {
+        public:
+
+            bool operator()( const commands::DataStructure* left,
+                             const commands::DataStructure* right ) const;
+
+        };
+
+        typedef std::map< const commands::DataStructure*, short, CacheKeyComparator > MarshalCacheMap;
+
         // Configuration parameters
         decaf::util::Properties properties;
 
@@ -80,6 +108,23 @@ namespace marshal {
         long long maxInactivityDuration;
         long long maxInactivityDurationInitialDelay;
 
+        // Marshal Cache, copies of the cached values stored by index along with
+        // a map to find the index of a value that is about to be marshaled.
+        std::vector< Pointer<commands::DataStructure> > marshalCache;
+        MarshalCacheMap marshalCacheMap;
+        short nextMarshalCacheIndex;
+        short nextMarshalCacheEvictionIndex;
+
+        // Unmarshal Cache, indexed by the values assigned by the remote peer.  The peer
+        // may cache a NULL, so the slots it has actually filled are tracked apart.
+        std::vector< Pointer<commands::DataStructure> > unmarshalCache;
+        std::vector<bool> unmarshalCacheFilled;
+
+        // Reusable buffer for size prefixed loose encoding, a command has to be
+        // fully marshaled before its size can be written ahead of it.
+        decaf::io::ByteArrayOutputStream looseBuffer;
+        decaf::io::DataOutputStream looseBufferOut;
+
     public:
 
         /**
@@ -182,6 +227,57 @@ namespace marshal {
         void looseMarshalNestedObject( commands::DataStructure* o,
                                        decaf::io::DataOutputStream* dataOut );
 
+        /**
+         * Finds the index in the marshal cache of a value equal to the given
+         * DataStructure.
+         *
+         * @param object
+         *      The DataStructure whose cache index is to be found, can be NULL.
+         *
+         * @returns the cache index or -1 if the value is not in the cache.
+         */
+        short getMarshalCacheIndex( const commands::DataStructure* object ) const;
+
+        /**
+         * Stores a copy of the given DataStructure in the marshal cache so that
+         * later commands can refer to it by index.  Values that are not one of
+         * the cacheable identifier types or that don't fit in the cache are not
+         * stored and the caller must send the value in full with an index of -1.
+         *
+         * @param object
+         *      The DataStructure to add to the cache, can be NULL.
+         *
+         * @returns the index assigned to the value or -1 if it was not cached.
+         */
+        short addToMarshalCache( const commands::DataStructure* object );
+
+        /**
+         * Stores a copy of a DataStructure that was sent in full by the remote
+         * peer at the cache index it assigned, an index of -1 is ignored.
+         *
+         * @param index
+         *      The cache index that was read along with the value.
+         * @param object
+         *      The DataStructure that was unmarshaled, can be NULL.
+         *
+         * @throws IOException if the index is out of the supported range.
+         */
+        void setInUnmarshalCache( short index, const commands::DataStructure* object );
+
+        /**
+         * Returns a new copy of the value the remote peer previously stored in
+         * the unmarshal cache at the given index, the caller owns the result.
+         *
+         * @param index
+         *      The cache index that was read from the stream.
+         *
+         * @returns a newly allocated DataStructure or NULL if a NULL was cached.
+         *
+         * @throws IOException if the index is out of range or the peer never stored
+         *         a value at it.
+         */
+        commands::DataStructure* getFromUnmarshalCache( short index ) const;
+
         /**
          * Called to re-negotiate the settings for the WireFormatInfo, these
          * determine how the client and broker communicate.
@@ -284,6 +380,7 @@ namespace marshal {
          */
         void setCacheEnabled( bool cacheEnabled ) {
             this->cacheEnabled = cacheEnabled;
+            this->clearCaches();
         }
 
         /**
@@ -300,6 +397,7 @@ namespace marshal {
          */
         void setCacheSize( int value ) {
             this->cacheSize = value;
+            this->clearCaches();
         }
 
         /**
@@ -390,6 +488,24 @@ namespace marshal {
          */
         void destroyMarshalers();
 
+        /**
+         * Empties both the marshal and unmarshal caches, called whenever the
+         * cache settings change so that both peers start from the same state.
+         */
+        void clearCaches();
+
+        /**
+         * Evicts the eldest entries from the marshal cache until there is at
+         * least MARSHAL_CACHE_FREE_SPACE room available for a new command.
+         * Entries are never evicted while a command is being marshaled.
+         */
+        void runMarshalCacheEvictionSweep();
+
+        /**
+         * @returns the number of entries this side may store in the marshal cache.
+         */
+        int getMarshalCacheCapacity() const;
+
     };
 
 }}}
@@ -52,7 +52,7 @@ Pointer<WireFormat> OpenWireFormatFactory::createWireFormat(
                                     "true" ) ) );
         info->setCacheEnabled( Boolean::parseBoolean(
             properties.getProperty( "wireFormat.cacheEnabled",
-                                    "false" ) ) );
+                                    "true" ) ) );
         info->setCacheSize( Integer::parseInt(
             properties.getProperty( "wireFormat.cacheSize",
                                     "1024" ) ) );
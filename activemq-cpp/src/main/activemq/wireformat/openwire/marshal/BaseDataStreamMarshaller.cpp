@@ -52,6 +52,20 @@ commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalCachedObject(
     utils::BooleanStream* bs ) {
 
     try{
+
+        if( wireFormat->isCacheEnabled() ) {
+
+            if( bs->readBoolean() ) {
+                short index = dataIn->readShort();
+                DataStructure* data = wireFormat->tightUnmarshalNestedObject( dataIn, bs );
+                wireFormat->setInUnmarshalCache( index, data );
+                return data;
+            } else {
+                short index = dataIn->readShort();
+                return wireFormat->getFromUnmarshalCache( index );
+            }
+        }
+
         return wireFormat->tightUnmarshalNestedObject( dataIn, bs );
     }
     AMQ_CATCH_RETHROW( IOException )
@@ -66,6 +80,21 @@ int BaseDataStreamMarshaller::tightMarshalCachedObject1(
     utils::BooleanStream* bs ) {
 
     try{
+
+        if( wireFormat->isCacheEnabled() ) {
+
+            short index = wireFormat->getMarshalCacheIndex( data );
+            bs->writeBoolean( index == -1 );
+
+            if( index == -1 ) {
+                int rc = wireFormat->tightMarshalNestedObject1( data, bs );
+                wireFormat->addToMarshalCache( data );
+                return 2 + rc;
+            } else {
+                return 2;
+            }
+        }
+
         return wireFormat->tightMarshalNestedObject1( data, bs );
     }
     AMQ_CATCH_RETHROW( IOException )
@@ -81,6 +110,23 @@ void BaseDataStreamMarshaller::tightMarshalCachedObject2(
     utils::BooleanStream* bs ) {
 
     try{
+
+        if( wireFormat->isCacheEnabled() ) {
+
+            // The index was assigned in the first pass, the cache is never swept
+            // while a command is being marshaled so the lookup here finds it again.
+            short index = wireFormat->getMarshalCacheIndex( data );
+
+            if( bs->readBoolean() ) {
+                dataOut->writeShort( index );
+                wireFormat->tightMarshalNestedObject2( data, dataOut, bs );
+            } else {
+                dataOut->writeShort( index );
+            }
+
+            return;
+        }
+
         wireFormat->tightMarshalNestedObject2( data, dataOut, bs );
     }
     AMQ_CATCH_RETHROW( IOException )
@@ -95,6 +141,23 @@ void BaseDataStreamMarshaller::looseMarshalCachedObject(
     decaf::io::DataOutputStream* dataOut ) {
 
     try{
+
+        if( wireFormat->isCacheEnabled() ) {
+
+            short index = wireFormat->getMarshalCacheIndex( data );
+            dataOut->writeBoolean( index == -1 );
+
+            if( index == -1 ) {
+                index = wireFormat->addToMarshalCache( data );
+                dataOut->writeShort( index );
+                wireFormat->looseMarshalNestedObject( data, dataOut );
+            } else {
+                dataOut->writeShort( index );
+            }
+
+            return;
+        }
+
         wireFormat->looseMarshalNestedObject( data, dataOut );
     }
     AMQ_CATCH_RETHROW( IOException )
@@ -108,6 +171,20 @@ commands::DataStructure* BaseDataStreamMarshaller::looseUnmarshalCachedObject(
     decaf::io::DataInputStream* dataIn ) {
 
     try{
+
+        if( wireFormat->isCacheEnabled() ) {
+
+            if( dataIn->readBoolean() ) {
+                short index = dataIn->readShort();
+                DataStructure* data = wireFormat->looseUnmarshalNestedObject( dataIn );
+                wireFormat->setInUnmarshalCache( index, data );
+                return data;
+            } else {
+                short index = dataIn->readShort();
+                return wireFormat->getFromUnmarshalCache( index );
+            }
+        }
+
         return wireFormat->looseUnmarshalNestedObject( dataIn );
     }
     AMQ_CATCH_RETHROW( IOException )
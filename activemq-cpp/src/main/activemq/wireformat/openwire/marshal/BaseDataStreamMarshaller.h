@@ -488,7 +488,7 @@ namespace marshal{
          */
         template<typename T>
         int tightMarshalObjectArray1( OpenWireFormat* wireFormat,
-                                      std::vector<T> objects,
+                                      const std::vector<T>& objects,
                                       utils::BooleanStream* bs ) {
 
             try{
@@ -525,7 +525,7 @@ namespace marshal{
          */
         template<typename T>
         void tightMarshalObjectArray2( OpenWireFormat* wireFormat,
-                                       std::vector<T> objects,
+                                       const std::vector<T>& objects,
                                        decaf::io::DataOutputStream* dataOut,
                                        utils::BooleanStream* bs ) {
 
@@ -556,7 +556,7 @@ namespace marshal{
          */
         template<typename T>
         void looseMarshalObjectArray( OpenWireFormat* wireFormat,
-                                      std::vector<T> objects,
+                                      const std::vector<T>& objects,
                                       decaf::io::DataOutputStream* dataOut ) {
 
             try {
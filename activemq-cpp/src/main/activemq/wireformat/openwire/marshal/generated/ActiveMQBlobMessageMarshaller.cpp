@@ -82,8 +82,8 @@ int ActiveMQBlobMessageMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Da
 
     try {
 
-        ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>( dataStructure );
+        const ActiveMQBlobMessage* info =
+            dynamic_cast<const ActiveMQBlobMessage*>( dataStructure );
 
         int rc = MessageMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -113,8 +113,8 @@ void ActiveMQBlobMessageMarshaller::tightMarshal2( OpenWireFormat* wireFormat, D
 
         MessageMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>( dataStructure );
+        const ActiveMQBlobMessage* info =
+            dynamic_cast<const ActiveMQBlobMessage*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -164,8 +164,8 @@ void ActiveMQBlobMessageMarshaller::looseMarshal( OpenWireFormat* wireFormat, Da
 
     try {
 
-        ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>( dataStructure );
+        const ActiveMQBlobMessage* info =
+            dynamic_cast<const ActiveMQBlobMessage*>( dataStructure );
         MessageMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
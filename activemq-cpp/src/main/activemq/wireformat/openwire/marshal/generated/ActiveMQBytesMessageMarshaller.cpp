@@ -74,10 +74,7 @@ int ActiveMQBytesMessageMarshaller::tightMarshal1( OpenWireFormat* wireFormat, D
 
     try {
 
-        ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>( dataStructure );
-
-        info->beforeMarshal( wireFormat );
+        dataStructure->beforeMarshal( wireFormat );
         int rc = MessageMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
         return rc + 0;
@@ -94,9 +91,7 @@ void ActiveMQBytesMessageMarshaller::tightMarshal2( OpenWireFormat* wireFormat,
 
         MessageMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>( dataStructure );
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
@@ -124,11 +119,9 @@ void ActiveMQBytesMessageMarshaller::looseMarshal( OpenWireFormat* wireFormat, D
 
     try {
 
-        ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>( dataStructure );
-        info->beforeMarshal( wireFormat );
+        dataStructure->beforeMarshal( wireFormat );
         MessageMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
@@ -61,8 +61,8 @@ int ActiveMQDestinationMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Da
 
     try {
 
-        ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>( dataStructure );
+        const ActiveMQDestination* info =
+            dynamic_cast<const ActiveMQDestination*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getPhysicalName(), bs );
@@ -81,8 +81,8 @@ void ActiveMQDestinationMarshaller::tightMarshal2( OpenWireFormat* wireFormat, D
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>( dataStructure );
+        const ActiveMQDestination* info =
+            dynamic_cast<const ActiveMQDestination*>( dataStructure );
         tightMarshalString2( info->getPhysicalName(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -110,8 +110,8 @@ void ActiveMQDestinationMarshaller::looseMarshal( OpenWireFormat* wireFormat, Da
 
     try {
 
-        ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>( dataStructure );
+        const ActiveMQDestination* info =
+            dynamic_cast<const ActiveMQDestination*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getPhysicalName(), dataOut );
     }
@@ -74,10 +74,7 @@ int ActiveMQMessageMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>( dataStructure );
-
-        info->beforeMarshal( wireFormat );
+        dataStructure->beforeMarshal( wireFormat );
         int rc = MessageMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
         return rc + 0;
@@ -94,9 +91,7 @@ void ActiveMQMessageMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         MessageMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>( dataStructure );
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
@@ -124,11 +119,9 @@ void ActiveMQMessageMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>( dataStructure );
-        info->beforeMarshal( wireFormat );
+        dataStructure->beforeMarshal( wireFormat );
         MessageMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
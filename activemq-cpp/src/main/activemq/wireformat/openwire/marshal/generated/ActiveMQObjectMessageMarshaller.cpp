@@ -74,10 +74,7 @@ int ActiveMQObjectMessageMarshaller::tightMarshal1( OpenWireFormat* wireFormat,
 
     try {
 
-        ActiveMQObjectMessage* info =
-            dynamic_cast<ActiveMQObjectMessage*>( dataStructure );
-
-        info->beforeMarshal( wireFormat );
+        dataStructure->beforeMarshal( wireFormat );
         int rc = MessageMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
         return rc + 0;
@@ -94,9 +91,7 @@ void ActiveMQObjectMessageMarshaller::tightMarshal2( OpenWireFormat* wireFormat,
 
         MessageMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ActiveMQObjectMessage* info =
-            dynamic_cast<ActiveMQObjectMessage*>( dataStructure );
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
@@ -124,11 +119,9 @@ void ActiveMQObjectMessageMarshaller::looseMarshal( OpenWireFormat* wireFormat,
 
     try {
 
-        ActiveMQObjectMessage* info =
-            dynamic_cast<ActiveMQObjectMessage*>( dataStructure );
-        info->beforeMarshal( wireFormat );
+        dataStructure->beforeMarshal( wireFormat );
         MessageMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
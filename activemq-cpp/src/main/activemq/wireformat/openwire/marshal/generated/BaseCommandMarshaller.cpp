@@ -62,8 +62,8 @@ int BaseCommandMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        BaseCommand* info =
-            dynamic_cast<BaseCommand*>( dataStructure );
+        const BaseCommand* info =
+            dynamic_cast<const BaseCommand*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         bs->writeBoolean( info->isResponseRequired() );
@@ -82,8 +82,8 @@ void BaseCommandMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruc
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        BaseCommand* info =
-            dynamic_cast<BaseCommand*>( dataStructure );
+        const BaseCommand* info =
+            dynamic_cast<const BaseCommand*>( dataStructure );
         dataOut->writeInt( info->getCommandId() );
         bs->readBoolean();
     }
@@ -113,8 +113,8 @@ void BaseCommandMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        BaseCommand* info =
-            dynamic_cast<BaseCommand*>( dataStructure );
+        const BaseCommand* info =
+            dynamic_cast<const BaseCommand*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->writeInt( info->getCommandId() );
         dataOut->writeBoolean( info->isResponseRequired() );
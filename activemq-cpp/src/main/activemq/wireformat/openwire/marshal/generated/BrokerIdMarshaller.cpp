@@ -71,8 +71,8 @@ int BrokerIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructure
 
     try {
 
-        BrokerId* info =
-            dynamic_cast<BrokerId*>( dataStructure );
+        const BrokerId* info =
+            dynamic_cast<const BrokerId*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getValue(), bs );
@@ -91,8 +91,8 @@ void BrokerIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStructur
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        BrokerId* info =
-            dynamic_cast<BrokerId*>( dataStructure );
+        const BrokerId* info =
+            dynamic_cast<const BrokerId*>( dataStructure );
         tightMarshalString2( info->getValue(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -120,8 +120,8 @@ void BrokerIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructure
 
     try {
 
-        BrokerId* info =
-            dynamic_cast<BrokerId*>( dataStructure );
+        const BrokerId* info =
+            dynamic_cast<const BrokerId*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getValue(), dataOut );
     }
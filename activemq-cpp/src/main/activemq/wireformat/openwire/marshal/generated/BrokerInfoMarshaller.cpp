@@ -106,8 +106,8 @@ int BrokerInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>( dataStructure );
+        const BrokerInfo* info =
+            dynamic_cast<const BrokerInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -150,8 +150,8 @@ void BrokerInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruct
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>( dataStructure );
+        const BrokerInfo* info =
+            dynamic_cast<const BrokerInfo*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -238,8 +238,8 @@ void BrokerInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>( dataStructure );
+        const BrokerInfo* info =
+            dynamic_cast<const BrokerInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -90,8 +90,8 @@ int ConnectionControlMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Data
 
     try {
 
-        ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>( dataStructure );
+        const ConnectionControl* info =
+            dynamic_cast<const ConnectionControl*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -130,8 +130,8 @@ void ConnectionControlMarshaller::tightMarshal2( OpenWireFormat* wireFormat, Dat
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>( dataStructure );
+        const ConnectionControl* info =
+            dynamic_cast<const ConnectionControl*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -200,8 +200,8 @@ void ConnectionControlMarshaller::looseMarshal( OpenWireFormat* wireFormat, Data
 
     try {
 
-        ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>( dataStructure );
+        const ConnectionControl* info =
+            dynamic_cast<const ConnectionControl*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -74,8 +74,8 @@ int ConnectionErrorMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        ConnectionError* info =
-            dynamic_cast<ConnectionError*>( dataStructure );
+        const ConnectionError* info =
+            dynamic_cast<const ConnectionError*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalBrokerError1( wireFormat, info->getException().get(), bs );
@@ -95,8 +95,8 @@ void ConnectionErrorMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ConnectionError* info =
-            dynamic_cast<ConnectionError*>( dataStructure );
+        const ConnectionError* info =
+            dynamic_cast<const ConnectionError*>( dataStructure );
         tightMarshalBrokerError2( wireFormat, info->getException().get(), dataOut, bs );
         tightMarshalNestedObject2( wireFormat, info->getConnectionId().get(), dataOut, bs );
     }
@@ -128,8 +128,8 @@ void ConnectionErrorMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        ConnectionError* info =
-            dynamic_cast<ConnectionError*>( dataStructure );
+        const ConnectionError* info =
+            dynamic_cast<const ConnectionError*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalBrokerError( wireFormat, info->getException().get(), dataOut );
         looseMarshalNestedObject( wireFormat, info->getConnectionId().get(), dataOut );
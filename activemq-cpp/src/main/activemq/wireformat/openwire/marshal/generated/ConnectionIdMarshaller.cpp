@@ -71,8 +71,8 @@ int ConnectionIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        ConnectionId* info =
-            dynamic_cast<ConnectionId*>( dataStructure );
+        const ConnectionId* info =
+            dynamic_cast<const ConnectionId*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getValue(), bs );
@@ -91,8 +91,8 @@ void ConnectionIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStru
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ConnectionId* info =
-            dynamic_cast<ConnectionId*>( dataStructure );
+        const ConnectionId* info =
+            dynamic_cast<const ConnectionId*>( dataStructure );
         tightMarshalString2( info->getValue(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -120,8 +120,8 @@ void ConnectionIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        ConnectionId* info =
-            dynamic_cast<ConnectionId*>( dataStructure );
+        const ConnectionId* info =
+            dynamic_cast<const ConnectionId*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getValue(), dataOut );
     }
@@ -103,8 +103,8 @@ int ConnectionInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>( dataStructure );
+        const ConnectionInfo* info =
+            dynamic_cast<const ConnectionInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -144,8 +144,8 @@ void ConnectionInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataSt
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>( dataStructure );
+        const ConnectionInfo* info =
+            dynamic_cast<const ConnectionInfo*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -226,8 +226,8 @@ void ConnectionInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>( dataStructure );
+        const ConnectionInfo* info =
+            dynamic_cast<const ConnectionInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -90,8 +90,8 @@ int ConsumerControlMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        ConsumerControl* info =
-            dynamic_cast<ConsumerControl*>( dataStructure );
+        const ConsumerControl* info =
+            dynamic_cast<const ConsumerControl*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -126,8 +126,8 @@ void ConsumerControlMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ConsumerControl* info =
-            dynamic_cast<ConsumerControl*>( dataStructure );
+        const ConsumerControl* info =
+            dynamic_cast<const ConsumerControl*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -191,8 +191,8 @@ void ConsumerControlMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        ConsumerControl* info =
-            dynamic_cast<ConsumerControl*>( dataStructure );
+        const ConsumerControl* info =
+            dynamic_cast<const ConsumerControl*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
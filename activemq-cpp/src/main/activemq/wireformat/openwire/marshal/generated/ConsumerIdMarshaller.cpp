@@ -73,8 +73,8 @@ int ConsumerIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        ConsumerId* info =
-            dynamic_cast<ConsumerId*>( dataStructure );
+        const ConsumerId* info =
+            dynamic_cast<const ConsumerId*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getConnectionId(), bs );
@@ -95,8 +95,8 @@ void ConsumerIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruct
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ConsumerId* info =
-            dynamic_cast<ConsumerId*>( dataStructure );
+        const ConsumerId* info =
+            dynamic_cast<const ConsumerId*>( dataStructure );
         tightMarshalString2( info->getConnectionId(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getSessionId(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getValue(), dataOut, bs );
@@ -128,8 +128,8 @@ void ConsumerIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        ConsumerId* info =
-            dynamic_cast<ConsumerId*>( dataStructure );
+        const ConsumerId* info =
+            dynamic_cast<const ConsumerId*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getConnectionId(), dataOut );
         looseMarshalLong( wireFormat, info->getSessionId(), dataOut );
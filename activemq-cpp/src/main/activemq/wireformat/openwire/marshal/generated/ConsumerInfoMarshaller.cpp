@@ -116,8 +116,8 @@ int ConsumerInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>( dataStructure );
+        const ConsumerInfo* info =
+            dynamic_cast<const ConsumerInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -155,8 +155,8 @@ void ConsumerInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStru
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>( dataStructure );
+        const ConsumerInfo* info =
+            dynamic_cast<const ConsumerInfo*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -251,8 +251,8 @@ void ConsumerInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>( dataStructure );
+        const ConsumerInfo* info =
+            dynamic_cast<const ConsumerInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
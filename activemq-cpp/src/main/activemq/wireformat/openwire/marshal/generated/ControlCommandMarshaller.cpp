@@ -71,8 +71,8 @@ int ControlCommandMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        ControlCommand* info =
-            dynamic_cast<ControlCommand*>( dataStructure );
+        const ControlCommand* info =
+            dynamic_cast<const ControlCommand*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getCommand(), bs );
@@ -91,8 +91,8 @@ void ControlCommandMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataSt
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ControlCommand* info =
-            dynamic_cast<ControlCommand*>( dataStructure );
+        const ControlCommand* info =
+            dynamic_cast<const ControlCommand*>( dataStructure );
         tightMarshalString2( info->getCommand(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -120,8 +120,8 @@ void ControlCommandMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        ControlCommand* info =
-            dynamic_cast<ControlCommand*>( dataStructure );
+        const ControlCommand* info =
+            dynamic_cast<const ControlCommand*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getCommand(), dataOut );
     }
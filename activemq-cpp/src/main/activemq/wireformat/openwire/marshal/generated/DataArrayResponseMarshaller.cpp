@@ -81,8 +81,8 @@ int DataArrayResponseMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Data
 
     try {
 
-        DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>( dataStructure );
+        const DataArrayResponse* info =
+            dynamic_cast<const DataArrayResponse*>( dataStructure );
 
         int rc = ResponseMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalObjectArray1( wireFormat, info->getData(), bs );
@@ -101,8 +101,8 @@ void DataArrayResponseMarshaller::tightMarshal2( OpenWireFormat* wireFormat, Dat
 
         ResponseMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>( dataStructure );
+        const DataArrayResponse* info =
+            dynamic_cast<const DataArrayResponse*>( dataStructure );
         tightMarshalObjectArray2( wireFormat, info->getData(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -140,8 +140,8 @@ void DataArrayResponseMarshaller::looseMarshal( OpenWireFormat* wireFormat, Data
 
     try {
 
-        DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>( dataStructure );
+        const DataArrayResponse* info =
+            dynamic_cast<const DataArrayResponse*>( dataStructure );
         ResponseMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalObjectArray( wireFormat, info->getData(), dataOut );
     }
@@ -72,8 +72,8 @@ int DataResponseMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        DataResponse* info =
-            dynamic_cast<DataResponse*>( dataStructure );
+        const DataResponse* info =
+            dynamic_cast<const DataResponse*>( dataStructure );
 
         int rc = ResponseMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalNestedObject1( wireFormat, info->getData().get(), bs );
@@ -92,8 +92,8 @@ void DataResponseMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStru
 
         ResponseMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        DataResponse* info =
-            dynamic_cast<DataResponse*>( dataStructure );
+        const DataResponse* info =
+            dynamic_cast<const DataResponse*>( dataStructure );
         tightMarshalNestedObject2( wireFormat, info->getData().get(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -122,8 +122,8 @@ void DataResponseMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        DataResponse* info =
-            dynamic_cast<DataResponse*>( dataStructure );
+        const DataResponse* info =
+            dynamic_cast<const DataResponse*>( dataStructure );
         ResponseMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalNestedObject( wireFormat, info->getData().get(), dataOut );
     }
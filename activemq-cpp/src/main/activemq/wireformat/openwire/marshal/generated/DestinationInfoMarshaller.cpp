@@ -87,8 +87,8 @@ int DestinationInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        DestinationInfo* info =
-            dynamic_cast<DestinationInfo*>( dataStructure );
+        const DestinationInfo* info =
+            dynamic_cast<const DestinationInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getConnectionId().get(), bs );
@@ -110,8 +110,8 @@ void DestinationInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        DestinationInfo* info =
-            dynamic_cast<DestinationInfo*>( dataStructure );
+        const DestinationInfo* info =
+            dynamic_cast<const DestinationInfo*>( dataStructure );
         tightMarshalCachedObject2( wireFormat, info->getConnectionId().get(), dataOut, bs );
         tightMarshalCachedObject2( wireFormat, info->getDestination().get(), dataOut, bs );
         dataOut->write( info->getOperationType() );
@@ -159,8 +159,8 @@ void DestinationInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        DestinationInfo* info =
-            dynamic_cast<DestinationInfo*>( dataStructure );
+        const DestinationInfo* info =
+            dynamic_cast<const DestinationInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalCachedObject( wireFormat, info->getConnectionId().get(), dataOut );
         looseMarshalCachedObject( wireFormat, info->getDestination().get(), dataOut );
@@ -72,8 +72,8 @@ int DiscoveryEventMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>( dataStructure );
+        const DiscoveryEvent* info =
+            dynamic_cast<const DiscoveryEvent*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getServiceName(), bs );
@@ -93,8 +93,8 @@ void DiscoveryEventMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataSt
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>( dataStructure );
+        const DiscoveryEvent* info =
+            dynamic_cast<const DiscoveryEvent*>( dataStructure );
         tightMarshalString2( info->getServiceName(), dataOut, bs );
         tightMarshalString2( info->getBrokerName(), dataOut, bs );
     }
@@ -124,8 +124,8 @@ void DiscoveryEventMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>( dataStructure );
+        const DiscoveryEvent* info =
+            dynamic_cast<const DiscoveryEvent*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getServiceName(), dataOut );
         looseMarshalString( info->getBrokerName(), dataOut );
@@ -72,8 +72,8 @@ int ExceptionResponseMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Data
 
     try {
 
-        ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>( dataStructure );
+        const ExceptionResponse* info =
+            dynamic_cast<const ExceptionResponse*>( dataStructure );
 
         int rc = ResponseMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalBrokerError1( wireFormat, info->getException().get(), bs );
@@ -92,8 +92,8 @@ void ExceptionResponseMarshaller::tightMarshal2( OpenWireFormat* wireFormat, Dat
 
         ResponseMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>( dataStructure );
+        const ExceptionResponse* info =
+            dynamic_cast<const ExceptionResponse*>( dataStructure );
         tightMarshalBrokerError2( wireFormat, info->getException().get(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -122,8 +122,8 @@ void ExceptionResponseMarshaller::looseMarshal( OpenWireFormat* wireFormat, Data
 
     try {
 
-        ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>( dataStructure );
+        const ExceptionResponse* info =
+            dynamic_cast<const ExceptionResponse*>( dataStructure );
         ResponseMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalBrokerError( wireFormat, info->getException().get(), dataOut );
     }
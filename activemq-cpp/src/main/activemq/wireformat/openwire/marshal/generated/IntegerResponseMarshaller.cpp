@@ -87,8 +87,8 @@ void IntegerResponseMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         ResponseMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        IntegerResponse* info =
-            dynamic_cast<IntegerResponse*>( dataStructure );
+        const IntegerResponse* info =
+            dynamic_cast<const IntegerResponse*>( dataStructure );
         dataOut->writeInt( info->getResult() );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -116,8 +116,8 @@ void IntegerResponseMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        IntegerResponse* info =
-            dynamic_cast<IntegerResponse*>( dataStructure );
+        const IntegerResponse* info =
+            dynamic_cast<const IntegerResponse*>( dataStructure );
         ResponseMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->writeInt( info->getResult() );
     }
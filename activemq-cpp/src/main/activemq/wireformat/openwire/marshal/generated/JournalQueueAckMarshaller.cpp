@@ -74,8 +74,8 @@ int JournalQueueAckMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>( dataStructure );
+        const JournalQueueAck* info =
+            dynamic_cast<const JournalQueueAck*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalNestedObject1( wireFormat, info->getDestination().get(), bs );
@@ -95,8 +95,8 @@ void JournalQueueAckMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>( dataStructure );
+        const JournalQueueAck* info =
+            dynamic_cast<const JournalQueueAck*>( dataStructure );
         tightMarshalNestedObject2( wireFormat, info->getDestination().get(), dataOut, bs );
         tightMarshalNestedObject2( wireFormat, info->getMessageAck().get(), dataOut, bs );
     }
@@ -128,8 +128,8 @@ void JournalQueueAckMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>( dataStructure );
+        const JournalQueueAck* info =
+            dynamic_cast<const JournalQueueAck*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalNestedObject( wireFormat, info->getDestination().get(), dataOut );
         looseMarshalNestedObject( wireFormat, info->getMessageAck().get(), dataOut );
@@ -79,8 +79,8 @@ int JournalTopicAckMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>( dataStructure );
+        const JournalTopicAck* info =
+            dynamic_cast<const JournalTopicAck*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalNestedObject1( wireFormat, info->getDestination().get(), bs );
@@ -104,8 +104,8 @@ void JournalTopicAckMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>( dataStructure );
+        const JournalTopicAck* info =
+            dynamic_cast<const JournalTopicAck*>( dataStructure );
         tightMarshalNestedObject2( wireFormat, info->getDestination().get(), dataOut, bs );
         tightMarshalNestedObject2( wireFormat, info->getMessageId().get(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getMessageSequenceId(), dataOut, bs );
@@ -146,8 +146,8 @@ void JournalTopicAckMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>( dataStructure );
+        const JournalTopicAck* info =
+            dynamic_cast<const JournalTopicAck*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalNestedObject( wireFormat, info->getDestination().get(), dataOut );
         looseMarshalNestedObject( wireFormat, info->getMessageId().get(), dataOut );
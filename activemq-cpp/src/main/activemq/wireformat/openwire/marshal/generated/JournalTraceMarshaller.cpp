@@ -71,8 +71,8 @@ int JournalTraceMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        JournalTrace* info =
-            dynamic_cast<JournalTrace*>( dataStructure );
+        const JournalTrace* info =
+            dynamic_cast<const JournalTrace*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getMessage(), bs );
@@ -91,8 +91,8 @@ void JournalTraceMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStru
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        JournalTrace* info =
-            dynamic_cast<JournalTrace*>( dataStructure );
+        const JournalTrace* info =
+            dynamic_cast<const JournalTrace*>( dataStructure );
         tightMarshalString2( info->getMessage(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -120,8 +120,8 @@ void JournalTraceMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        JournalTrace* info =
-            dynamic_cast<JournalTrace*>( dataStructure );
+        const JournalTrace* info =
+            dynamic_cast<const JournalTrace*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getMessage(), dataOut );
     }
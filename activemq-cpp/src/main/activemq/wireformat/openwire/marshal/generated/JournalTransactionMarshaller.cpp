@@ -74,8 +74,8 @@ int JournalTransactionMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Dat
 
     try {
 
-        JournalTransaction* info =
-            dynamic_cast<JournalTransaction*>( dataStructure );
+        const JournalTransaction* info =
+            dynamic_cast<const JournalTransaction*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalNestedObject1( wireFormat, info->getTransactionId().get(), bs );
@@ -95,8 +95,8 @@ void JournalTransactionMarshaller::tightMarshal2( OpenWireFormat* wireFormat, Da
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        JournalTransaction* info =
-            dynamic_cast<JournalTransaction*>( dataStructure );
+        const JournalTransaction* info =
+            dynamic_cast<const JournalTransaction*>( dataStructure );
         tightMarshalNestedObject2( wireFormat, info->getTransactionId().get(), dataOut, bs );
         dataOut->write( info->getType() );
         bs->readBoolean();
@@ -129,8 +129,8 @@ void JournalTransactionMarshaller::looseMarshal( OpenWireFormat* wireFormat, Dat
 
     try {
 
-        JournalTransaction* info =
-            dynamic_cast<JournalTransaction*>( dataStructure );
+        const JournalTransaction* info =
+            dynamic_cast<const JournalTransaction*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalNestedObject( wireFormat, info->getTransactionId().get(), dataOut );
         dataOut->write( info->getType() );
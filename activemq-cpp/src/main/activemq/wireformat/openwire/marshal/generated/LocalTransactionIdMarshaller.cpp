@@ -73,8 +73,8 @@ int LocalTransactionIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Dat
 
     try {
 
-        LocalTransactionId* info =
-            dynamic_cast<LocalTransactionId*>( dataStructure );
+        const LocalTransactionId* info =
+            dynamic_cast<const LocalTransactionId*>( dataStructure );
 
         int rc = TransactionIdMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalLong1( wireFormat, info->getValue(), bs );
@@ -94,8 +94,8 @@ void LocalTransactionIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, Da
 
         TransactionIdMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        LocalTransactionId* info =
-            dynamic_cast<LocalTransactionId*>( dataStructure );
+        const LocalTransactionId* info =
+            dynamic_cast<const LocalTransactionId*>( dataStructure );
         tightMarshalLong2( wireFormat, info->getValue(), dataOut, bs );
         tightMarshalCachedObject2( wireFormat, info->getConnectionId().get(), dataOut, bs );
     }
@@ -126,8 +126,8 @@ void LocalTransactionIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, Dat
 
     try {
 
-        LocalTransactionId* info =
-            dynamic_cast<LocalTransactionId*>( dataStructure );
+        const LocalTransactionId* info =
+            dynamic_cast<const LocalTransactionId*>( dataStructure );
         TransactionIdMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalLong( wireFormat, info->getValue(), dataOut );
         looseMarshalCachedObject( wireFormat, info->getConnectionId().get(), dataOut );
@@ -89,8 +89,8 @@ int MessageAckMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        MessageAck* info =
-            dynamic_cast<MessageAck*>( dataStructure );
+        const MessageAck* info =
+            dynamic_cast<const MessageAck*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -119,8 +119,8 @@ void MessageAckMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruct
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        MessageAck* info =
-            dynamic_cast<MessageAck*>( dataStructure );
+        const MessageAck* info =
+            dynamic_cast<const MessageAck*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -178,8 +178,8 @@ void MessageAckMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        MessageAck* info =
-            dynamic_cast<MessageAck*>( dataStructure );
+        const MessageAck* info =
+            dynamic_cast<const MessageAck*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -77,8 +77,8 @@ int MessageDispatchMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        MessageDispatch* info =
-            dynamic_cast<MessageDispatch*>( dataStructure );
+        const MessageDispatch* info =
+            dynamic_cast<const MessageDispatch*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getConsumerId().get(), bs );
@@ -99,8 +99,8 @@ void MessageDispatchMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        MessageDispatch* info =
-            dynamic_cast<MessageDispatch*>( dataStructure );
+        const MessageDispatch* info =
+            dynamic_cast<const MessageDispatch*>( dataStructure );
         tightMarshalCachedObject2( wireFormat, info->getConsumerId().get(), dataOut, bs );
         tightMarshalCachedObject2( wireFormat, info->getDestination().get(), dataOut, bs );
         tightMarshalNestedObject2( wireFormat, info->getMessage().get(), dataOut, bs );
@@ -137,8 +137,8 @@ void MessageDispatchMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        MessageDispatch* info =
-            dynamic_cast<MessageDispatch*>( dataStructure );
+        const MessageDispatch* info =
+            dynamic_cast<const MessageDispatch*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalCachedObject( wireFormat, info->getConsumerId().get(), dataOut );
         looseMarshalCachedObject( wireFormat, info->getDestination().get(), dataOut );
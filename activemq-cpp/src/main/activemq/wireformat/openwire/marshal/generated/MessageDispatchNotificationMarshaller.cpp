@@ -77,8 +77,8 @@ int MessageDispatchNotificationMarshaller::tightMarshal1( OpenWireFormat* wireFo
 
     try {
 
-        MessageDispatchNotification* info =
-            dynamic_cast<MessageDispatchNotification*>( dataStructure );
+        const MessageDispatchNotification* info =
+            dynamic_cast<const MessageDispatchNotification*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getConsumerId().get(), bs );
@@ -100,8 +100,8 @@ void MessageDispatchNotificationMarshaller::tightMarshal2( OpenWireFormat* wireF
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        MessageDispatchNotification* info =
-            dynamic_cast<MessageDispatchNotification*>( dataStructure );
+        const MessageDispatchNotification* info =
+            dynamic_cast<const MessageDispatchNotification*>( dataStructure );
         tightMarshalCachedObject2( wireFormat, info->getConsumerId().get(), dataOut, bs );
         tightMarshalCachedObject2( wireFormat, info->getDestination().get(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getDeliverySequenceId(), dataOut, bs );
@@ -138,8 +138,8 @@ void MessageDispatchNotificationMarshaller::looseMarshal( OpenWireFormat* wireFo
 
     try {
 
-        MessageDispatchNotification* info =
-            dynamic_cast<MessageDispatchNotification*>( dataStructure );
+        const MessageDispatchNotification* info =
+            dynamic_cast<const MessageDispatchNotification*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalCachedObject( wireFormat, info->getConsumerId().get(), dataOut );
         looseMarshalCachedObject( wireFormat, info->getDestination().get(), dataOut );
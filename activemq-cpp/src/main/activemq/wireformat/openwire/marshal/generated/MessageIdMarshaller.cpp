@@ -74,8 +74,8 @@ int MessageIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructur
 
     try {
 
-        MessageId* info =
-            dynamic_cast<MessageId*>( dataStructure );
+        const MessageId* info =
+            dynamic_cast<const MessageId*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getProducerId().get(), bs );
@@ -96,8 +96,8 @@ void MessageIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStructu
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        MessageId* info =
-            dynamic_cast<MessageId*>( dataStructure );
+        const MessageId* info =
+            dynamic_cast<const MessageId*>( dataStructure );
         tightMarshalCachedObject2( wireFormat, info->getProducerId().get(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getProducerSequenceId(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getBrokerSequenceId(), dataOut, bs );
@@ -130,8 +130,8 @@ void MessageIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructur
 
     try {
 
-        MessageId* info =
-            dynamic_cast<MessageId*>( dataStructure );
+        const MessageId* info =
+            dynamic_cast<const MessageId*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalCachedObject( wireFormat, info->getProducerId().get(), dataOut );
         looseMarshalLong( wireFormat, info->getProducerSequenceId(), dataOut );
@@ -129,8 +129,8 @@ int MessageMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructure*
 
     try {
 
-        Message* info =
-            dynamic_cast<Message*>( dataStructure );
+        const Message* info =
+            dynamic_cast<const Message*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -187,8 +187,8 @@ void MessageMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStructure
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        Message* info =
-            dynamic_cast<Message*>( dataStructure );
+        const Message* info =
+            dynamic_cast<const Message*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -329,8 +329,8 @@ void MessageMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructure*
 
     try {
 
-        Message* info =
-            dynamic_cast<Message*>( dataStructure );
+        const Message* info =
+            dynamic_cast<const Message*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -85,8 +85,8 @@ int MessagePullMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        MessagePull* info =
-            dynamic_cast<MessagePull*>( dataStructure );
+        const MessagePull* info =
+            dynamic_cast<const MessagePull*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -116,8 +116,8 @@ void MessagePullMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruc
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        MessagePull* info =
-            dynamic_cast<MessagePull*>( dataStructure );
+        const MessagePull* info =
+            dynamic_cast<const MessagePull*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -170,8 +170,8 @@ void MessagePullMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        MessagePull* info =
-            dynamic_cast<MessagePull*>( dataStructure );
+        const MessagePull* info =
+            dynamic_cast<const MessagePull*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
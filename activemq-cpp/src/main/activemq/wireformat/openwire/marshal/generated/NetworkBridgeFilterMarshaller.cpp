@@ -73,8 +73,8 @@ int NetworkBridgeFilterMarshaller::tightMarshal1( OpenWireFormat* wireFormat, Da
 
     try {
 
-        NetworkBridgeFilter* info =
-            dynamic_cast<NetworkBridgeFilter*>( dataStructure );
+        const NetworkBridgeFilter* info =
+            dynamic_cast<const NetworkBridgeFilter*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getNetworkBrokerId().get(), bs );
@@ -93,8 +93,8 @@ void NetworkBridgeFilterMarshaller::tightMarshal2( OpenWireFormat* wireFormat, D
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        NetworkBridgeFilter* info =
-            dynamic_cast<NetworkBridgeFilter*>( dataStructure );
+        const NetworkBridgeFilter* info =
+            dynamic_cast<const NetworkBridgeFilter*>( dataStructure );
         dataOut->writeInt( info->getNetworkTTL() );
         tightMarshalCachedObject2( wireFormat, info->getNetworkBrokerId().get(), dataOut, bs );
     }
@@ -125,8 +125,8 @@ void NetworkBridgeFilterMarshaller::looseMarshal( OpenWireFormat* wireFormat, Da
 
     try {
 
-        NetworkBridgeFilter* info =
-            dynamic_cast<NetworkBridgeFilter*>( dataStructure );
+        const NetworkBridgeFilter* info =
+            dynamic_cast<const NetworkBridgeFilter*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->writeInt( info->getNetworkTTL() );
         looseMarshalCachedObject( wireFormat, info->getNetworkBrokerId().get(), dataOut );
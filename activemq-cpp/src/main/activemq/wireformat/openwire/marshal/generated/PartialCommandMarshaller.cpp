@@ -72,8 +72,8 @@ int PartialCommandMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        PartialCommand* info =
-            dynamic_cast<PartialCommand*>( dataStructure );
+        const PartialCommand* info =
+            dynamic_cast<const PartialCommand*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         bs->writeBoolean( info->getData().size() != 0 );
@@ -93,8 +93,8 @@ void PartialCommandMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataSt
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        PartialCommand* info =
-            dynamic_cast<PartialCommand*>( dataStructure );
+        const PartialCommand* info =
+            dynamic_cast<const PartialCommand*>( dataStructure );
         dataOut->writeInt( info->getCommandId() );
         if( bs->readBoolean() ) {
             dataOut->writeInt( (int)info->getData().size() );
@@ -127,8 +127,8 @@ void PartialCommandMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        PartialCommand* info =
-            dynamic_cast<PartialCommand*>( dataStructure );
+        const PartialCommand* info =
+            dynamic_cast<const PartialCommand*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->writeInt( info->getCommandId() );
         dataOut->write( info->getData().size() != 0 );
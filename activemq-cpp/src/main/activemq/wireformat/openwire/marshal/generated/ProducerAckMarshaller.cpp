@@ -80,8 +80,8 @@ int ProducerAckMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        ProducerAck* info =
-            dynamic_cast<ProducerAck*>( dataStructure );
+        const ProducerAck* info =
+            dynamic_cast<const ProducerAck*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -107,8 +107,8 @@ void ProducerAckMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruc
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ProducerAck* info =
-            dynamic_cast<ProducerAck*>( dataStructure );
+        const ProducerAck* info =
+            dynamic_cast<const ProducerAck*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -153,8 +153,8 @@ void ProducerAckMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        ProducerAck* info =
-            dynamic_cast<ProducerAck*>( dataStructure );
+        const ProducerAck* info =
+            dynamic_cast<const ProducerAck*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -73,8 +73,8 @@ int ProducerIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        ProducerId* info =
-            dynamic_cast<ProducerId*>( dataStructure );
+        const ProducerId* info =
+            dynamic_cast<const ProducerId*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getConnectionId(), bs );
@@ -95,8 +95,8 @@ void ProducerIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruct
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ProducerId* info =
-            dynamic_cast<ProducerId*>( dataStructure );
+        const ProducerId* info =
+            dynamic_cast<const ProducerId*>( dataStructure );
         tightMarshalString2( info->getConnectionId(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getValue(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getSessionId(), dataOut, bs );
@@ -128,8 +128,8 @@ void ProducerIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        ProducerId* info =
-            dynamic_cast<ProducerId*>( dataStructure );
+        const ProducerId* info =
+            dynamic_cast<const ProducerId*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getConnectionId(), dataOut );
         looseMarshalLong( wireFormat, info->getValue(), dataOut );
@@ -94,8 +94,8 @@ int ProducerInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>( dataStructure );
+        const ProducerInfo* info =
+            dynamic_cast<const ProducerInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -124,8 +124,8 @@ void ProducerInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStru
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>( dataStructure );
+        const ProducerInfo* info =
+            dynamic_cast<const ProducerInfo*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -187,8 +187,8 @@ void ProducerInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruc
 
     try {
 
-        ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>( dataStructure );
+        const ProducerInfo* info =
+            dynamic_cast<const ProducerInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -78,8 +78,8 @@ int RemoveInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        RemoveInfo* info =
-            dynamic_cast<RemoveInfo*>( dataStructure );
+        const RemoveInfo* info =
+            dynamic_cast<const RemoveInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -104,8 +104,8 @@ void RemoveInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruct
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        RemoveInfo* info =
-            dynamic_cast<RemoveInfo*>( dataStructure );
+        const RemoveInfo* info =
+            dynamic_cast<const RemoveInfo*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -146,8 +146,8 @@ void RemoveInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructu
 
     try {
 
-        RemoveInfo* info =
-            dynamic_cast<RemoveInfo*>( dataStructure );
+        const RemoveInfo* info =
+            dynamic_cast<const RemoveInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
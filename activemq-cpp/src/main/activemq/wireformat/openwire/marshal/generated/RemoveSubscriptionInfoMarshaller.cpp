@@ -74,8 +74,8 @@ int RemoveSubscriptionInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat,
 
     try {
 
-        RemoveSubscriptionInfo* info =
-            dynamic_cast<RemoveSubscriptionInfo*>( dataStructure );
+        const RemoveSubscriptionInfo* info =
+            dynamic_cast<const RemoveSubscriptionInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getConnectionId().get(), bs );
@@ -96,8 +96,8 @@ void RemoveSubscriptionInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        RemoveSubscriptionInfo* info =
-            dynamic_cast<RemoveSubscriptionInfo*>( dataStructure );
+        const RemoveSubscriptionInfo* info =
+            dynamic_cast<const RemoveSubscriptionInfo*>( dataStructure );
         tightMarshalCachedObject2( wireFormat, info->getConnectionId().get(), dataOut, bs );
         tightMarshalString2( info->getSubcriptionName(), dataOut, bs );
         tightMarshalString2( info->getClientId(), dataOut, bs );
@@ -130,8 +130,8 @@ void RemoveSubscriptionInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat,
 
     try {
 
-        RemoveSubscriptionInfo* info =
-            dynamic_cast<RemoveSubscriptionInfo*>( dataStructure );
+        const RemoveSubscriptionInfo* info =
+            dynamic_cast<const RemoveSubscriptionInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalCachedObject( wireFormat, info->getConnectionId().get(), dataOut );
         looseMarshalString( info->getSubcriptionName(), dataOut );
@@ -88,8 +88,8 @@ void ReplayCommandMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStr
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        ReplayCommand* info =
-            dynamic_cast<ReplayCommand*>( dataStructure );
+        const ReplayCommand* info =
+            dynamic_cast<const ReplayCommand*>( dataStructure );
         dataOut->writeInt( info->getFirstNakNumber() );
         dataOut->writeInt( info->getLastNakNumber() );
     }
@@ -119,8 +119,8 @@ void ReplayCommandMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStru
 
     try {
 
-        ReplayCommand* info =
-            dynamic_cast<ReplayCommand*>( dataStructure );
+        const ReplayCommand* info =
+            dynamic_cast<const ReplayCommand*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->writeInt( info->getFirstNakNumber() );
         dataOut->writeInt( info->getLastNakNumber() );
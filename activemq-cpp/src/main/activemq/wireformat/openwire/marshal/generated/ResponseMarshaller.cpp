@@ -87,8 +87,8 @@ void ResponseMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStructur
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        Response* info =
-            dynamic_cast<Response*>( dataStructure );
+        const Response* info =
+            dynamic_cast<const Response*>( dataStructure );
         dataOut->writeInt( info->getCorrelationId() );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -116,8 +116,8 @@ void ResponseMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructure
 
     try {
 
-        Response* info =
-            dynamic_cast<Response*>( dataStructure );
+        const Response* info =
+            dynamic_cast<const Response*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->writeInt( info->getCorrelationId() );
     }
@@ -72,8 +72,8 @@ int SessionIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStructur
 
     try {
 
-        SessionId* info =
-            dynamic_cast<SessionId*>( dataStructure );
+        const SessionId* info =
+            dynamic_cast<const SessionId*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalString1( info->getConnectionId(), bs );
@@ -93,8 +93,8 @@ void SessionIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStructu
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        SessionId* info =
-            dynamic_cast<SessionId*>( dataStructure );
+        const SessionId* info =
+            dynamic_cast<const SessionId*>( dataStructure );
         tightMarshalString2( info->getConnectionId(), dataOut, bs );
         tightMarshalLong2( wireFormat, info->getValue(), dataOut, bs );
     }
@@ -124,8 +124,8 @@ void SessionIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStructur
 
     try {
 
-        SessionId* info =
-            dynamic_cast<SessionId*>( dataStructure );
+        const SessionId* info =
+            dynamic_cast<const SessionId*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalString( info->getConnectionId(), dataOut );
         looseMarshalLong( wireFormat, info->getValue(), dataOut );
@@ -72,8 +72,8 @@ int SessionInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        SessionInfo* info =
-            dynamic_cast<SessionInfo*>( dataStructure );
+        const SessionInfo* info =
+            dynamic_cast<const SessionInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getSessionId().get(), bs );
@@ -92,8 +92,8 @@ void SessionInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataStruc
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        SessionInfo* info =
-            dynamic_cast<SessionInfo*>( dataStructure );
+        const SessionInfo* info =
+            dynamic_cast<const SessionInfo*>( dataStructure );
         tightMarshalCachedObject2( wireFormat, info->getSessionId().get(), dataOut, bs );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
@@ -122,8 +122,8 @@ void SessionInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStruct
 
     try {
 
-        SessionInfo* info =
-            dynamic_cast<SessionInfo*>( dataStructure );
+        const SessionInfo* info =
+            dynamic_cast<const SessionInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalCachedObject( wireFormat, info->getSessionId().get(), dataOut );
     }
@@ -82,8 +82,8 @@ int SubscriptionInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataS
 
     try {
 
-        SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>( dataStructure );
+        const SubscriptionInfo* info =
+            dynamic_cast<const SubscriptionInfo*>( dataStructure );
 
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
 
@@ -111,8 +111,8 @@ void SubscriptionInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, Data
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>( dataStructure );
+        const SubscriptionInfo* info =
+            dynamic_cast<const SubscriptionInfo*>( dataStructure );
 
         int wireVersion = wireFormat->getVersion();
 
@@ -160,8 +160,8 @@ void SubscriptionInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataS
 
     try {
 
-        SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>( dataStructure );
+        const SubscriptionInfo* info =
+            dynamic_cast<const SubscriptionInfo*>( dataStructure );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
 
         int wireVersion = wireFormat->getVersion();
@@ -75,8 +75,8 @@ int TransactionInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>( dataStructure );
+        const TransactionInfo* info =
+            dynamic_cast<const TransactionInfo*>( dataStructure );
 
         int rc = BaseCommandMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         rc += tightMarshalCachedObject1( wireFormat, info->getConnectionId().get(), bs );
@@ -96,8 +96,8 @@ void TransactionInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         BaseCommandMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>( dataStructure );
+        const TransactionInfo* info =
+            dynamic_cast<const TransactionInfo*>( dataStructure );
         tightMarshalCachedObject2( wireFormat, info->getConnectionId().get(), dataOut, bs );
         tightMarshalCachedObject2( wireFormat, info->getTransactionId().get(), dataOut, bs );
         dataOut->write( info->getType() );
@@ -131,8 +131,8 @@ void TransactionInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>( dataStructure );
+        const TransactionInfo* info =
+            dynamic_cast<const TransactionInfo*>( dataStructure );
         BaseCommandMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         looseMarshalCachedObject( wireFormat, info->getConnectionId().get(), dataOut );
         looseMarshalCachedObject( wireFormat, info->getTransactionId().get(), dataOut );
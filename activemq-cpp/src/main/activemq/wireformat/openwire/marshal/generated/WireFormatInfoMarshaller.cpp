@@ -77,10 +77,10 @@ int WireFormatInfoMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        WireFormatInfo* info =
-            dynamic_cast<WireFormatInfo*>( dataStructure );
+        const WireFormatInfo* info =
+            dynamic_cast<const WireFormatInfo*>( dataStructure );
 
-        info->beforeMarshal( wireFormat );
+        dataStructure->beforeMarshal( wireFormat );
         int rc = BaseDataStreamMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         bs->writeBoolean( info->getMarshalledProperties().size() != 0 );
         rc += info->getMarshalledProperties().size() == 0 ? 0 : (int)info->getMarshalledProperties().size() + 4;
@@ -99,15 +99,15 @@ void WireFormatInfoMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataSt
 
         BaseDataStreamMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        WireFormatInfo* info =
-            dynamic_cast<WireFormatInfo*>( dataStructure );
+        const WireFormatInfo* info =
+            dynamic_cast<const WireFormatInfo*>( dataStructure );
         dataOut->write( (const unsigned char*)(&info->getMagic()[0]), 8, 0, 8 );
         dataOut->writeInt( info->getVersion() );
         if( bs->readBoolean() ) {
             dataOut->writeInt( (int)info->getMarshalledProperties().size() );
             dataOut->write( (const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size() );
         }
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
@@ -138,9 +138,9 @@ void WireFormatInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStr
 
     try {
 
-        WireFormatInfo* info =
-            dynamic_cast<WireFormatInfo*>( dataStructure );
-        info->beforeMarshal( wireFormat );
+        const WireFormatInfo* info =
+            dynamic_cast<const WireFormatInfo*>( dataStructure );
+        dataStructure->beforeMarshal( wireFormat );
         BaseDataStreamMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->write( (const unsigned char*)(&info->getMagic()[0]), 8, 0, 8 );
         dataOut->writeInt( info->getVersion() );
@@ -149,7 +149,7 @@ void WireFormatInfoMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataStr
             dataOut->writeInt( (int)info->getMarshalledProperties().size() );
             dataOut->write( (const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size() );
         }
-        info->afterMarshal( wireFormat );
+        dataStructure->afterMarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException )
     AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException )
@@ -73,8 +73,8 @@ int XATransactionIdMarshaller::tightMarshal1( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        XATransactionId* info =
-            dynamic_cast<XATransactionId*>( dataStructure );
+        const XATransactionId* info =
+            dynamic_cast<const XATransactionId*>( dataStructure );
 
         int rc = TransactionIdMarshaller::tightMarshal1( wireFormat, dataStructure, bs );
         bs->writeBoolean( info->getGlobalTransactionId().size() != 0 );
@@ -96,8 +96,8 @@ void XATransactionIdMarshaller::tightMarshal2( OpenWireFormat* wireFormat, DataS
 
         TransactionIdMarshaller::tightMarshal2( wireFormat, dataStructure, dataOut, bs );
 
-        XATransactionId* info =
-            dynamic_cast<XATransactionId*>( dataStructure );
+        const XATransactionId* info =
+            dynamic_cast<const XATransactionId*>( dataStructure );
         dataOut->writeInt( info->getFormatId() );
         if( bs->readBoolean() ) {
             dataOut->writeInt( (int)info->getGlobalTransactionId().size() );
@@ -135,8 +135,8 @@ void XATransactionIdMarshaller::looseMarshal( OpenWireFormat* wireFormat, DataSt
 
     try {
 
-        XATransactionId* info =
-            dynamic_cast<XATransactionId*>( dataStructure );
+        const XATransactionId* info =
+            dynamic_cast<const XATransactionId*>( dataStructure );
         TransactionIdMarshaller::looseMarshal( wireFormat, dataStructure, dataOut );
         dataOut->writeInt( info->getFormatId() );
         dataOut->write( info->getGlobalTransactionId().size() != 0 );
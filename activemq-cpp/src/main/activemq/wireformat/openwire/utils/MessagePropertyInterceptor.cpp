@@ -33,23 +33,17 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-MessagePropertyInterceptor::MessagePropertyInterceptor(
-    commands::Message* message, PrimitiveMap* properties ) : message( message ), properties( properties ) {
+MessagePropertyInterceptor::MessagePropertyInterceptor( commands::Message* message ) : message( message ) {
 
     if( message == NULL ) {
         throw NullPointerException(
             __FILE__, __LINE__, "Message passed was NULL" );
     }
-
-    if( properties == NULL ) {
-        throw NullPointerException(
-            __FILE__, __LINE__, "PrimitiveMap passed was NULL" );
-    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 MessagePropertyInterceptor::MessagePropertyInterceptor( const MessagePropertyInterceptor& )
-    : message( NULL ), properties( NULL ) {
+    : message( NULL ) {
 
 }
 
@@ -62,6 +56,17 @@ MessagePropertyInterceptor& MessagePropertyInterceptor::operator= ( const Messag
 MessagePropertyInterceptor::~MessagePropertyInterceptor() {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+const PrimitiveMap& MessagePropertyInterceptor::getProperties() const {
+    const commands::Message* constMessage = this->message;
+    return constMessage->getMessageProperties();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveMap& MessagePropertyInterceptor::getProperties() {
+    return this->message->getMessageProperties();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool MessagePropertyInterceptor::getBooleanProperty( const std::string& name ) const {
 
@@ -71,7 +76,7 @@ bool MessagePropertyInterceptor::getBooleanProperty( const std::string& name ) c
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    return this->properties->getBool( name );
+    return this->getProperties().getBool( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -83,7 +88,7 @@ unsigned char MessagePropertyInterceptor::getByteProperty( const std::string& na
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    return this->properties->getByte( name );
+    return this->getProperties().getByte( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,7 +100,7 @@ double MessagePropertyInterceptor::getDoubleProperty( const std::string& name )
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    return this->properties->getDouble( name );
+    return this->getProperties().getDouble( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -107,7 +112,7 @@ float MessagePropertyInterceptor::getFloatProperty( const std::string& name ) co
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    return this->properties->getFloat( name );
+    return this->getProperties().getFloat( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -123,7 +128,7 @@ int MessagePropertyInterceptor::getIntProperty( const std::string& name ) const
         return this->message->getGroupSequence();
     }
 
-    return this->properties->getInt( name );
+    return this->getProperties().getInt( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -139,7 +144,7 @@ long long MessagePropertyInterceptor::getLongProperty( const std::string& name )
         return (long long)this->message->getGroupSequence();
     }
 
-    return this->properties->getLong( name );
+    return this->getProperties().getLong( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -151,7 +156,7 @@ short MessagePropertyInterceptor::getShortProperty( const std::string& name ) co
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    return this->properties->getShort( name );
+    return this->getProperties().getShort( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,7 +170,7 @@ std::string MessagePropertyInterceptor::getStringProperty( const std::string& na
         return Integer::toString( this->message->getGroupSequence() );
     }
 
-    return this->properties->getString( name );
+    return this->getProperties().getString( name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -177,7 +182,7 @@ void MessagePropertyInterceptor::setBooleanProperty( const std::string& name, bo
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    this->properties->setBool( name, value );
+    this->getProperties().setBool( name, value );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -189,7 +194,7 @@ void MessagePropertyInterceptor::setByteProperty( const std::string& name, unsig
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    this->properties->setByte( name, value );
+    this->getProperties().setByte( name, value );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -201,7 +206,7 @@ void MessagePropertyInterceptor::setDoubleProperty( const std::string& name, dou
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    this->properties->setDouble( name, value );
+    this->getProperties().setDouble( name, value );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -213,7 +218,7 @@ void MessagePropertyInterceptor::setFloatProperty( const std::string& name, floa
             "Cannot Convert Reserved Property to this Type." );
     }
 
-    this->properties->setFloat( name, value );
+    this->getProperties().setFloat( name, value );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -229,12 +234,12 @@ void MessagePropertyInterceptor::setIntProperty( const std::string& name, int va
         this->message->setGroupSequence( value );
     }
 
-    this->properties->setInt( name, value );
+    this->getProperties().setInt( name, value );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setLongProperty( const std::string& name, long long value ) {
-    this->properties->setLong( name, value );
+    this->getProperties().setLong( name, value );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -250,7 +255,7 @@ void MessagePropertyInterceptor::setShortProperty( const std::string& name, shor
         this->message->setGroupSequence( (int)value );
     }
 
-    this->properties->setShort( name, value );
+    this->getProperties().setShort( name, value );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -265,5 +270,5 @@ void MessagePropertyInterceptor::setStringProperty( const std::string& name,
         this->message->setGroupSequence( Integer::parseInt( value ) );
     }
 
-    this->properties->setString( name, value );
+    this->getProperties().setString( name, value );
 }
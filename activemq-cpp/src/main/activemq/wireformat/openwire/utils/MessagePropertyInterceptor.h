@@ -48,25 +48,28 @@ namespace utils {
     private:
 
         commands::Message* message;
-        util::PrimitiveMap* properties;
 
     private:
 
         MessagePropertyInterceptor( const MessagePropertyInterceptor& );
         MessagePropertyInterceptor& operator= ( const MessagePropertyInterceptor& );
 
+        // The Message's property map is always fetched through the Message so that
+        // received properties are unmarshaled on first use and changes are seen.
+        const util::PrimitiveMap& getProperties() const;
+        util::PrimitiveMap& getProperties();
+
     public:
 
         /**
          * Constructor, accepts the Message that will be used to store JMS reserved
-         * property values, and the PrimitiveMap to get and set the rest to.
+         * property values, the rest are stored in the Message's property map.
          *
-         * @param message - The Message to store reserved property data in
-         * @param properties - The PrimitiveMap to store the rest of the properties in.
+         * @param message - The Message to store the property data in
          *
-         * @throws NullPointerException if either param is NULL
+         * @throws NullPointerException if the message is NULL
          */
-        MessagePropertyInterceptor( commands::Message* message, util::PrimitiveMap* properties );
+        MessagePropertyInterceptor( commands::Message* message );
 
         virtual ~MessagePropertyInterceptor();
 
@@ -0,0 +1,64 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CMS_ASYNCCALLBACK_H_
+#define _CMS_ASYNCCALLBACK_H_
+
+#include <cms/Config.h>
+#include <cms/CMSException.h>
+
+namespace cms{
+
+    /**
+     * Asynchronous event interface for CMS asynchronous operations.
+     * <p>
+     * For methods in the CMS API that support asynchronous invocation, the caller
+     * passes an instance of this interface and the method returns as soon as the
+     * operation has been started.  When the operation completes one of the callback
+     * methods is invoked to report its outcome, for a MessageProducer send this
+     * happens once the provider has confirmed that the message was received.
+     * <p>
+     * The callback is invoked from a thread owned by the CMS provider so it should
+     * complete quickly and must not call back into the resource that invoked it in a
+     * way that would block waiting on another asynchronous operation.  The caller
+     * retains ownership of the callback and must keep it alive until it is called.
+     *
+     * @since 3.5
+     */
+    class CMS_API AsyncCallback {
+    public:
+
+        virtual ~AsyncCallback();
+
+        /**
+         * Called when the asynchronous operation has completed successfully.
+         */
+        virtual void onSuccess() = 0;
+
+        /**
+         * Called when the asynchronous operation has failed.
+         *
+         * @param ex
+         *      The exception that describes why the operation failed.
+         */
+        virtual void onException(const cms::CMSException& ex) = 0;
+
+    };
+
+}
+
+#endif /*_CMS_ASYNCCALLBACK_H_*/
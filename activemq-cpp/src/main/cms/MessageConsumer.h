@@ -25,6 +25,8 @@
 #include <cms/Startable.h>
 #include <cms/Stoppable.h>
 
+#include <vector>
+
 namespace cms{
 
     class MessageTransformer;
@@ -93,6 +95,31 @@ namespace cms{
          */
         virtual Message* receiveNoWait() = 0;
 
+        /**
+         * Synchronously Receive a batch of Messages.  Waits up to the given time for the
+         * first Message to arrive and then takes as many of the Messages that have already
+         * arrived as the limit allows without waiting again.  Receiving a batch can be
+         * cheaper than receiving the same Messages one at a time since the provider can
+         * acknowledge them together.
+         *
+         * @param messages
+         *      The vector the received messages are appended to, the caller owns them
+         *      and must delete them.
+         * @param maxMessages
+         *      The maximum number of messages to receive, must be greater than zero.
+         * @param millisecs
+         *      The time to wait for the first message, zero to return at once if none
+         *      has arrived or negative to wait until one does.
+         *
+         * @return the number of messages that were appended to the vector.
+         *
+         * @throws CMSException - If an internal error occurs, no messages are appended
+         *         to the vector in that case.
+         *
+         * @since 3.5
+         */
+        virtual int receive( std::vector<Message*>& messages, int maxMessages, int millisecs ) = 0;
+
         /**
          * Sets the MessageListener that this class will send notifs on
          *
@@ -20,6 +20,7 @@
 
 #include <cms/Config.h>
 #include <cms/Message.h>
+#include <cms/AsyncCallback.h>
 #include <cms/Destination.h>
 #include <cms/Closeable.h>
 #include <cms/CMSException.h>
@@ -28,6 +29,8 @@
 #include <cms/UnsupportedOperationException.h>
 #include <cms/DeliveryMode.h>
 
+#include <vector>
+
 namespace cms{
 
     class MessageTransformer;
@@ -144,6 +147,146 @@ namespace cms{
         virtual void send(const Destination* destination, Message* message,
                           int deliveryMode, int priority, long long timeToLive) = 0;
 
+        /**
+         * Sends the message to the default producer destination without waiting for the
+         * provider to confirm that it was received, the given callback is notified once
+         * the send completes.  The message is not owned by the producer, the caller must
+         * still destroy it but can do so as soon as this method returns.
+         * Uses default values for deliveryMode, priority, and time to live.
+         *
+         * @param message
+         *      The message to be sent.
+         * @param onComplete
+         *      The callback to notify when the send completes, it must remain valid
+         *      until it has been called.
+         *
+         * @throws CMSException - if an internal error occurs while sending the message.
+         * @throws MessageFormatException - if an Invalid Message is given.
+         * @throws InvalidDestinationException - if a client uses this method with a
+         *         MessageProducer with an invalid destination.
+         * @throws UnsupportedOperationException - if a client uses this method with a
+         *         MessageProducer that did not specify a destination at creation time.
+         *
+         * @since 3.5
+         */
+        virtual void send(Message* message, AsyncCallback* onComplete) = 0;
+
+        /**
+         * Sends the message to the default producer destination without waiting for the
+         * provider to confirm that it was received, the given callback is notified once
+         * the send completes.  The message is not owned by the producer, the caller must
+         * still destroy it but can do so as soon as this method returns.
+         *
+         * @param message
+         *      The message to be sent.
+         * @param deliveryMode
+         *      The delivery mode to be used.
+         * @param priority
+         *      The priority for this message.
+         * @param timeToLive
+         *      The time to live value for this message in milliseconds.
+         * @param onComplete
+         *      The callback to notify when the send completes, it must remain valid
+         *      until it has been called.
+         *
+         * @throws CMSException - if an internal error occurs while sending the message.
+         * @throws MessageFormatException - if an Invalid Message is given.
+         * @throws InvalidDestinationException - if a client uses this method with a
+         *         MessageProducer with an invalid destination.
+         * @throws UnsupportedOperationException - if a client uses this method with a
+         *         MessageProducer that did not specify a destination at creation time.
+         *
+         * @since 3.5
+         */
+        virtual void send(Message* message, int deliveryMode, int priority,
+                          long long timeToLive, AsyncCallback* onComplete) = 0;
+
+        /**
+         * Sends the message to the designated destination without waiting for the
+         * provider to confirm that it was received, the given callback is notified once
+         * the send completes.  The message is not owned by the producer, the caller must
+         * still destroy it but can do so as soon as this method returns.
+         * Uses default values for deliveryMode, priority, and time to live.
+         *
+         * @param destination
+         *      The destination on which to send the message
+         * @param message
+         *      The message to be sent.
+         * @param onComplete
+         *      The callback to notify when the send completes, it must remain valid
+         *      until it has been called.
+         *
+         * @throws CMSException - if an internal error occurs while sending the message.
+         * @throws MessageFormatException - if an Invalid Message is given.
+         * @throws InvalidDestinationException - if a client uses this method with a
+         *         MessageProducer with an invalid destination.
+         * @throws UnsupportedOperationException - if a client uses this method with a
+         *         MessageProducer that did not specify a destination at creation time.
+         *
+         * @since 3.5
+         */
+        virtual void send(const Destination* destination, Message* message, AsyncCallback* onComplete) = 0;
+
+        /**
+         * Sends the message to the designated destination without waiting for the
+         * provider to confirm that it was received, the given callback is notified once
+         * the send completes.  The message is not owned by the producer, the caller must
+         * still destroy it but can do so as soon as this method returns.
+         *
+         * @param destination
+         *      The destination on which to send the message
+         * @param message
+         *      The message to be sent.
+         * @param deliveryMode
+         *      The delivery mode to be used.
+         * @param priority
+         *      The priority for this message.
+         * @param timeToLive
+         *      The time to live value for this message in milliseconds.
+         * @param onComplete
+         *      The callback to notify when the send completes, it must remain valid
+         *      until it has been called.
+         *
+         * @throws CMSException - if an internal error occurs while sending the message.
+         * @throws MessageFormatException - if an Invalid Message is given.
+         * @throws InvalidDestinationException - if a client uses this method with a
+         *         MessageProducer with an invalid destination.
+         * @throws UnsupportedOperationException - if a client uses this method with a
+         *         MessageProducer that did not specify a destination at creation time.
+         *
+         * @since 3.5
+         */
+        virtual void send(const Destination* destination, Message* message,
+                          int deliveryMode, int priority, long long timeToLive,
+                          AsyncCallback* onComplete) = 0;
+
+        /**
+         * Sends a batch of messages to the default producer destination, in order, using
+         * the default values for deliveryMode, priority, and time to live.  Sending a batch
+         * can be cheaper than sending the same messages one at a time, a provider that
+         * waits for each message to be confirmed can wait for the whole batch at once.
+         * The messages are not owned by the producer.
+         *
+         * The batch is not atomic.  Every message is sent before any confirmation is
+         * waited for, so if the provider rejects one of them the ones after it are still
+         * sent and the first failure is thrown once all of them have been answered.  If
+         * the send fails part way through, the messages sent before the failure are not
+         * recalled.  Sending the batch within a transacted session makes it all or nothing.
+         *
+         * @param messages
+         *      The messages to be sent.
+         *
+         * @throws CMSException - if an internal error occurs while sending the messages.
+         * @throws MessageFormatException - if an Invalid Message is given.
+         * @throws InvalidDestinationException - if a client uses this method with a
+         *         MessageProducer with an invalid destination.
+         * @throws UnsupportedOperationException - if a client uses this method with a
+         *         MessageProducer that did not specify a destination at creation time.
+         *
+         * @since 3.5
+         */
+        virtual void send(const std::vector<Message*>& messages) = 0;
+
         /**
          * Sets the delivery mode for this Producer
          *
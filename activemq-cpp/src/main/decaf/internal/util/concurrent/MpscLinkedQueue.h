@@ -0,0 +1,139 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_UTIL_CONCURRENT_MPSCLINKEDQUEUE_H_
+#define _DECAF_INTERNAL_UTIL_CONCURRENT_MPSCLINKEDQUEUE_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/internal/util/concurrent/Atomics.h>
+
+namespace decaf {
+namespace internal {
+namespace util {
+namespace concurrent {
+
+    /**
+     * An unbounded lock free queue that supports any number of producer threads
+     * and a single consumer thread.  Producers link a new node onto the tail with
+     * a single atomic swap, the consumer removes nodes from the head without any
+     * atomic operations.
+     *
+     * A producer that has swapped in its node but not yet linked it to the previous
+     * one makes that node and any that follow it briefly invisible to the consumer,
+     * so poll can return false while an offer is still completing.  Callers that
+     * track the number of elements separately should retry in that case.
+     *
+     * This class does not provide any blocking, callers are expected to layer
+     * their own waiting on top of it.
+     *
+     * @since 1.0
+     */
+    template<typename E>
+    class MpscLinkedQueue {
+    private:
+
+        class Node {
+        private:
+
+            Node( const Node& );
+            Node& operator= ( const Node& );
+
+        public:
+
+            E value;
+            Node* volatile next;
+
+            Node() : value(), next( NULL ) {}
+            Node( const E& value ) : value( value ), next( NULL ) {}
+        };
+
+        // Consumer side, always points at a node whose value was already taken.
+        Node* head;
+
+        // Producer side, the most recently offered node.
+        Node* volatile tail;
+
+    private:
+
+        MpscLinkedQueue( const MpscLinkedQueue& );
+        MpscLinkedQueue& operator= ( const MpscLinkedQueue& );
+
+    public:
+
+        MpscLinkedQueue() : head( NULL ), tail( NULL ) {
+            Node* stub = new Node();
+            this->head = stub;
+            this->tail = stub;
+        }
+
+        virtual ~MpscLinkedQueue() {
+            E discard;
+            while( poll( discard ) ) {}
+            delete this->head;
+        }
+
+        /**
+         * Adds the value to the tail of the queue, may be called from any thread.
+         *
+         * @param value
+         *      The value to add, a copy is stored in the queue.
+         */
+        void offer( const E& value ) {
+            Node* node = new Node( value );
+            Node* previous = (Node*)Atomics::getAndSet( (volatile void**)&this->tail, (void*)node );
+            Atomics::getAndSet( (volatile void**)&previous->next, (void*)node );
+        }
+
+        /**
+         * Removes the value at the head of the queue, must only be called from the
+         * single consumer thread.
+         *
+         * @param result
+         *      Assigned the value that was removed when this method returns true.
+         *
+         * @returns true if a value was removed, false if none was visible.
+         */
+        bool poll( E& result ) {
+
+            Node* current = this->head;
+            Node* next = current->next;
+
+            if( next == NULL ) {
+                return false;
+            }
+
+            result = next->value;
+            next->value = E();
+            this->head = next;
+            delete current;
+
+            return true;
+        }
+
+        /**
+         * @returns true if the consumer would currently find nothing to poll, must
+         *          only be called from the single consumer thread.
+         */
+        bool isEmpty() const {
+            return this->head->next == NULL;
+        }
+
+    };
+
+}}}}
+
+#endif /* _DECAF_INTERNAL_UTIL_CONCURRENT_MPSCLINKEDQUEUE_H_ */
@@ -147,6 +147,12 @@ namespace concurrent {
          */
         static void yeild();
 
+        /**
+         * Hints to the processor that the calling thread is in a spin-wait loop, this
+         * lowers the cost of spinning and frees resources for a sibling hardware thread.
+         */
+        static void spinPause();
+
     public:  // Thread Local Methods
 
         static void createTlsKey(decaf_tls_key* key);
@@ -28,6 +28,9 @@
 #include <decaf/internal/util/concurrent/Atomics.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
 
+#include <algorithm>
+#include <stdlib.h>
+
 using namespace decaf;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
@@ -106,15 +109,21 @@ namespace {
         decaf_tls_key selfKey;
         decaf_mutex_t globalLock;
         decaf_mutex_t tlsLock;
+        decaf_mutex_t monitorsLock;
         std::vector<Thread*> osThreads;
         decaf_thread_t mainThread;
         std::vector<int> priorityMapping;
         AtomicInteger osThreadId;
         MonitorPool* monitors;
+        volatile int monitorSpinLimit;
     };
 
     #define MONITOR_POOL_BLOCK_SIZE 64
 
+    // The fewest spins a contended monitor makes when spinning is enabled, this lets a
+    // monitor whose estimate has dropped to zero discover that its lock is short lived again.
+    #define MONITOR_MIN_SPINS 10
+
     ThreadingLibrary* library = NULL;
 
     // ------------------------ Forward Declare All Utility Methds ----------------------- //
@@ -132,6 +141,8 @@ namespace {
     MonitorHandle* batchAllocateMonitors();
     void doMonitorExit(MonitorHandle* monitor, ThreadHandle* thread);
     void doMonitorEnter(MonitorHandle* monitor, ThreadHandle* thread);
+    bool doMonitorSpin(MonitorHandle* monitor, int spinLimit);
+    int readMonitorSpinLimit();
     void doNotifyWaiters(MonitorHandle* monitor, bool notifyAll);
     void doNotifyThread(ThreadHandle* thread, bool markAsNotified);
     bool doWaitOnMonitor(MonitorHandle* monitor, ThreadHandle* thread, long long mills, int nanos, bool interruptible);
@@ -161,11 +172,12 @@ namespace {
 
         // TODO tls_finalize (self);
 
+        // Once the locks are released a joiner is free to destroy this handle.
+        decaf_thread_t handle = self->handle;
+
         PlatformThread::unlockMutex(self->mutex);
         PlatformThread::unlockMutex(library->globalLock);
 
-        decaf_thread_t handle = self->handle;
-
         if (destroy == true) {
             free(self->name);
             PlatformThread::destroyMutex(self->mutex);
@@ -360,6 +372,7 @@ namespace {
         monitor->count = 0;
         monitor->blocking = NULL;
         monitor->waiting = NULL;
+        monitor->spins = 0;
         monitor->next = NULL;
         return monitor;
     }
@@ -547,6 +560,53 @@ namespace {
         PlatformThread::unlockMutex(monitor->mutex);
     }
 
+    // Reads the initial monitor spin limit from the environment, it is read before the
+    // System class is initialized so the process environment is the only place it can
+    // come from.  Values that aren't a positive number leave spinning disabled.
+    int readMonitorSpinLimit() {
+
+        const char* value = ::getenv("DECAF_MONITOR_SPIN_LIMIT");
+        if (value == NULL) {
+            return 0;
+        }
+
+        char* end = NULL;
+        long limit = ::strtol(value, &end, 10);
+        if (end == value || *end != '\0' || limit <= 0) {
+            return 0;
+        }
+
+        return (int)std::min(limit, (long)Integer::MAX_VALUE);
+    }
+
+    bool doMonitorSpin(MonitorHandle* monitor, int spinLimit) {
+
+        // Spin for up to twice the number of spins that recently succeeded so that the
+        // time spent spinning tracks how long this monitor's lock is usually held.
+        int limit = std::min(spinLimit, monitor->spins * 2 + MONITOR_MIN_SPINS);
+        int count = 0;
+
+        while (count < limit) {
+
+            count++;
+            PlatformThread::spinPause();
+
+            // Only try the lock once the owner appears to have released it, this keeps
+            // the spinning threads from stealing the lock's cache line from the owner.
+            if (*((ThreadHandle* volatile*) &monitor->owner) == NULL &&
+                PlatformThread::tryLockMutex(monitor->lock) == true) {
+
+                monitor->spins += (count - monitor->spins) / 8;
+                return true;
+            }
+        }
+
+        // The lock was held for longer than it was worth spinning, back off so that
+        // threads contending for a long held lock go straight to blocking.
+        monitor->spins /= 2;
+        return false;
+    }
+
     void doMonitorEnter(MonitorHandle* monitor, ThreadHandle* thread) {
 
         while(true) {
@@ -557,6 +617,13 @@ namespace {
                 break;
             }
 
+            int spinLimit = library->monitorSpinLimit;
+            if (spinLimit > 0 && doMonitorSpin(monitor, spinLimit)) {
+                monitor->owner = thread;
+                monitor->count = 1;
+                break;
+            }
+
             PlatformThread::lockMutex(monitor->mutex);
 
             if (PlatformThread::tryLockMutex(monitor->lock) == true) {
@@ -735,10 +802,12 @@ void Threading::initialize() {
     PlatformThread::createTlsKey(&(library->selfKey));
     PlatformThread::createMutex(&(library->globalLock));
     PlatformThread::createMutex(&(library->tlsLock));
+    PlatformThread::createMutex(&(library->monitorsLock));
 
     library->monitors = new MonitorPool;
     library->monitors->head = batchAllocateMonitors();
     library->monitors->count = MONITOR_POOL_BLOCK_SIZE;
+    library->monitorSpinLimit = readMonitorSpinLimit();
 
     // We mark the thread where Decaf's Init routine is called from as our Main Thread.
     library->mainThread = PlatformThread::getCurrentThread();
@@ -766,6 +835,7 @@ void Threading::shutdown() {
     PlatformThread::destroyTlsKey(library->selfKey);
     PlatformThread::destroyMutex(library->globalLock);
     PlatformThread::destroyMutex(library->tlsLock);
+    PlatformThread::destroyMutex(library->monitorsLock);
 
     purgeMonitorsPool(library->monitors);
     delete library->monitors;
@@ -1291,13 +1361,26 @@ void Threading::unpark(Thread* thread) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-MonitorHandle* Threading::takeMonitor(bool alreadyLocked) {
+void Threading::setMonitorSpinLimit(int limit) {
+
+    if (limit < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Monitor spin limit cannot be negative.");
+    }
+
+    library->monitorSpinLimit = limit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Threading::getMonitorSpinLimit() {
+    return library->monitorSpinLimit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MonitorHandle* Threading::takeMonitor() {
 
     MonitorHandle* monitor = NULL;
 
-    if (!alreadyLocked) {
-        PlatformThread::lockMutex(library->globalLock);
-    }
+    PlatformThread::lockMutex(library->monitorsLock);
 
     if (library->monitors->head == NULL) {
         library->monitors->head = batchAllocateMonitors();
@@ -1315,15 +1398,13 @@ MonitorHandle* Threading::takeMonitor(bool alreadyLocked) {
         monitor->initialized = true;
     }
 
-    if (!alreadyLocked) {
-        PlatformThread::unlockMutex(library->globalLock);
-    }
+    PlatformThread::unlockMutex(library->monitorsLock);
 
     return monitor;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Threading::returnMonitor(MonitorHandle* monitor, bool alreadyLocked) {
+void Threading::returnMonitor(MonitorHandle* monitor) {
 
     if (monitor == NULL) {
         throw RuntimeException(__FILE__, __LINE__, "Monitor pointer was null");
@@ -1341,18 +1422,14 @@ void Threading::returnMonitor(MonitorHandle* monitor, bool alreadyLocked) {
         Threading::exitMonitor(monitor);
     }
 
-    if (!alreadyLocked) {
-        PlatformThread::lockMutex(library->globalLock);
-    }
+    PlatformThread::lockMutex(library->monitorsLock);
 
     initMonitorHandle(monitor);
     monitor->next = library->monitors->head;
     library->monitors->head = monitor;
     library->monitors->count++;
 
-    if (!alreadyLocked) {
-        PlatformThread::unlockMutex(library->globalLock);
-    }
+    PlatformThread::unlockMutex(library->monitorsLock);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,14 +68,37 @@ namespace concurrent {
 
     public:  // Monitors
 
+        /**
+         * Sets the maximum number of times a thread that finds a Monitor locked spins
+         * waiting for it to be released before it blocks.  Each Monitor adapts how long it
+         * spins to how long its lock has recently been held for, up to this limit, so locks
+         * that are held for only a few microseconds are usually acquired without the cost
+         * of parking the thread while locks that are held longer quickly stop spinning.
+         * The limit starts out as the value of the DECAF_MONITOR_SPIN_LIMIT environment
+         * variable when the library is initialized.
+         *
+         * @param limit
+         *      The maximum number of spins, zero disables spinning which is the default.
+         *
+         * @throws IllegalArgumentException if the limit is negative.
+         */
+        static void setMonitorSpinLimit(int limit);
+
+        /**
+         * @returns the maximum number of times a thread spins on a locked Monitor before
+         *          it blocks, zero if spinning is disabled.
+         */
+        static int getMonitorSpinLimit();
+
         /**
          * Gets a monitor for use as a locking mechanism.  The monitor returned will be
          * initialized and ready for use.  Each monitor that is taken must be returned before
-         * the Threading library is shutdown.
+         * the Threading library is shutdown.  The Monitor pool is guarded by its own lock so
+         * this method never contends with threads that hold the Threading library lock.
          *
          * @returns handle to a Monitor instance that has been initialized.
          */
-        static MonitorHandle* takeMonitor(bool alreadyLocked = false);
+        static MonitorHandle* takeMonitor();
 
         /**
          * Returns a given monitor to the Monitor pool after the Monitor is no longer needed.
@@ -85,7 +108,7 @@ namespace concurrent {
          *
          * @throws IllegalMonitorStateException if the monitor is in use when returned.
          */
-        static void returnMonitor(MonitorHandle* monitor, bool alreadyLocked = false);
+        static void returnMonitor(MonitorHandle* monitor);
 
         /**
          * Monitor locking method.  The calling thread blocks until it acquires the
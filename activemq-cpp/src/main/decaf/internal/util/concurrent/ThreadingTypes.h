@@ -94,6 +94,7 @@ namespace concurrent{
         ThreadHandle* owner;
         ThreadHandle* waiting;
         ThreadHandle* blocking;
+        int spins;
         bool initialized;
         MonitorHandle* next;
     };
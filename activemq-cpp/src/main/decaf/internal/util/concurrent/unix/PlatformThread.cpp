@@ -455,6 +455,18 @@ void PlatformThread::yeild() {
     #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PlatformThread::spinPause() {
+
+    #if defined(__GNUC__) && ( defined(__i386__) || defined(__x86_64__) )
+        __asm__ __volatile__( "pause" : : : "memory" );
+    #elif defined(__GNUC__) && defined(__aarch64__)
+        __asm__ __volatile__( "yield" : : : "memory" );
+    #elif defined(__GNUC__)
+        __asm__ __volatile__( "" : : : "memory" );
+    #endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void PlatformThread::createTlsKey(decaf_tls_key* tlsKey) {
     pthread_key_create(tlsKey, NULL);
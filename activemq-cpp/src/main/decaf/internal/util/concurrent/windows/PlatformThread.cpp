@@ -427,6 +427,12 @@ void PlatformThread::yeild() {
     SwitchToThread();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PlatformThread::spinPause() {
+    YieldProcessor();
+    MemoryBarrier();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void PlatformThread::createTlsKey(decaf_tls_key* tlsKey) {
     if (tlsKey == NULL) {
@@ -78,6 +78,24 @@ void ByteArrayOutputStream::reset() {
     this->count = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ByteArrayOutputStream::resetAndTrim( int maxCapacity ) {
+
+    if( maxCapacity <= 0 ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Maximum capacity given was invalid: %d", maxCapacity );
+    }
+
+    this->count = 0;
+
+    if( this->bufferSize > maxCapacity ) {
+        unsigned char* temp = new unsigned char[maxCapacity];
+        std::swap( temp, this->buffer );
+        this->bufferSize = maxCapacity;
+        delete [] temp;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ByteArrayOutputStream::doWriteByte( unsigned char c ) {
 
@@ -95,6 +95,31 @@ namespace io{
          */
         virtual void reset();
 
+        /**
+         * Clears the current Stream contents, as reset does, and if the internal buffer has
+         * grown beyond the given size replaces it with one of that size.  A stream that is
+         * reused for many writes can call this so that it doesn't keep holding on to the
+         * memory taken by an unusually large one.
+         *
+         * @param maxCapacity
+         *      The largest internal buffer the stream keeps once cleared.
+         *
+         * @throw IllegalArgumentException if the size is less than or equal to zero.
+         *
+         * @since 3.5
+         */
+        void resetAndTrim( int maxCapacity );
+
+        /**
+         * @returns the size of the internal buffer, the number of bytes that can be held
+         *          before it has to grow.
+         *
+         * @since 3.5
+         */
+        int capacity() const {
+            return this->bufferSize;
+        }
+
         /**
          * Converts the bytes in the buffer into a standard C++ string
          * @returns a string containing the bytes in the buffer
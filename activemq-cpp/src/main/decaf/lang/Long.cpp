@@ -146,17 +146,17 @@ long long Long::lowestOneBit( long long value ) {
 int Long::numberOfLeadingZeros( long long value ) {
 
     if( value == 0 ) {
-        return 0;
+        return 64;
     }
 
     unsigned long long uvalue = (unsigned long long)value;
 
-    value |= value >> 1;
-    value |= value >> 2;
-    value |= value >> 4;
-    value |= value >> 8;
-    value |= value >> 16;
-    value |= value >> 32;
+    uvalue |= uvalue >> 1;
+    uvalue |= uvalue >> 2;
+    uvalue |= uvalue >> 4;
+    uvalue |= uvalue >> 8;
+    uvalue |= uvalue >> 16;
+    uvalue |= uvalue >> 32;
     return Long::bitCount( ~uvalue );
 }
 
@@ -40,7 +40,10 @@ namespace lang {
      * and is Thread Safe if the default Reference Counter is used.  This Pointer
      * type allows for the substitution of different Reference Counter implementations
      * which provide a means of using invasive reference counting if desired using
-     * a custom implementation of <code>ReferenceCounter</code>.
+     * a custom implementation of <code>ReferenceCounter</code>.  The Reference Counter
+     * is constructed from the raw pointer the Pointer takes ownership of, the default
+     * AtomicRefCounter uses this to share the count embedded in types that derive from
+     * AtomicRefCounted and to avoid allocating a count for a NULL Pointer.
      * <p>
      * The Decaf smart pointer provide comparison operators for comparing Pointer
      * instances in the same manner as normal pointer, except that it does not provide
@@ -76,7 +79,7 @@ namespace lang {
          * Initialized the contained pointer to NULL, using the -> operator
          * results in an exception unless reset to contain a real value.
          */
-        Pointer() : REFCOUNTER(), value( NULL ), onDelete( onDeleteFunc ) {}
+        Pointer() : REFCOUNTER( static_cast<const void*>( NULL ) ), value( NULL ), onDelete( onDeleteFunc ) {}
 
         /**
          * Explicit Constructor, creates a Pointer that contains value with a
@@ -84,7 +87,7 @@ namespace lang {
          *
          * @param value - instance of the type we are containing here.
          */
-        explicit Pointer( const PointerType value ) : REFCOUNTER(), value( value ), onDelete( onDeleteFunc ) {
+        explicit Pointer( const PointerType value ) : REFCOUNTER( value ), value( value ), onDelete( onDeleteFunc ) {
         }
 
         /**
@@ -40,6 +40,11 @@ namespace lang {
          * Initialize the Decaf Library passing it the args that were passed
          * to the application at startup.
          *
+         * If the DECAF_MONITOR_SPIN_LIMIT environment variable is set to a
+         * positive number a thread that finds a Mutex locked spins up to that
+         * many times waiting for it before it blocks, by default it blocks at
+         * once.
+         *
          * @param argc - The number of args passed
          * @param argv - Array of char* values passed to the Process on start.
          *
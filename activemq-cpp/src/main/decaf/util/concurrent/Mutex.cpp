@@ -18,10 +18,9 @@
 #include <decaf/util/concurrent/Mutex.h>
 
 #include <decaf/internal/util/concurrent/Threading.h>
+#include <decaf/internal/util/concurrent/Atomics.h>
 #include <decaf/lang/Integer.h>
 
-#include <list>
-
 using namespace decaf;
 using namespace decaf::internal;
 using namespace decaf::internal::util;
@@ -32,114 +31,82 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-namespace decaf{
-namespace util{
-namespace concurrent{
+namespace {
 
-    class MutexProperties {
-    private:
+    volatile int nextMutexId = 0;
 
-        MutexProperties( const MutexProperties& );
-        MutexProperties& operator= ( const MutexProperties& );
+    const std::string DEFAULT_NAME_PREFIX = "Mutex-";
 
-    public:
+    MonitorHandle* getMonitor(MonitorHandle*& monitor) {
 
-        MutexProperties() : monitor(NULL), name() {
-            this->name = DEFAULT_NAME_PREFIX + Integer::toString( ++id );
-        }
+        if (monitor == NULL) {
 
-        MutexProperties(const std::string& name) : monitor(NULL), name(name) {
-            if( this->name.empty() ) {
-                this->name = DEFAULT_NAME_PREFIX + Integer::toString( ++id );
+            MonitorHandle* newMonitor = Threading::takeMonitor();
+
+            // Another thread could have installed a Monitor while we took this one.
+            if (!Atomics::compareAndSwap<MonitorHandle>(monitor, NULL, newMonitor)) {
+                Threading::returnMonitor(newMonitor);
             }
         }
 
-        MonitorHandle* monitor;
-        std::string name;
-
-        static unsigned int id;
-        static std::string DEFAULT_NAME_PREFIX;
-
-    };
-
-    unsigned int MutexProperties::id = 0;
-    std::string MutexProperties::DEFAULT_NAME_PREFIX = "Mutex-";
-
-}}}
+        return monitor;
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
-Mutex::Mutex() : Synchronizable(), properties(NULL) {
-    this->properties = new MutexProperties();
+Mutex::Mutex() : Synchronizable(), monitor(NULL), name(), id(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Mutex::Mutex( const std::string& name ) : Synchronizable(), properties(NULL) {
-    this->properties = new MutexProperties( name );
+Mutex::Mutex( const std::string& name ) : Synchronizable(), monitor(NULL), name(name), id(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Mutex::~Mutex() {
 
-    if (this->properties->monitor != NULL) {
-        Threading::returnMonitor(this->properties->monitor);
+    if (this->monitor != NULL) {
+        Threading::returnMonitor(this->monitor);
     }
-
-    delete this->properties;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string Mutex::getName() const {
-    return this->properties->name;
+
+    if (!this->name.empty()) {
+        return this->name;
+    }
+
+    if (this->id == 0) {
+        Atomics::compareAndSet32(&this->id, 0, Atomics::incrementAndGet(&nextMutexId));
+    }
+
+    return DEFAULT_NAME_PREFIX + Integer::toString(this->id);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string Mutex::toString() const {
-    return this->properties->name;
+    return getName();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::lock() {
-
-    if(this->properties->monitor == NULL) {
-
-        Threading::lockThreadsLib();
-
-        if (this->properties->monitor == NULL) {
-            this->properties->monitor = Threading::takeMonitor(true);
-        }
-
-        Threading::unlockThreadsLib();
-    }
-
-    Threading::enterMonitor(this->properties->monitor);
+    Threading::enterMonitor(getMonitor(this->monitor));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool Mutex::tryLock() {
-
-    if(this->properties->monitor == NULL) {
-
-        Threading::lockThreadsLib();
-
-        if (this->properties->monitor == NULL) {
-            this->properties->monitor = Threading::takeMonitor(true);
-        }
-
-        Threading::unlockThreadsLib();
-    }
-
-    return Threading::tryEnterMonitor(this->properties->monitor);
+    return Threading::tryEnterMonitor(getMonitor(this->monitor));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::unlock() {
 
-    if (this->properties->monitor == NULL) {
+    if (this->monitor == NULL) {
         throw IllegalMonitorStateException(__FILE__, __LINE__,
             "Call to unlock without prior call to lock or tryLock");
     }
 
-    Threading::exitMonitor(this->properties->monitor);
+    Threading::exitMonitor(this->monitor);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -163,32 +130,32 @@ void Mutex::wait( long long millisecs, int nanos ) {
         throw IllegalArgumentException(__FILE__, __LINE__, "Nanoseconds value must be in the range [0..999999].");
     }
 
-    if (this->properties->monitor == NULL) {
+    if (this->monitor == NULL) {
         throw IllegalMonitorStateException(__FILE__, __LINE__,
             "Call to wait without prior call to lock or tryLock");
     }
 
-    Threading::waitOnMonitor(this->properties->monitor, millisecs, nanos);
+    Threading::waitOnMonitor(this->monitor, millisecs, nanos);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::notify() {
 
-    if (this->properties->monitor == NULL) {
+    if (this->monitor == NULL) {
         throw IllegalMonitorStateException(__FILE__, __LINE__,
             "Call to notify without prior call to lock or tryLock");
     }
 
-    Threading::notifyWaiter(this->properties->monitor);
+    Threading::notifyWaiter(this->monitor);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::notifyAll() {
 
-    if (this->properties->monitor == NULL) {
+    if (this->monitor == NULL) {
         throw IllegalMonitorStateException(__FILE__, __LINE__,
             "Call to notifyAll without prior call to lock or tryLock");
     }
 
-    Threading::notifyAllWaiters(this->properties->monitor);
+    Threading::notifyAllWaiters(this->monitor);
 }
@@ -24,22 +24,36 @@
 #include <decaf/util/Config.h>
 
 namespace decaf{
+namespace internal{
+namespace util{
+namespace concurrent{
+    struct MonitorHandle;
+}}}
 namespace util{
 namespace concurrent{
-
-    class MutexProperties;
 
     /**
      * Mutex object that offers recursive support on all platforms as well as
      * providing the ability to use the standard wait / notify pattern used in
      * languages like Java.
      *
+     * Creating a Mutex is cheap, nothing is allocated and no global state is
+     * touched until the Mutex is first locked, at which point a Monitor is taken
+     * from the Threading library's pool.  Mutexes that are never locked, such as
+     * the ones inside the collections carried by each message, never take one.
+     *
      * @since 1.0
      */
     class DECAF_API Mutex : public Synchronizable {
     private:
 
-        MutexProperties* properties;
+        decaf::internal::util::concurrent::MonitorHandle* monitor;
+
+        // The name given at construction, empty if the default name is used.
+        std::string name;
+
+        // Assigned the first time the default name is requested.
+        mutable volatile int id;
 
     private:
 
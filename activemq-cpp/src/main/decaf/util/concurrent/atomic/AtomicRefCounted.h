@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_ATOMIC_ATOMICREFCOUNTED_H_
+#define _DECAF_UTIL_CONCURRENT_ATOMIC_ATOMICREFCOUNTED_H_
+
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+namespace decaf{
+namespace util{
+namespace concurrent{
+namespace atomic{
+
+    class AtomicRefCounter;
+
+    /**
+     * Base class for types that carry their own reference count.  When a Pointer that
+     * uses the default AtomicRefCounter takes ownership of an instance of a class derived
+     * from this one it uses the embedded count instead of allocating a separate counter,
+     * so the object and its count are created with a single allocation and share the same
+     * cache lines.
+     * <p>
+     * The embedded count belongs to the object's identity, it is not copied when the
+     * object is copied or assigned.  An instance that has been given to a Pointer must
+     * still only be given to one Pointer, all further references must be made by copying
+     * that Pointer.
+     *
+     * @since 3.5.0
+     */
+    class AtomicRefCounted {
+    private:
+
+        friend class AtomicRefCounter;
+
+        mutable decaf::util::concurrent::atomic::AtomicInteger refCount;
+
+    protected:
+
+        AtomicRefCounted() : refCount( 0 ) {}
+
+        AtomicRefCounted( const AtomicRefCounted& ) : refCount( 0 ) {}
+
+        AtomicRefCounted& operator= ( const AtomicRefCounted& ) {
+            return *this;
+        }
+
+        ~AtomicRefCounted() {}
+
+    public:
+
+        /**
+         * @returns the number of Pointers that currently hold a reference to this object.
+         */
+        int getReferenceCount() const {
+            return this->refCount.get();
+        }
+
+    };
+
+}}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_ATOMIC_ATOMICREFCOUNTED_H_ */
@@ -19,6 +19,7 @@
 #define _DECAF_UTIL_CONCURRENT_ATOMIC_ATOMICREFCOUNTER_H_
 
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicRefCounted.h>
 #include <algorithm>
 
 namespace decaf{
@@ -26,11 +27,20 @@ namespace util{
 namespace concurrent{
 namespace atomic{
 
+    /**
+     * The default reference counter used by Pointer.  The counter is allocated on the heap
+     * unless the object being counted derives from AtomicRefCounted in which case the count
+     * embedded in the object is used, a counter created for a NULL object holds no count at
+     * all so that empty Pointers never allocate.
+     */
     class AtomicRefCounter {
     private:
 
         decaf::util::concurrent::atomic::AtomicInteger* counter;
 
+        // True if the counter was allocated by this class and must be deleted by it.
+        bool ownsCounter;
+
     private:
 
         AtomicRefCounter& operator= ( const AtomicRefCounter& );
@@ -38,9 +48,44 @@ namespace atomic{
     public:
 
         AtomicRefCounter() :
-            counter( new decaf::util::concurrent::atomic::AtomicInteger( 1 ) ) {}
-        AtomicRefCounter( const AtomicRefCounter& other ) : counter( other.counter ) {
-            this->counter->incrementAndGet();
+            counter( new decaf::util::concurrent::atomic::AtomicInteger( 1 ) ), ownsCounter( true ) {}
+
+        /**
+         * Creates a counter that holds the first reference to the given object.
+         *
+         * @param object
+         *      The object whose references are counted, may be NULL.
+         */
+        explicit AtomicRefCounter( const void* object ) :
+            counter( NULL ), ownsCounter( object != NULL ) {
+
+            if( object != NULL ) {
+                this->counter = new decaf::util::concurrent::atomic::AtomicInteger( 1 );
+            }
+        }
+
+        /**
+         * Creates a counter that holds a reference to the given object using the count
+         * that is embedded in it.
+         *
+         * @param object
+         *      The object whose references are counted, may be NULL.
+         */
+        explicit AtomicRefCounter( const AtomicRefCounted* object ) :
+            counter( NULL ), ownsCounter( false ) {
+
+            if( object != NULL ) {
+                this->counter = &object->refCount;
+                this->counter->incrementAndGet();
+            }
+        }
+
+        AtomicRefCounter( const AtomicRefCounter& other ) :
+            counter( other.counter ), ownsCounter( other.ownsCounter ) {
+
+            if( this->counter != NULL ) {
+                this->counter->incrementAndGet();
+            }
         }
 
         virtual ~AtomicRefCounter() {}
@@ -56,18 +101,23 @@ namespace atomic{
          */
         void swap( AtomicRefCounter& other ) {
             std::swap( this->counter, other.counter );
+            std::swap( this->ownsCounter, other.ownsCounter );
         }
 
         /**
          * Removes a reference to the counter Atomically and returns if the counter
          * has reached zero, once the counter hits zero, the internal counter is
-         * destroyed and this instance is now considered to be unreferenced.
+         * destroyed and this instance is now considered to be unreferenced.  A
+         * counter that was created for a NULL object holds no count and is never
+         * considered to have reached zero.
          *
          * @return true if the count is now zero.
          */
         bool release() {
-            if( this->counter->decrementAndGet() == 0 ) {
-                delete this->counter;
+            if( this->counter != NULL && this->counter->decrementAndGet() == 0 ) {
+                if( this->ownsCounter ) {
+                    delete this->counter;
+                }
                 return true;
             }
             return false;
@@ -0,0 +1,44 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQTextMessageBenchmark.h"
+
+#include <decaf/lang/Pointer.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQTextMessageBenchmark::ActiveMQTextMessageBenchmark() {}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQTextMessageBenchmark::run() {
+
+    int numRuns = 1000;
+
+    for( int i = 0; i < numRuns; ++i ) {
+
+        Pointer<ActiveMQTextMessage> message( new ActiveMQTextMessage() );
+        message->setText( "Hello World" );
+        message->setIntProperty( "count", i );
+        message->setStringProperty( "name", "benchmark" );
+
+        Pointer<ActiveMQTextMessage> copy( message->cloneDataStructure() );
+    }
+}
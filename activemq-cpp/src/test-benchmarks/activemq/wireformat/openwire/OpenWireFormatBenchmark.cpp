@@ -0,0 +1,72 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OpenWireFormatBenchmark.h"
+
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFormatBenchmark::OpenWireFormatBenchmark() :
+    properties(), wireFormat( properties ), transport(), message(), buffer(), dataOut( &buffer ) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFormatBenchmark::~OpenWireFormatBenchmark() {}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatBenchmark::setUp() {
+
+    wireFormat.setTightEncodingEnabled( false );
+    wireFormat.setSizePrefixDisabled( false );
+
+    Pointer<ProducerId> producerId( new ProducerId() );
+    producerId->setConnectionId( "ID:benchmark-connection:1" );
+    producerId->setSessionId( 1 );
+    producerId->setValue( 1 );
+
+    Pointer<MessageId> messageId( new MessageId() );
+    messageId->setProducerId( producerId );
+    messageId->setProducerSequenceId( 1 );
+
+    message.reset( new ActiveMQTextMessage() );
+    message->setProducerId( producerId );
+    message->setMessageId( messageId );
+    message->setDestination( Pointer<ActiveMQDestination>( new ActiveMQQueue( "BENCHMARK.QUEUE" ) ) );
+    message->setText( "Hello World" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatBenchmark::run() {
+
+    int numRuns = 100000;
+
+    Pointer<Command> command = message.dynamicCast<Command>();
+
+    for( int i = 0; i < numRuns; ++i ) {
+        buffer.reset();
+        wireFormat.marshal( command, &transport, &dataOut );
+    }
+}
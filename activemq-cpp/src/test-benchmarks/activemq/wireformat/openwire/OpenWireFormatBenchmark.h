@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFORMATBENCHMARK_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFORMATBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/transport/IOTransport.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+
+namespace activemq{
+namespace wireformat{
+namespace openwire{
+
+    /**
+     * Marshals one million small ActiveMQTextMessages using the loose, size
+     * prefixed encoding.
+     */
+    class OpenWireFormatBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::wireformat::openwire::OpenWireFormatBenchmark, OpenWireFormat, 10 >
+    {
+    private:
+
+        decaf::util::Properties properties;
+        OpenWireFormat wireFormat;
+        transport::IOTransport transport;
+        decaf::lang::Pointer<commands::ActiveMQTextMessage> message;
+        decaf::io::ByteArrayOutputStream buffer;
+        decaf::io::DataOutputStream dataOut;
+
+    private:
+
+        OpenWireFormatBenchmark( const OpenWireFormatBenchmark& );
+        OpenWireFormatBenchmark& operator= ( const OpenWireFormatBenchmark& );
+
+    public:
+
+        OpenWireFormatBenchmark();
+        virtual ~OpenWireFormatBenchmark();
+
+        void setUp();
+        void run();
+
+    };
+
+}}}
+
+#endif /*_ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFORMATBENCHMARK_H_*/
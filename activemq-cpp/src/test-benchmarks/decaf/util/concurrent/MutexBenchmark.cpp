@@ -0,0 +1,59 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MutexBenchmark.h"
+
+#include <decaf/util/StlMap.h>
+
+using namespace decaf;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+MutexBenchmark::MutexBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MutexBenchmark::run() {
+
+    int numRuns = 5000;
+
+    // Mutexes that are never locked, such as those in a message's maps.
+    for( int i = 0; i < numRuns; ++i ) {
+        Mutex mutex;
+    }
+
+    StlMap<std::string, int> map;
+    map.put( "one", 1 );
+    map.put( "two", 2 );
+
+    for( int i = 0; i < numRuns; ++i ) {
+        StlMap<std::string, int> copy( map );
+    }
+
+    for( int i = 0; i < numRuns; ++i ) {
+        Mutex mutex;
+        mutex.lock();
+        mutex.unlock();
+    }
+
+    Mutex mutex;
+    for( int i = 0; i < numRuns; ++i ) {
+        mutex.lock();
+        mutex.unlock();
+    }
+}
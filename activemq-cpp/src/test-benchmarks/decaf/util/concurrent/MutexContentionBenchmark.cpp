@@ -0,0 +1,124 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MutexContentionBenchmark.h"
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/internal/util/concurrent/Threading.h>
+
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::internal::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int NUM_THREADS = 4;
+    const int NUM_LOCKS = 20000;
+    const int SPIN_LIMIT = 1000;
+
+    class ContendingRunnable : public Runnable {
+    private:
+
+        Mutex* mutex;
+        long long* counter;
+
+    private:
+
+        ContendingRunnable( const ContendingRunnable& );
+        ContendingRunnable& operator= ( const ContendingRunnable& );
+
+    public:
+
+        ContendingRunnable( Mutex* mutex, long long* counter ) : Runnable(), mutex( mutex ), counter( counter ) {
+        }
+
+        virtual void run() {
+
+            // Hold the lock for about as long as the session and transport locks are held.
+            for( int i = 0; i < NUM_LOCKS; ++i ) {
+                synchronized( mutex ) {
+                    for( int j = 0; j < 20; ++j ) {
+                        ( *counter )++;
+                    }
+                }
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MutexContentionBenchmark::MutexContentionBenchmark() : blockingTimer(), spinningTimer(), spinLimit( 0 ) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MutexContentionBenchmark::setUp() {
+    this->spinLimit = Threading::getMonitorSpinLimit();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MutexContentionBenchmark::tearDown() {
+
+    Threading::setMonitorSpinLimit( this->spinLimit );
+
+    std::cout << "Mutex contention without spinning = "
+              << blockingTimer.getAverageTime() << " Millisecs, with spinning = "
+              << spinningTimer.getAverageTime() << " Millisecs"
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MutexContentionBenchmark::run() {
+
+    Threading::setMonitorSpinLimit( 0 );
+    blockingTimer.start();
+    contend();
+    blockingTimer.stop();
+
+    Threading::setMonitorSpinLimit( SPIN_LIMIT );
+    spinningTimer.start();
+    contend();
+    spinningTimer.stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MutexContentionBenchmark::contend() {
+
+    Mutex mutex;
+    long long counter = 0;
+    ContendingRunnable runnable( &mutex, &counter );
+
+    std::vector<Thread*> threads;
+
+    for( int i = 0; i < NUM_THREADS; ++i ) {
+        threads.push_back( new Thread( &runnable ) );
+    }
+
+    for( int i = 0; i < NUM_THREADS; ++i ) {
+        threads[i]->start();
+    }
+
+    for( int i = 0; i < NUM_THREADS; ++i ) {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_MUTEXCONTENTIONBENCHMARK_H_
+#define _DECAF_UTIL_CONCURRENT_MUTEXCONTENTIONBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+#include <benchmark/PerformanceTimer.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+namespace decaf{
+namespace util{
+namespace concurrent{
+
+    /**
+     * Measures several threads contending for a Mutex that is held for a very short
+     * time, once with threads blocking as soon as the lock is found to be held and once
+     * with the Threading library's adaptive spinning enabled.
+     */
+    class MutexContentionBenchmark :
+        public benchmark::BenchmarkBase< decaf::util::concurrent::MutexContentionBenchmark, Mutex, 10 >
+    {
+    private:
+
+        benchmark::PerformanceTimer blockingTimer;
+        benchmark::PerformanceTimer spinningTimer;
+        int spinLimit;
+
+    public:
+
+        MutexContentionBenchmark();
+        virtual ~MutexContentionBenchmark() {}
+
+        void setUp();
+        void tearDown();
+
+        virtual void run();
+
+    private:
+
+        void contend();
+
+    };
+
+}}}
+
+#endif /*_DECAF_UTIL_CONCURRENT_MUTEXCONTENTIONBENCHMARK_H_*/
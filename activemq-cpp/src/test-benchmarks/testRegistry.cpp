@@ -15,8 +15,12 @@
  * limitations under the License.
  */
 
+#include <activemq/commands/ActiveMQTextMessageBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::ActiveMQTextMessageBenchmark );
 #include <activemq/util/PrimitiveMapBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::PrimitiveMapBenchmark );
+#include <activemq/wireformat/openwire/OpenWireFormatBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::OpenWireFormatBenchmark );
 
 #include <decaf/lang/BooleanBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::BooleanBenchmark );
@@ -36,6 +40,11 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::StlListBenchmark );
 #include <decaf/util/LinkedListBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LinkedListBenchmark );
 
+#include <decaf/util/concurrent/MutexBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::MutexBenchmark );
+#include <decaf/util/concurrent/MutexContentionBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::MutexContentionBenchmark );
+
 #include <decaf/io/ByteArrayOutputStreamBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::ByteArrayOutputStreamBenchmark );
 #include <decaf/io/ByteArrayInputStreamBenchmark.h>
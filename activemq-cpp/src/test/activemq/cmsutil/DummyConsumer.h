@@ -64,6 +64,15 @@ namespace cmsutil {
             return messageContext->receive(dest, selector, noLocal, -1);
         }
 
+        virtual int receive( std::vector<cms::Message*>& messages, int maxMessages, int millisecs ) throw ( cms::CMSException ) {
+            cms::Message* message = messageContext->receive(dest, selector, noLocal, millisecs);
+            if( message == NULL ) {
+                return 0;
+            }
+            messages.push_back( message );
+            return 1;
+        }
+
         virtual void setMessageListener( cms::MessageListener* listener ) throw ( cms::CMSException ) {
             this->listener = listener;
         }
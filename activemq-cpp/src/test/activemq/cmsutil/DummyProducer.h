@@ -123,6 +123,39 @@ namespace cmsutil {
             messageContext->send(destination, message, deliveryMode, priority, timeToLive);
         }
 
+        virtual void send(cms::Message* message, cms::AsyncCallback* onComplete) throw (cms::CMSException) {
+            send(dest, message, deliveryMode, priority, ttl, onComplete);
+        }
+
+        virtual void send(cms::Message* message, int deliveryMode, int priority, long long timeToLive,
+                          cms::AsyncCallback* onComplete) throw (cms::CMSException) {
+            send(dest, message, deliveryMode, priority, timeToLive, onComplete);
+        }
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          cms::AsyncCallback* onComplete) throw (cms::CMSException) {
+            send(destination, message, deliveryMode, priority, ttl, onComplete);
+        }
+
+        /**
+         * Sends the message and then completes the callback, the dummy producer has no
+         * broker to wait on.
+         */
+        virtual void send(const cms::Destination* destination, cms::Message* message, int deliveryMode, int priority,
+                          long long timeToLive, cms::AsyncCallback* onComplete) throw (cms::CMSException) {
+
+            messageContext->send(destination, message, deliveryMode, priority, timeToLive);
+            if (onComplete != NULL) {
+                onComplete->onSuccess();
+            }
+        }
+
+        virtual void send(const std::vector<cms::Message*>& messages) throw (cms::CMSException) {
+            for (std::size_t i = 0; i < messages.size(); ++i) {
+                send(dest, messages[i], deliveryMode, priority, ttl);
+            }
+        }
+
         /**
          * Sets the delivery mode for this Producer
          *
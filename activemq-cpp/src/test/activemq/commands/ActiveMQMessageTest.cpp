@@ -820,3 +820,72 @@ void ActiveMQMessageTest::testIsExpired() {
     msg.setCMSExpiration( System::currentTimeMillis() + 10000 );
     CPPUNIT_ASSERT( !msg.isExpired() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageTest::testLazyPropertyUnmarshal() {
+
+    ActiveMQMessage sent;
+    sent.setIntProperty( "int", 42 );
+    sent.setStringProperty( "string", "value" );
+    sent.beforeMarshal( NULL );
+
+    std::vector<unsigned char> marshalled = sent.getMarshalledProperties();
+    CPPUNIT_ASSERT( !marshalled.empty() );
+
+    // Simulate receiving the message, the properties are only decoded on demand.
+    ActiveMQMessage received;
+    received.setMarshalledProperties( marshalled );
+    received.afterUnmarshal( NULL );
+
+    // Forwarding a message without touching its properties sends the same bytes.
+    Pointer<Message> forwarded( received.copy() );
+    forwarded->beforeMarshal( NULL );
+    CPPUNIT_ASSERT( forwarded->getMarshalledProperties() == marshalled );
+
+    CPPUNIT_ASSERT_EQUAL( 42, received.getIntProperty( "int" ) );
+    CPPUNIT_ASSERT_EQUAL( std::string( "value" ), received.getStringProperty( "string" ) );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)2, received.getPropertyNames().size() );
+
+    // Reading the properties doesn't force them to be marshaled again.
+    received.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( received.getMarshalledProperties() == marshalled );
+
+    // Changing them does.
+    received.clearProperties();
+    received.setIntProperty( "int", 43 );
+    received.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( received.getMarshalledProperties() != marshalled );
+
+    ActiveMQMessage resent;
+    resent.setMarshalledProperties( received.getMarshalledProperties() );
+    resent.afterUnmarshal( NULL );
+    CPPUNIT_ASSERT_EQUAL( 43, resent.getIntProperty( "int" ) );
+    CPPUNIT_ASSERT( !resent.propertyExists( "string" ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageTest::testCopyOnWriteContent() {
+
+    std::vector<unsigned char> content( 1024, 'a' );
+
+    ActiveMQMessage original;
+    original.setContent( content );
+
+    Pointer<Message> copy( original.copy() );
+
+    // Until one side modifies it the content is shared, not duplicated.
+    const Message& constOriginal = original;
+    const Message& constCopy = *copy;
+    CPPUNIT_ASSERT( &constOriginal.getContent() == &constCopy.getContent() );
+
+    // Writes to either side are not seen by the other.
+    copy->getContent()[0] = 'b';
+    CPPUNIT_ASSERT( &constOriginal.getContent() != &constCopy.getContent() );
+    CPPUNIT_ASSERT_EQUAL( (unsigned char)'a', constOriginal.getContent()[0] );
+    CPPUNIT_ASSERT_EQUAL( (unsigned char)'b', constCopy.getContent()[0] );
+
+    Pointer<Message> second( original.copy() );
+    original.setContent( std::vector<unsigned char>( 16, 'c' ) );
+    CPPUNIT_ASSERT( second->getContent() == content );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)16, original.getContent().size() );
+}
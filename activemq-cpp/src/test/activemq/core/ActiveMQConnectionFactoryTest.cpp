@@ -312,7 +312,11 @@ void ActiveMQConnectionFactoryTest::testURIOptionsProcessing() {
             "mock://127.0.0.1:23232?connection.dispatchAsync=true&"
             "connection.alwaysSyncSend=true&connection.useAsyncSend=true&"
             "connection.useCompression=true&connection.compressionLevel=7&"
-            "connection.closeTimeout=10000";
+            "connection.closeTimeout=10000&connection.copyMessageOnSend=false&"
+            "connection.sessionTaskRunner=pooled&connection.sessionTaskRunnerPoolSize=3&"
+            "connection.optimizeAcknowledge=true&connection.optimizeAcknowledgeTimeOut=500&"
+            "connection.optimizeAcknowledgeRatio=0.5&connection.useRingBufferDispatchChannel=true&"
+            "connection.alwaysSessionAsync=false";
 
         ActiveMQConnectionFactory connectionFactory( URI );
 
@@ -322,6 +326,14 @@ void ActiveMQConnectionFactoryTest::testURIOptionsProcessing() {
         CPPUNIT_ASSERT( connectionFactory.isUseCompression() == true );
         CPPUNIT_ASSERT( connectionFactory.getCloseTimeout() == 10000 );
         CPPUNIT_ASSERT( connectionFactory.getCompressionLevel() == 7 );
+        CPPUNIT_ASSERT( connectionFactory.isCopyMessageOnSend() == false );
+        CPPUNIT_ASSERT( connectionFactory.isUseDedicatedTaskRunner() == false );
+        CPPUNIT_ASSERT( connectionFactory.getSessionTaskRunnerPoolSize() == 3 );
+        CPPUNIT_ASSERT( connectionFactory.isOptimizeAcknowledge() == true );
+        CPPUNIT_ASSERT( connectionFactory.getOptimizeAcknowledgeTimeOut() == 500 );
+        CPPUNIT_ASSERT( connectionFactory.getOptimizeAcknowledgeRatio() == 0.5 );
+        CPPUNIT_ASSERT( connectionFactory.isUseRingBufferDispatchChannel() == true );
+        CPPUNIT_ASSERT( connectionFactory.isAlwaysSessionAsync() == false );
 
         cms::Connection* connection =
             connectionFactory.createConnection();
@@ -336,6 +348,14 @@ void ActiveMQConnectionFactoryTest::testURIOptionsProcessing() {
         CPPUNIT_ASSERT( amqConnection->isUseCompression() == true );
         CPPUNIT_ASSERT( amqConnection->getCloseTimeout() == 10000 );
         CPPUNIT_ASSERT( amqConnection->getCompressionLevel() == 7 );
+        CPPUNIT_ASSERT( amqConnection->isCopyMessageOnSend() == false );
+        CPPUNIT_ASSERT( amqConnection->isUseDedicatedTaskRunner() == false );
+        CPPUNIT_ASSERT( amqConnection->getSessionTaskRunnerPoolSize() == 3 );
+        CPPUNIT_ASSERT( amqConnection->isOptimizeAcknowledge() == true );
+        CPPUNIT_ASSERT( amqConnection->getOptimizeAcknowledgeTimeOut() == 500 );
+        CPPUNIT_ASSERT( amqConnection->getOptimizeAcknowledgeRatio() == 0.5 );
+        CPPUNIT_ASSERT( amqConnection->isUseRingBufferDispatchChannel() == true );
+        CPPUNIT_ASSERT( amqConnection->isAlwaysSessionAsync() == false );
 
         delete connection;
 
@@ -18,11 +18,14 @@
 #include "ActiveMQSessionTest.h"
 
 #include <cms/ExceptionListener.h>
+#include <cms/MessageNotWriteableException.h>
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/transport/TransportRegistry.h>
 #include <activemq/commands/ActiveMQTextMessage.h>
 #include <activemq/commands/ConsumerId.h>
 #include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/core/PrefetchPolicy.h>
 #include <activemq/core/ActiveMQConnectionFactory.h>
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/ActiveMQConsumer.h>
@@ -31,6 +34,7 @@
 #include <decaf/lang/System.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/net/Socket.h>
 #include <decaf/net/ServerSocket.h>
 
@@ -607,6 +611,101 @@ void ActiveMQSessionTest::testExpiration() {
     CPPUNIT_ASSERT( text1 == "This is a Test 1" );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testSendWithoutCopy() {
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+    CPPUNIT_ASSERT( connection->isCopyMessageOnSend() );
+
+    connection->setCopyMessageOnSend( false );
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Topic> topic( session->createTopic( "TestTopic" ) );
+    std::auto_ptr<cms::MessageProducer> producer( session->createProducer( topic.get() ) );
+
+    std::auto_ptr<cms::TextMessage> message( session->createTextMessage( "This is a Test" ) );
+    message->setIntProperty( "count", 1 );
+
+    producer->send( message.get() );
+
+    // The Message itself was sent so it carries the id it was sent with.
+    CPPUNIT_ASSERT( !message->getCMSMessageID().empty() );
+
+    // The sent Message was handed over so it is read-only but still readable.
+    CPPUNIT_ASSERT_EQUAL( std::string( "This is a Test" ), message->getText() );
+    CPPUNIT_ASSERT_EQUAL( 1, message->getIntProperty( "count" ) );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a MessageNotWriteableException",
+        message->setText( "Changed" ),
+        cms::MessageNotWriteableException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a MessageNotWriteableException",
+        message->setIntProperty( "count", 2 ),
+        cms::MessageNotWriteableException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class AckCountingListener : public transport::DefaultTransportListener {
+    public:
+
+        std::vector<int> ackedCounts;
+
+        AckCountingListener() : ackedCounts() {}
+
+        virtual void onCommand( const Pointer<commands::Command>& command ) {
+            if( command->isMessageAck() ) {
+                ackedCounts.push_back( command.dynamicCast<MessageAck>()->getMessageCount() );
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testOptimizeAcknowledge() {
+
+    AckCountingListener ackCounter;
+
+    // Only the prefetch ratio triggers an ack, the timeout would make this timing dependent.
+    connection->setOptimizeAcknowledge( true );
+    connection->setOptimizeAcknowledgeTimeOut( 0 );
+    connection->getPrefetchPolicy()->setQueuePrefetch( 10 );
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestQueue" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( queue.get() ) ) );
+
+    CPPUNIT_ASSERT( consumer.get() != NULL );
+
+    dTransport->setOutgoingListener( &ackCounter );
+
+    for( int i = 0; i < 20; ++i ) {
+        injectTextMessage( "This is a Test", *queue, *( consumer->getConsumerId() ) );
+    }
+
+    for( int i = 0; i < 20; ++i ) {
+        std::auto_ptr<cms::Message> message( consumer->receive( 2000 ) );
+        CPPUNIT_ASSERT( message.get() != NULL );
+    }
+
+    // An ack is sent once 0.65 of the prefetch of 10 has been consumed.
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, ackCounter.ackedCounts.size() );
+    CPPUNIT_ASSERT_EQUAL( 7, ackCounter.ackedCounts[0] );
+    CPPUNIT_ASSERT_EQUAL( 7, ackCounter.ackedCounts[1] );
+
+    // Closing the consumer acks what was held back.
+    consumer->close();
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 3, ackCounter.ackedCounts.size() );
+    CPPUNIT_ASSERT_EQUAL( 6, ackCounter.ackedCounts[2] );
+
+    dTransport->setOutgoingListener( NULL );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::setUp()
 {
@@ -682,3 +781,419 @@ void ActiveMQSessionTest::injectTextMessage( const std::string message,
 
     dTransport->fireCommand( dispatch );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ThreadRecordingListener : public cms::MessageListener {
+    public:
+
+        std::vector<std::string> texts;
+        std::vector<decaf::lang::Thread*> threads;
+        decaf::util::concurrent::Mutex mutex;
+
+        ThreadRecordingListener() : texts(), threads(), mutex() {}
+
+        virtual void onMessage( const cms::Message* message ) {
+
+            synchronized( &mutex ) {
+                const cms::TextMessage* text = dynamic_cast<const cms::TextMessage*>( message );
+                texts.push_back( text != NULL ? text->getText() : "" );
+                threads.push_back( decaf::lang::Thread::currentThread() );
+                mutex.notifyAll();
+            }
+        }
+
+        bool waitForMessages( std::size_t count ) {
+
+            synchronized( &mutex ) {
+                for( int i = 0; i < 50 && texts.size() < count; ++i ) {
+                    mutex.wait( 100 );
+                }
+
+                return texts.size() >= count;
+            }
+
+            return false;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testDirectDispatch() {
+
+    connection->setAlwaysSessionAsync( false );
+
+    ThreadRecordingListener listener;
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Topic> topic( session->createTopic( "TestTopic1" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic.get() ) ) );
+
+    consumer->setMessageListener( &listener );
+
+    injectTextMessage( "1", *topic, *( consumer->getConsumerId() ) );
+
+    // The only consumer of an auto ack session gets the message before the
+    // inject returns, on the thread that injected it.
+    CPPUNIT_ASSERT_EQUAL( 1, (int)listener.texts.size() );
+    CPPUNIT_ASSERT( listener.threads[0] == Thread::currentThread() );
+
+    injectTextMessage( "2", *topic, *( consumer->getConsumerId() ) );
+
+    CPPUNIT_ASSERT_EQUAL( 2, (int)listener.texts.size() );
+    CPPUNIT_ASSERT( listener.threads[1] == Thread::currentThread() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "1" ), listener.texts[0] );
+    CPPUNIT_ASSERT_EQUAL( std::string( "2" ), listener.texts[1] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testDirectDispatchFallsBackToQueue() {
+
+    connection->setAlwaysSessionAsync( false );
+
+    // A second consumer on the session means the session thread delivers.
+    {
+        ThreadRecordingListener listener;
+
+        std::auto_ptr<cms::Session> session( connection->createSession() );
+        std::auto_ptr<cms::Topic> topic1( session->createTopic( "TestTopic1" ) );
+        std::auto_ptr<cms::Topic> topic2( session->createTopic( "TestTopic2" ) );
+        std::auto_ptr<ActiveMQConsumer> consumer1(
+            dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic1.get() ) ) );
+        std::auto_ptr<cms::MessageConsumer> consumer2( session->createConsumer( topic2.get() ) );
+
+        consumer1->setMessageListener( &listener );
+
+        injectTextMessage( "1", *topic1, *( consumer1->getConsumerId() ) );
+
+        CPPUNIT_ASSERT( listener.waitForMessages( 1 ) );
+        CPPUNIT_ASSERT( listener.threads[0] != Thread::currentThread() );
+    }
+
+    // A client ack session always delivers from the session thread.
+    {
+        ThreadRecordingListener listener;
+
+        std::auto_ptr<cms::Session> session(
+            connection->createSession( cms::Session::CLIENT_ACKNOWLEDGE ) );
+        std::auto_ptr<cms::Topic> topic( session->createTopic( "TestTopic1" ) );
+        std::auto_ptr<ActiveMQConsumer> consumer(
+            dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic.get() ) ) );
+
+        consumer->setMessageListener( &listener );
+
+        injectTextMessage( "1", *topic, *( consumer->getConsumerId() ) );
+
+        CPPUNIT_ASSERT( listener.waitForMessages( 1 ) );
+        CPPUNIT_ASSERT( listener.threads[0] != Thread::currentThread() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CreateConsumerListener : public ThreadRecordingListener {
+    public:
+
+        cms::Session* session;
+        cms::Topic* topic;
+        std::vector<bool> refused;
+
+        CreateConsumerListener( cms::Session* session, cms::Topic* topic ) :
+            ThreadRecordingListener(), session( session ), topic( topic ), refused() {}
+
+        virtual void onMessage( const cms::Message* message ) {
+
+            bool failed = false;
+            try {
+                std::auto_ptr<cms::MessageConsumer> consumer( session->createConsumer( topic ) );
+                consumer->close();
+            } catch( cms::CMSException& ) {
+                failed = true;
+            }
+
+            synchronized( &mutex ) {
+                refused.push_back( failed );
+            }
+
+            ThreadRecordingListener::onMessage( message );
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testDirectDispatchRefusesBlockingCalls() {
+
+    connection->setAlwaysSessionAsync( false );
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Topic> topic1( session->createTopic( "TestTopic1" ) );
+    std::auto_ptr<cms::Topic> topic2( session->createTopic( "TestTopic2" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic1.get() ) ) );
+
+    CreateConsumerListener listener( session.get(), topic2.get() );
+    consumer->setMessageListener( &listener );
+
+    // Waiting for the broker's reply on the transport thread would never end.
+    injectTextMessage( "1", *topic1, *( consumer->getConsumerId() ) );
+
+    CPPUNIT_ASSERT_EQUAL( 1, (int)listener.texts.size() );
+    CPPUNIT_ASSERT( listener.threads[0] == Thread::currentThread() );
+    CPPUNIT_ASSERT( listener.refused[0] );
+
+    // After that the session thread runs the listener, where it may block.
+    injectTextMessage( "2", *topic1, *( consumer->getConsumerId() ) );
+
+    CPPUNIT_ASSERT( listener.waitForMessages( 2 ) );
+    CPPUNIT_ASSERT( listener.threads[1] != Thread::currentThread() );
+    CPPUNIT_ASSERT( !listener.refused[1] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testDirectDispatchKeepsOrder() {
+
+    connection->setAlwaysSessionAsync( false );
+
+    ThreadRecordingListener listener;
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Topic> topic( session->createTopic( "TestTopic1" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic.get() ) ) );
+
+    consumer->setMessageListener( &listener );
+
+    // While stopped the messages are held on the session's queue.
+    connection->stop();
+
+    injectTextMessage( "1", *topic, *( consumer->getConsumerId() ) );
+    injectTextMessage( "2", *topic, *( consumer->getConsumerId() ) );
+
+    CPPUNIT_ASSERT( listener.texts.empty() );
+
+    connection->start();
+
+    // This one must wait its turn behind the queued messages.
+    injectTextMessage( "3", *topic, *( consumer->getConsumerId() ) );
+
+    CPPUNIT_ASSERT( listener.waitForMessages( 3 ) );
+    CPPUNIT_ASSERT( listener.threads[0] != Thread::currentThread() );
+    CPPUNIT_ASSERT( listener.threads[1] != Thread::currentThread() );
+
+    // Give the session thread time to go idle, after that delivery is direct again.
+    Thread::sleep( 100 );
+
+    injectTextMessage( "4", *topic, *( consumer->getConsumerId() ) );
+
+    CPPUNIT_ASSERT_EQUAL( 4, (int)listener.texts.size() );
+    CPPUNIT_ASSERT( listener.threads[3] == Thread::currentThread() );
+
+    CPPUNIT_ASSERT_EQUAL( std::string( "1" ), listener.texts[0] );
+    CPPUNIT_ASSERT_EQUAL( std::string( "2" ), listener.texts[1] );
+    CPPUNIT_ASSERT_EQUAL( std::string( "3" ), listener.texts[2] );
+    CPPUNIT_ASSERT_EQUAL( std::string( "4" ), listener.texts[3] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingAsyncCallback : public cms::AsyncCallback {
+    public:
+
+        decaf::util::concurrent::CountDownLatch done;
+        int successCount;
+        int exceptionCount;
+
+        CountingAsyncCallback( int count ) : done( count ), successCount( 0 ), exceptionCount( 0 ) {}
+
+        virtual void onSuccess() {
+            successCount++;
+            done.countDown();
+        }
+
+        virtual void onException( const cms::CMSException& ex AMQCPP_UNUSED ) {
+            exceptionCount++;
+            done.countDown();
+        }
+    };
+
+    class ResponseRequiredCounter : public transport::DefaultTransportListener {
+    public:
+
+        int count;
+
+        ResponseRequiredCounter() : count( 0 ) {}
+
+        virtual void onCommand( const Pointer<commands::Command>& command ) {
+            if( command->isMessage() && command->isResponseRequired() ) {
+                count++;
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testSendWithAsyncCallback() {
+
+    ResponseRequiredCounter counter;
+    dTransport->setOutgoingListener( &counter );
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestQueue" ) );
+    std::auto_ptr<cms::MessageProducer> producer( session->createProducer( queue.get() ) );
+    producer->setDeliveryMode( cms::DeliveryMode::PERSISTENT );
+
+    const int msgCount = 10;
+    CountingAsyncCallback callback( msgCount );
+
+    for( int i = 0; i < msgCount; ++i ) {
+        std::auto_ptr<cms::TextMessage> message( session->createTextMessage( "Async Send" ) );
+        producer->send( message.get(), &callback );
+    }
+
+    CPPUNIT_ASSERT( callback.done.await( 5000 ) );
+    CPPUNIT_ASSERT_EQUAL( msgCount, callback.successCount );
+    CPPUNIT_ASSERT_EQUAL( 0, callback.exceptionCount );
+
+    // Each message must still have asked the broker for a confirmation.
+    CPPUNIT_ASSERT_EQUAL( msgCount, counter.count );
+
+    dTransport->setOutgoingListener( NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testReceiveBatch() {
+
+    AckCountingListener ackCounter;
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestQueue" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( queue.get() ) ) );
+
+    CPPUNIT_ASSERT( consumer.get() != NULL );
+
+    std::vector<cms::Message*> messages;
+
+    CPPUNIT_ASSERT_EQUAL( 0, consumer->receive( messages, 4, 0 ) );
+    CPPUNIT_ASSERT( messages.empty() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException",
+        consumer->receive( messages, 0, 0 ),
+        cms::CMSException );
+
+    dTransport->setOutgoingListener( &ackCounter );
+
+    const int msgCount = 10;
+    for( int i = 0; i < msgCount; ++i ) {
+        injectTextMessage( "This is a Test", *queue, *( consumer->getConsumerId() ) );
+    }
+
+    // The messages reach the consumer from the session thread so each call gets
+    // whatever has arrived, but never more than asked for.
+    int batches = 0;
+    while( (int)messages.size() < msgCount && batches < msgCount ) {
+        int received = consumer->receive( messages, 4, 2000 );
+        CPPUNIT_ASSERT( received > 0 && received <= 4 );
+        batches++;
+    }
+
+    CPPUNIT_ASSERT_EQUAL( msgCount, (int)messages.size() );
+
+    // Each batch is acknowledged with a single ack that covers all of it.
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) batches, ackCounter.ackedCounts.size() );
+
+    int acked = 0;
+    for( std::size_t i = 0; i < ackCounter.ackedCounts.size(); ++i ) {
+        acked += ackCounter.ackedCounts[i];
+    }
+    CPPUNIT_ASSERT_EQUAL( msgCount, acked );
+
+    for( std::size_t i = 0; i < messages.size(); ++i ) {
+        CPPUNIT_ASSERT( dynamic_cast<cms::TextMessage*>( messages[i] ) != NULL );
+        delete messages[i];
+    }
+
+    dTransport->setOutgoingListener( NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testReceiveBatchStopsAtEmptyDispatch() {
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestQueue" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( queue.get() ) ) );
+
+    injectTextMessage( "1", *queue, *( consumer->getConsumerId() ) );
+
+    // A dispatch without a message ends a pull or a browse.
+    Pointer<MessageDispatch> end( new MessageDispatch() );
+    end->setConsumerId( Pointer<ConsumerId>( consumer->getConsumerId()->cloneDataStructure() ) );
+    dTransport->fireCommand( end );
+
+    injectTextMessage( "2", *queue, *( consumer->getConsumerId() ) );
+
+    for( int i = 0; i < 50 && consumer->getMessageAvailableCount() < 3; ++i ) {
+        Thread::sleep( 20 );
+    }
+    CPPUNIT_ASSERT_EQUAL( 3, consumer->getMessageAvailableCount() );
+
+    std::vector<cms::Message*> messages;
+
+    // The message before the end is returned, the end is seen by the next call.
+    CPPUNIT_ASSERT_EQUAL( 1, consumer->receive( messages, 4, 0 ) );
+    CPPUNIT_ASSERT_EQUAL( 0, consumer->receive( messages, 4, 0 ) );
+    CPPUNIT_ASSERT_EQUAL( 1, consumer->receive( messages, 4, 0 ) );
+
+    CPPUNIT_ASSERT_EQUAL( 2, (int)messages.size() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "1" ), dynamic_cast<cms::TextMessage*>( messages[0] )->getText() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "2" ), dynamic_cast<cms::TextMessage*>( messages[1] )->getText() );
+
+    for( std::size_t i = 0; i < messages.size(); ++i ) {
+        delete messages[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testSendBatch() {
+
+    ResponseRequiredCounter counter;
+    dTransport->setOutgoingListener( &counter );
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestQueue" ) );
+    std::auto_ptr<cms::MessageProducer> producer( session->createProducer( queue.get() ) );
+
+    const int msgCount = 10;
+    std::vector<cms::Message*> messages;
+
+    for( int i = 0; i < msgCount; ++i ) {
+        messages.push_back( session->createTextMessage( "Batch Send" ) );
+    }
+
+    // Persistent messages are each confirmed by the broker.
+    producer->setDeliveryMode( cms::DeliveryMode::PERSISTENT );
+    producer->send( messages );
+    CPPUNIT_ASSERT_EQUAL( msgCount, counter.count );
+
+    for( int i = 0; i < msgCount; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( (int)cms::DeliveryMode::PERSISTENT, messages[i]->getCMSDeliveryMode() );
+        CPPUNIT_ASSERT( messages[i]->getCMSTimestamp() != 0 );
+    }
+
+    // Non persistent messages are sent without waiting.
+    producer->setDeliveryMode( cms::DeliveryMode::NON_PERSISTENT );
+    producer->send( messages );
+    CPPUNIT_ASSERT_EQUAL( msgCount, counter.count );
+
+    for( int i = 0; i < msgCount; ++i ) {
+        delete messages[i];
+    }
+
+    dTransport->setOutgoingListener( NULL );
+}
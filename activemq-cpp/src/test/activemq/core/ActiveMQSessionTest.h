@@ -48,6 +48,16 @@ namespace core{
         CPPUNIT_TEST( testTransactionCloseWithoutCommit );
         CPPUNIT_TEST( testExpiration );
         CPPUNIT_TEST( testCreateManyConsumersAndSetListeners );
+        CPPUNIT_TEST( testSendWithoutCopy );
+        CPPUNIT_TEST( testOptimizeAcknowledge );
+        CPPUNIT_TEST( testDirectDispatch );
+        CPPUNIT_TEST( testDirectDispatchFallsBackToQueue );
+        CPPUNIT_TEST( testDirectDispatchKeepsOrder );
+        CPPUNIT_TEST( testDirectDispatchRefusesBlockingCalls );
+        CPPUNIT_TEST( testSendWithAsyncCallback );
+        CPPUNIT_TEST( testReceiveBatch );
+        CPPUNIT_TEST( testReceiveBatchStopsAtEmptyDispatch );
+        CPPUNIT_TEST( testSendBatch );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -95,6 +105,16 @@ namespace core{
         void testTransactionRollbackTwoConsumer();
         void testTransactionCloseWithoutCommit();
         void testExpiration();
+        void testSendWithoutCopy();
+        void testOptimizeAcknowledge();
+        void testDirectDispatch();
+        void testDirectDispatchFallsBackToQueue();
+        void testDirectDispatchKeepsOrder();
+        void testDirectDispatchRefusesBlockingCalls();
+        void testSendWithAsyncCallback();
+        void testReceiveBatch();
+        void testReceiveBatchStopsAtEmptyDispatch();
+        void testSendBatch();
 
     };
 
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DispatchedMessageListTest.h"
+
+#include <activemq/core/DispatchedMessageList.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/NoSuchElementException.h>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageListTest::testCtor() {
+
+    DispatchedMessageList list;
+    CPPUNIT_ASSERT( list.isEmpty() == true );
+    CPPUNIT_ASSERT( list.size() == 0 );
+    CPPUNIT_ASSERT( list.toArray().empty() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should Throw a NoSuchElementException",
+        list.getFirst(),
+        NoSuchElementException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should Throw a NoSuchElementException",
+        list.getLast(),
+        NoSuchElementException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageListTest::testAddFirst() {
+
+    DispatchedMessageList list;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    list.addFirst( dispatch1 );
+    list.addFirst( dispatch2 );
+    list.addFirst( dispatch3 );
+
+    CPPUNIT_ASSERT( list.isEmpty() == false );
+    CPPUNIT_ASSERT( list.size() == 3 );
+    CPPUNIT_ASSERT( list.getFirst() == dispatch3 );
+    CPPUNIT_ASSERT( list.getLast() == dispatch1 );
+
+    std::vector< Pointer<MessageDispatch> > dispatched = list.toArray();
+    CPPUNIT_ASSERT( dispatched.size() == 3 );
+    CPPUNIT_ASSERT( dispatched[0] == dispatch3 );
+    CPPUNIT_ASSERT( dispatched[1] == dispatch2 );
+    CPPUNIT_ASSERT( dispatched[2] == dispatch1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageListTest::testAddFirstExisting() {
+
+    DispatchedMessageList list;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    list.addFirst( dispatch1 );
+    list.addFirst( dispatch2 );
+    list.addFirst( dispatch1 );
+
+    CPPUNIT_ASSERT( list.size() == 2 );
+    CPPUNIT_ASSERT( list.getFirst() == dispatch1 );
+    CPPUNIT_ASSERT( list.getLast() == dispatch2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageListTest::testRemove() {
+
+    DispatchedMessageList list;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    list.addFirst( dispatch1 );
+    list.addFirst( dispatch2 );
+    list.addFirst( dispatch3 );
+
+    CPPUNIT_ASSERT( list.remove( dispatch2 ) == true );
+    CPPUNIT_ASSERT( list.remove( dispatch2 ) == false );
+    CPPUNIT_ASSERT( list.size() == 2 );
+    CPPUNIT_ASSERT( list.getFirst() == dispatch3 );
+    CPPUNIT_ASSERT( list.getLast() == dispatch1 );
+
+    CPPUNIT_ASSERT( list.remove( dispatch3 ) == true );
+    CPPUNIT_ASSERT( list.getFirst() == dispatch1 );
+    CPPUNIT_ASSERT( list.getLast() == dispatch1 );
+
+    CPPUNIT_ASSERT( list.remove( dispatch1 ) == true );
+    CPPUNIT_ASSERT( list.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageListTest::testContains() {
+
+    DispatchedMessageList list;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    list.addFirst( dispatch1 );
+
+    CPPUNIT_ASSERT( list.contains( dispatch1 ) == true );
+    CPPUNIT_ASSERT( list.contains( dispatch2 ) == false );
+
+    list.remove( dispatch1 );
+    CPPUNIT_ASSERT( list.contains( dispatch1 ) == false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DispatchedMessageListTest::testClear() {
+
+    DispatchedMessageList list;
+
+    for( int i = 0; i < 10; ++i ) {
+        list.addFirst( Pointer<MessageDispatch>( new MessageDispatch() ) );
+    }
+
+    CPPUNIT_ASSERT( list.size() == 10 );
+    list.clear();
+    CPPUNIT_ASSERT( list.size() == 0 );
+    CPPUNIT_ASSERT( list.isEmpty() == true );
+    CPPUNIT_ASSERT( list.toArray().empty() );
+}
@@ -209,6 +209,33 @@ void FifoMessageDispatchChannelTest::testDequeue() {
     CPPUNIT_ASSERT( channel.isEmpty() == true );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void FifoMessageDispatchChannelTest::testDequeueAll() {
+
+    FifoMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    std::vector< Pointer<MessageDispatch> > result;
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 0 ) == 0 );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 2 ) == 2 );
+    CPPUNIT_ASSERT( result[0] == dispatch1 );
+    CPPUNIT_ASSERT( result[1] == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 0 ) == 1 );
+    CPPUNIT_ASSERT( result[2] == dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void FifoMessageDispatchChannelTest::testRemoveAll() {
 
@@ -36,6 +36,7 @@ namespace core {
         CPPUNIT_TEST( testPeek );
         CPPUNIT_TEST( testDequeueNoWait );
         CPPUNIT_TEST( testDequeue );
+        CPPUNIT_TEST( testDequeueAll );
         CPPUNIT_TEST( testRemoveAll );
         CPPUNIT_TEST_SUITE_END();
 
@@ -53,6 +54,7 @@ namespace core {
         void testPeek();
         void testDequeueNoWait();
         void testDequeue();
+        void testDequeueAll();
         void testRemoveAll();
 
     };
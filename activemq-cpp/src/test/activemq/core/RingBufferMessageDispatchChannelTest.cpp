@@ -0,0 +1,385 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RingBufferMessageDispatchChannelTest.h"
+
+#include <activemq/core/RingBufferMessageDispatchChannel.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/ConsumerId.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class Producer : public Runnable {
+    private:
+
+        RingBufferMessageDispatchChannel* channel;
+        int producerId;
+        int count;
+
+    private:
+
+        Producer( const Producer& );
+        Producer& operator= ( const Producer& );
+
+    public:
+
+        Producer( RingBufferMessageDispatchChannel* channel, int producerId, int count ) :
+            Runnable(), channel( channel ), producerId( producerId ), count( count ) {
+        }
+
+        virtual ~Producer() {}
+
+        virtual void run() {
+            for( int i = 0; i < count; ++i ) {
+                Pointer<ConsumerId> id( new ConsumerId() );
+                id->setSessionId( producerId );
+                id->setValue( i );
+                Pointer<MessageDispatch> dispatch( new MessageDispatch() );
+                dispatch->setConsumerId( id );
+                channel->enqueue( dispatch );
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testCtor() {
+
+    RingBufferMessageDispatchChannel channel( 1000 );
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isClosed() == false );
+    CPPUNIT_ASSERT( channel.getCapacity() == 1024 );
+
+    RingBufferMessageDispatchChannel small( 0 );
+    CPPUNIT_ASSERT( small.getCapacity() == 16 );
+
+    RingBufferMessageDispatchChannel large( 32767 );
+    CPPUNIT_ASSERT( large.getCapacity() == 8192 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testStart() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testStop() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    channel.stop();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testClose() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    CPPUNIT_ASSERT( channel.isClosed() == false );
+    channel.close();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isClosed() == true );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isClosed() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testEnqueue() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+
+    channel.enqueue( dispatch1 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    channel.enqueue( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testEnqueueFront() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    channel.start();
+
+    channel.enqueue( dispatch3 );
+    channel.enqueueFirst( dispatch1 );
+    channel.enqueueFirst( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testPeek() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueueFirst( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.size() == 2 );
+    CPPUNIT_ASSERT( channel.peek() == NULL );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.peek() == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+    CPPUNIT_ASSERT( channel.peek() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.peek() == NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testDequeueNoWait() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch3 );
+
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testDequeue() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+
+    long long timeStarted = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( channel.dequeue( 1000 ) == NULL );
+
+    CPPUNIT_ASSERT( System::currentTimeMillis() - timeStarted >= 999 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.dequeue( -1 ) == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeue( 0 ) == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeue( 1000 ) == dispatch3 );
+
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testDequeueAll() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+    channel.enqueueFirst( dispatch1 );
+
+    std::vector< Pointer<MessageDispatch> > result;
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 0 ) == 0 );
+    CPPUNIT_ASSERT( result.empty() );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 2 ) == 2 );
+    CPPUNIT_ASSERT( result.size() == 2 );
+    CPPUNIT_ASSERT( result[0] == dispatch1 );
+    CPPUNIT_ASSERT( result[1] == dispatch2 );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 0 ) == 1 );
+    CPPUNIT_ASSERT( result.size() == 3 );
+    CPPUNIT_ASSERT( result[2] == dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 0 ) == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testRemoveAll() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+
+    std::vector< Pointer<MessageDispatch> > result = channel.removeAll();
+    CPPUNIT_ASSERT( result.size() == 3 );
+    CPPUNIT_ASSERT( result[0] == dispatch1 );
+    CPPUNIT_ASSERT( result[2] == dispatch3 );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testOverflow() {
+
+    RingBufferMessageDispatchChannel channel( 16 );
+    std::vector< Pointer<MessageDispatch> > dispatches;
+
+    for( int i = 0; i < 40; ++i ) {
+        dispatches.push_back( Pointer<MessageDispatch>( new MessageDispatch() ) );
+        channel.enqueue( dispatches.back() );
+    }
+
+    CPPUNIT_ASSERT( channel.size() == 40 );
+
+    channel.start();
+
+    // Free a few slots in the ring, later messages must still queue behind the overflow.
+    for( int i = 0; i < 4; ++i ) {
+        CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatches[i] );
+    }
+
+    for( int i = 40; i < 44; ++i ) {
+        dispatches.push_back( Pointer<MessageDispatch>( new MessageDispatch() ) );
+        channel.enqueue( dispatches.back() );
+    }
+
+    for( int i = 4; i < 44; ++i ) {
+        CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatches[i] );
+    }
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+
+    // With the overflow drained new messages use the ring again.
+    channel.enqueue( dispatches[0] );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatches[0] );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RingBufferMessageDispatchChannelTest::testConcurrentProducers() {
+
+    static const int PRODUCERS = 4;
+    static const int MESSAGES = 2000;
+
+    RingBufferMessageDispatchChannel channel( 64 );
+    channel.start();
+
+    std::vector<Producer*> producers;
+    std::vector<Thread*> threads;
+
+    for( int i = 0; i < PRODUCERS; ++i ) {
+        producers.push_back( new Producer( &channel, i, MESSAGES ) );
+        threads.push_back( new Thread( producers.back() ) );
+        threads.back()->start();
+    }
+
+    // Each producer's messages must arrive in the order that producer sent them.
+    std::vector<long long> expected( PRODUCERS, 0 );
+    int received = 0;
+
+    while( received < PRODUCERS * MESSAGES ) {
+        Pointer<MessageDispatch> dispatch = channel.dequeue( 5000 );
+        CPPUNIT_ASSERT( dispatch != NULL );
+
+        int producer = (int)dispatch->getConsumerId()->getSessionId();
+        CPPUNIT_ASSERT_EQUAL( expected[producer], dispatch->getConsumerId()->getValue() );
+        expected[producer]++;
+        received++;
+    }
+
+    for( int i = 0; i < PRODUCERS; ++i ) {
+        threads[i]->join();
+        delete threads[i];
+        delete producers[i];
+    }
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+}
@@ -19,6 +19,8 @@
 
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
 #include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageId.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/System.h>
 
@@ -28,6 +30,25 @@ using namespace activemq::commands;
 using namespace decaf;
 using namespace decaf::lang;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<MessageDispatch> createDispatch( int priority, long long sequence ) {
+
+        Pointer<Message> message( new Message() );
+        message->setPriority( (unsigned char)priority );
+
+        Pointer<MessageId> id( new MessageId() );
+        id->setProducerSequenceId( sequence );
+        message->setMessageId( id );
+
+        Pointer<MessageDispatch> dispatch( new MessageDispatch() );
+        dispatch->setMessage( message );
+
+        return dispatch;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void SimplePriorityMessageDispatchChannelTest::testCtor() {
 
@@ -284,3 +305,116 @@ void SimplePriorityMessageDispatchChannelTest::testRemoveAll() {
     CPPUNIT_ASSERT( channel.size() == 0 );
     CPPUNIT_ASSERT( channel.isEmpty() == true );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void SimplePriorityMessageDispatchChannelTest::testClear() {
+
+    SimplePriorityMessageDispatchChannel channel;
+
+    channel.enqueue( createDispatch( 4, 1 ) );
+    channel.enqueue( createDispatch( 7, 2 ) );
+
+    CPPUNIT_ASSERT( channel.size() == 2 );
+    channel.clear();
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+
+    Pointer<MessageDispatch> dispatch = createDispatch( 1, 3 );
+    channel.enqueue( dispatch );
+    CPPUNIT_ASSERT( channel.peek() == dispatch );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SimplePriorityMessageDispatchChannelTest::testDequeueAll() {
+
+    SimplePriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1 = createDispatch( 2, 1 );
+    Pointer<MessageDispatch> dispatch2 = createDispatch( 8, 2 );
+    Pointer<MessageDispatch> dispatch3 = createDispatch( 2, 3 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    std::vector< Pointer<MessageDispatch> > result;
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 0 ) == 0 );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 2 ) == 2 );
+    CPPUNIT_ASSERT( result[0] == dispatch2 );
+    CPPUNIT_ASSERT( result[1] == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueAll( result, 0 ) == 1 );
+    CPPUNIT_ASSERT( result[2] == dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SimplePriorityMessageDispatchChannelTest::testSinglePriorityOrdering() {
+
+    SimplePriorityMessageDispatchChannel channel;
+    channel.start();
+
+    // Enough messages to make the ring for the priority grow while it is wrapped.
+    for( int i = 0; i < 20; ++i ) {
+        channel.enqueue( createDispatch( 4, i ) );
+    }
+
+    for( int i = 0; i < 10; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( (long long)i,
+            channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    }
+
+    for( int i = 20; i < 100; ++i ) {
+        channel.enqueue( createDispatch( 4, i ) );
+    }
+
+    channel.enqueueFirst( createDispatch( 4, 9 ) );
+
+    CPPUNIT_ASSERT( channel.size() == 91 );
+
+    for( int i = 9; i < 100; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( (long long)i,
+            channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    }
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SimplePriorityMessageDispatchChannelTest::testMixedPriorityOrdering() {
+
+    SimplePriorityMessageDispatchChannel channel;
+    channel.start();
+
+    channel.enqueue( createDispatch( 4, 1 ) );
+    channel.enqueue( createDispatch( 9, 2 ) );
+    channel.enqueue( createDispatch( 0, 3 ) );
+    channel.enqueue( createDispatch( 4, 4 ) );
+    channel.enqueue( createDispatch( 9, 5 ) );
+
+    CPPUNIT_ASSERT_EQUAL( 2LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+
+    // A higher priority arriving while a lower one is being drained goes first.
+    channel.enqueue( createDispatch( 6, 6 ) );
+
+    CPPUNIT_ASSERT_EQUAL( 5LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( 6LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( 1LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( 4LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( 3LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+
+    // Priorities above the supported range are treated as the highest.
+    channel.enqueue( createDispatch( 5, 7 ) );
+    channel.enqueue( createDispatch( 42, 8 ) );
+    CPPUNIT_ASSERT_EQUAL( 8LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( 7LL, channel.dequeueNoWait()->getMessage()->getMessageId()->getProducerSequenceId() );
+}
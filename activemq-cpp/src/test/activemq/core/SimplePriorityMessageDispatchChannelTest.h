@@ -37,6 +37,10 @@ namespace core {
         CPPUNIT_TEST( testDequeueNoWait );
         CPPUNIT_TEST( testDequeue );
         CPPUNIT_TEST( testRemoveAll );
+        CPPUNIT_TEST( testClear );
+        CPPUNIT_TEST( testDequeueAll );
+        CPPUNIT_TEST( testSinglePriorityOrdering );
+        CPPUNIT_TEST( testMixedPriorityOrdering );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -54,6 +58,10 @@ namespace core {
         void testDequeueNoWait();
         void testDequeue();
         void testRemoveAll();
+        void testClear();
+        void testDequeueAll();
+        void testSinglePriorityOrdering();
+        void testMixedPriorityOrdering();
 
     };
 
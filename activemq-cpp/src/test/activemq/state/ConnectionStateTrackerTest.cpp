@@ -22,6 +22,8 @@
 #include <activemq/state/SessionState.h>
 #include <activemq/commands/ConnectionInfo.h>
 #include <activemq/commands/SessionInfo.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageId.h>
 #include <decaf/lang/Pointer.h>
 
 using namespace std;
@@ -70,3 +72,70 @@ void ConnectionStateTrackerTest::test() {
     tracker.processRemoveConnection( conn_id.get() );
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionStateTrackerTest::testMessageCacheIsBounded() {
+
+    Pointer<ProducerId> producer_id( new ProducerId );
+    producer_id->setConnectionId( "CONNECTION" );
+    producer_id->setSessionId( 12345 );
+    producer_id->setValue( 42 );
+
+    ConnectionStateTracker tracker;
+    tracker.setTrackMessages( true );
+
+    std::vector<unsigned char> content( 1024, 'a' );
+    long long messageSize = 0;
+
+    for( int i = 0; i < 1000; ++i ) {
+
+        Pointer<MessageId> message_id( new MessageId );
+        message_id->setProducerId( producer_id );
+        message_id->setProducerSequenceId( i );
+
+        Pointer<Message> message( new Message );
+        message->setProducerId( producer_id );
+        message->setMessageId( message_id );
+        message->setContent( content );
+        messageSize = message->getSize();
+
+        tracker.track( message );
+
+        CPPUNIT_ASSERT( tracker.getCurrentCacheSize() <= tracker.getMaxCacheSize() );
+    }
+
+    // The cache is full, holding as many of the most recent messages as will fit.
+    CPPUNIT_ASSERT_EQUAL( ( tracker.getMaxCacheSize() / messageSize ) * messageSize,
+                          tracker.getCurrentCacheSize() );
+
+    // Shrinking the cache evicts the eldest messages straight away.
+    tracker.setMaxCacheSize( (int)( messageSize * 10 ) );
+    CPPUNIT_ASSERT_EQUAL( messageSize * 10, tracker.getCurrentCacheSize() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionStateTrackerTest::testMessageCacheCountsProperties() {
+
+    Pointer<ProducerId> producer_id( new ProducerId );
+    producer_id->setConnectionId( "CONNECTION" );
+    producer_id->setSessionId( 12345 );
+    producer_id->setValue( 42 );
+
+    Pointer<MessageId> message_id( new MessageId );
+    message_id->setProducerId( producer_id );
+
+    Pointer<Message> message( new Message );
+    message->setProducerId( producer_id );
+    message->setMessageId( message_id );
+    message->getMessageProperties().setString( "property", std::string( 512, 'a' ) );
+
+    unsigned int unmarshaledSize = message->getSize();
+
+    ConnectionStateTracker tracker;
+    tracker.setTrackMessages( true );
+    tracker.track( message );
+
+    // The message is cached with the size it has once its properties are marshaled.
+    CPPUNIT_ASSERT( message->getSize() > unmarshaledSize + 512 );
+    CPPUNIT_ASSERT_EQUAL( (long long)message->getSize(), tracker.getCurrentCacheSize() );
+}
@@ -28,6 +28,8 @@ namespace state {
 
         CPPUNIT_TEST_SUITE( ConnectionStateTrackerTest );
         CPPUNIT_TEST( test );
+        CPPUNIT_TEST( testMessageCacheIsBounded );
+        CPPUNIT_TEST( testMessageCacheCountsProperties );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -36,6 +38,8 @@ namespace state {
         virtual ~ConnectionStateTrackerTest() {}
 
         void test();
+        void testMessageCacheIsBounded();
+        void testMessageCacheCountsProperties();
     };
 
 }}
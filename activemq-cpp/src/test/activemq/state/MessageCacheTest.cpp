@@ -0,0 +1,220 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageCacheTest.h"
+
+#include <activemq/state/MessageCache.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <decaf/lang/Pointer.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::state;
+using namespace activemq::commands;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<MessageId> createMessageId( long long sequence ) {
+
+        Pointer<ProducerId> producerId( new ProducerId );
+        producerId->setConnectionId( "CONNECTION" );
+        producerId->setSessionId( 1 );
+        producerId->setValue( 1 );
+
+        Pointer<MessageId> id( new MessageId );
+        id->setProducerId( producerId );
+        id->setProducerSequenceId( sequence );
+
+        return id;
+    }
+
+    Pointer<Command> createMessage( const Pointer<MessageId>& id ) {
+
+        Pointer<Message> message( new Message );
+        message->setMessageId( id );
+
+        return message;
+    }
+
+    long long sequenceOf( const Pointer<Command>& command ) {
+        return command.dynamicCast<Message>()->getMessageId()->getProducerSequenceId();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCacheTest::testPut() {
+
+    MessageCache cache( 1000 );
+
+    for( long long i = 0; i < 5; ++i ) {
+        Pointer<MessageId> id = createMessageId( i );
+        cache.put( id, createMessage( id ), 100 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 5, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 500LL, cache.getCurrentSize() );
+
+    std::vector< Pointer<Command> > values = cache.values();
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)5, values.size() );
+
+    for( long long i = 0; i < 5; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i, sequenceOf( values[(std::size_t)i] ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCacheTest::testPutEvictsEldest() {
+
+    MessageCache cache( 1000 );
+
+    for( long long i = 0; i < 100; ++i ) {
+        Pointer<MessageId> id = createMessageId( i );
+        cache.put( id, createMessage( id ), 100 );
+        CPPUNIT_ASSERT( cache.getCurrentSize() <= 1000 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 10, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 1000LL, cache.getCurrentSize() );
+
+    // Only the most recent messages remain, still in the order they were added.
+    std::vector< Pointer<Command> > values = cache.values();
+    for( std::size_t i = 0; i < values.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL( (long long)( 90 + i ), sequenceOf( values[i] ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCacheTest::testPutLargerThanMaxSize() {
+
+    MessageCache cache( 1000 );
+
+    for( long long i = 0; i < 5; ++i ) {
+        Pointer<MessageId> id = createMessageId( i );
+        cache.put( id, createMessage( id ), 100 );
+    }
+
+    // A message larger than the cache evicts everything else but is kept itself.
+    Pointer<MessageId> id = createMessageId( 5 );
+    cache.put( id, createMessage( id ), 2000 );
+    CPPUNIT_ASSERT_EQUAL( 1, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 2000LL, cache.getCurrentSize() );
+    CPPUNIT_ASSERT_EQUAL( 5LL, sequenceOf( cache.values()[0] ) );
+
+    // Until the next message is added.
+    id = createMessageId( 6 );
+    cache.put( id, createMessage( id ), 100 );
+    CPPUNIT_ASSERT_EQUAL( 1, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 100LL, cache.getCurrentSize() );
+    CPPUNIT_ASSERT_EQUAL( 6LL, sequenceOf( cache.values()[0] ) );
+
+    // Shrinking the cache below the newest message still leaves that message.
+    cache.setMaxSize( 50 );
+    CPPUNIT_ASSERT_EQUAL( 1, cache.size() );
+    CPPUNIT_ASSERT( cache.remove( createMessageId( 6 ) ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCacheTest::testPutReplaces() {
+
+    MessageCache cache( 1000 );
+
+    Pointer<MessageId> id1 = createMessageId( 1 );
+    Pointer<MessageId> id2 = createMessageId( 2 );
+
+    cache.put( id1, createMessage( id1 ), 100 );
+    cache.put( id2, createMessage( id2 ), 100 );
+
+    // The same id given again replaces the entry and moves it to the end.
+    cache.put( createMessageId( 1 ), createMessage( id1 ), 300 );
+
+    CPPUNIT_ASSERT_EQUAL( 2, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 400LL, cache.getCurrentSize() );
+
+    std::vector< Pointer<Command> > values = cache.values();
+    CPPUNIT_ASSERT_EQUAL( 2LL, sequenceOf( values[0] ) );
+    CPPUNIT_ASSERT_EQUAL( 1LL, sequenceOf( values[1] ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCacheTest::testRemove() {
+
+    MessageCache cache( 1000 );
+
+    for( long long i = 0; i < 3; ++i ) {
+        Pointer<MessageId> id = createMessageId( i );
+        cache.put( id, createMessage( id ), 100 );
+    }
+
+    CPPUNIT_ASSERT( cache.remove( createMessageId( 1 ) ) );
+    CPPUNIT_ASSERT( !cache.remove( createMessageId( 1 ) ) );
+
+    CPPUNIT_ASSERT_EQUAL( 2, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 200LL, cache.getCurrentSize() );
+
+    std::vector< Pointer<Command> > values = cache.values();
+    CPPUNIT_ASSERT_EQUAL( 0LL, sequenceOf( values[0] ) );
+    CPPUNIT_ASSERT_EQUAL( 2LL, sequenceOf( values[1] ) );
+
+    // Removing the eldest and newest keeps the list intact.
+    CPPUNIT_ASSERT( cache.remove( createMessageId( 0 ) ) );
+    CPPUNIT_ASSERT( cache.remove( createMessageId( 2 ) ) );
+    CPPUNIT_ASSERT_EQUAL( 0, cache.size() );
+    CPPUNIT_ASSERT( cache.values().empty() );
+
+    Pointer<MessageId> id = createMessageId( 3 );
+    cache.put( id, createMessage( id ), 100 );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)1, cache.values().size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCacheTest::testSetMaxSize() {
+
+    MessageCache cache( 1000 );
+    CPPUNIT_ASSERT_EQUAL( 1000LL, cache.getMaxSize() );
+
+    for( long long i = 0; i < 10; ++i ) {
+        Pointer<MessageId> id = createMessageId( i );
+        cache.put( id, createMessage( id ), 100 );
+    }
+
+    cache.setMaxSize( 350 );
+    CPPUNIT_ASSERT_EQUAL( 350LL, cache.getMaxSize() );
+    CPPUNIT_ASSERT_EQUAL( 3, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 300LL, cache.getCurrentSize() );
+    CPPUNIT_ASSERT_EQUAL( 7LL, sequenceOf( cache.values()[0] ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageCacheTest::testClear() {
+
+    MessageCache cache( 1000 );
+
+    for( long long i = 0; i < 5; ++i ) {
+        Pointer<MessageId> id = createMessageId( i );
+        cache.put( id, createMessage( id ), 100 );
+    }
+
+    cache.clear();
+    CPPUNIT_ASSERT_EQUAL( 0, cache.size() );
+    CPPUNIT_ASSERT_EQUAL( 0LL, cache.getCurrentSize() );
+    CPPUNIT_ASSERT( cache.values().empty() );
+    CPPUNIT_ASSERT( !cache.remove( createMessageId( 1 ) ) );
+}
@@ -0,0 +1,186 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledTaskRunnerTest.h"
+
+#include <memory>
+
+#include <activemq/threads/Task.h>
+#include <activemq/threads/PooledTaskRunner.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingTask : public Task {
+    private:
+
+        AtomicInteger count;
+        bool infinite;
+
+    public:
+
+        CountingTask( bool infinite ) : count(), infinite( infinite ) {}
+        virtual ~CountingTask() {}
+
+        virtual bool iterate() {
+
+            count.incrementAndGet();
+            return infinite;
+        }
+
+        int getCount() const { return count.get(); }
+    };
+
+    // Counts the number of threads that are iterating it at the same time.
+    class OverlapTask : public Task {
+    private:
+
+        AtomicInteger active;
+        AtomicInteger overlaps;
+        AtomicInteger count;
+
+    public:
+
+        OverlapTask() : active(), overlaps(), count() {}
+        virtual ~OverlapTask() {}
+
+        virtual bool iterate() {
+
+            if( active.incrementAndGet() > 1 ) {
+                overlaps.incrementAndGet();
+            }
+
+            Thread::yield();
+            count.incrementAndGet();
+            active.decrementAndGet();
+
+            return false;
+        }
+
+        int getOverlaps() const { return overlaps.get(); }
+        int getCount() const { return count.get(); }
+    };
+
+    Pointer<ExecutorService> createPool( int size ) {
+        return Pointer<ExecutorService>( new ThreadPoolExecutor(
+            size, size, 5, TimeUnit::SECONDS, new LinkedBlockingQueue<Runnable*>() ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testSimple() {
+
+    Pointer<ExecutorService> executor = createPool( 2 );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        std::auto_ptr<TaskRunner>( new PooledTaskRunner( executor, NULL, 10 ) ),
+        NullPointerException );
+
+    CountingTask simpleTask( false );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        std::auto_ptr<TaskRunner>( new PooledTaskRunner( executor, &simpleTask, 0 ) ),
+        IllegalArgumentException );
+
+    CPPUNIT_ASSERT( simpleTask.getCount() == 0 );
+    PooledTaskRunner simpleTaskRunner( executor, &simpleTask, 10 );
+
+    simpleTaskRunner.wakeup();
+    Thread::sleep( 250 );
+    CPPUNIT_ASSERT( simpleTask.getCount() >= 1 );
+    simpleTaskRunner.wakeup();
+    Thread::sleep( 250 );
+    CPPUNIT_ASSERT( simpleTask.getCount() >= 2 );
+
+    CountingTask infiniteTask( true );
+    PooledTaskRunner infiniteTaskRunner( executor, &infiniteTask, 10 );
+    infiniteTaskRunner.wakeup();
+    Thread::sleep( 500 );
+    CPPUNIT_ASSERT( infiniteTask.getCount() != 0 );
+    infiniteTaskRunner.shutdown();
+    int count = infiniteTask.getCount();
+    Thread::sleep( 250 );
+    CPPUNIT_ASSERT( infiniteTask.getCount() == count );
+
+    executor->shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testSharedPool() {
+
+    // Two busy tasks sharing a single thread must both make progress.
+    Pointer<ExecutorService> executor = createPool( 1 );
+
+    CountingTask task1( true );
+    CountingTask task2( true );
+
+    PooledTaskRunner runner1( executor, &task1, 100 );
+    PooledTaskRunner runner2( executor, &task2, 100 );
+
+    runner1.wakeup();
+    runner2.wakeup();
+    Thread::sleep( 500 );
+
+    runner1.shutdown();
+    runner2.shutdown();
+
+    CPPUNIT_ASSERT( task1.getCount() > 0 );
+    CPPUNIT_ASSERT( task2.getCount() > 0 );
+
+    executor->shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testSerialIteration() {
+
+    // Wakeups from many threads never cause the task to be iterated concurrently
+    // even though the pool has threads to spare.
+    Pointer<ExecutorService> executor = createPool( 4 );
+
+    OverlapTask task;
+    PooledTaskRunner runner( executor, &task, 10 );
+
+    for( int i = 0; i < 1000; ++i ) {
+        runner.wakeup();
+    }
+
+    Thread::sleep( 250 );
+    runner.shutdown();
+
+    CPPUNIT_ASSERT( task.getCount() > 0 );
+    CPPUNIT_ASSERT_EQUAL( 0, task.getOverlaps() );
+
+    executor->shutdown();
+}
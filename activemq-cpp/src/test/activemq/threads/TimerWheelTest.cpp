@@ -0,0 +1,339 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimerWheelTest.h"
+
+#include <activemq/threads/TimerWheel.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace activemq;
+using namespace activemq::threads;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CounterTask : public Runnable {
+    private:
+
+        AtomicInteger count;
+
+    public:
+
+        CounterTask() : count(0) {
+        }
+
+        virtual ~CounterTask() {}
+
+        int getCount() const {
+            return count.get();
+        }
+
+        virtual void run() {
+            count.incrementAndGet();
+        }
+
+    };
+
+    class SlowTask : public Runnable {
+    private:
+
+        CountDownLatch started;
+        AtomicInteger finished;
+
+    private:
+
+        SlowTask(const SlowTask&);
+        SlowTask& operator= (const SlowTask&);
+
+    public:
+
+        SlowTask() : started(1), finished(0) {
+        }
+
+        virtual ~SlowTask() {}
+
+        bool awaitStarted() {
+            return started.await(2000);
+        }
+
+        int getFinished() const {
+            return finished.get();
+        }
+
+        virtual void run() {
+            started.countDown();
+            Thread::sleep(500);
+            finished.incrementAndGet();
+        }
+
+    };
+
+    class CancelingTask : public Runnable {
+    private:
+
+        CancelingTask(const CancelingTask&);
+        CancelingTask& operator= (const CancelingTask&);
+
+    public:
+
+        TimerWheel* wheel;
+        SlowTask* target;
+        CountDownLatch done;
+        int finishedWhenCanceled;
+
+        CancelingTask(TimerWheel* wheel, SlowTask* target) :
+            wheel(wheel), target(target), done(1), finishedWhenCanceled(-1) {
+        }
+
+        virtual ~CancelingTask() {}
+
+        virtual void run() {
+            wheel->cancel(target);
+            finishedWhenCanceled = target->getFinished();
+            done.countDown();
+        }
+
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerWheelTest::TimerWheelTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerWheelTest::~TimerWheelTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testConstructor() {
+
+    TimerWheel wheel("testConstructor", 10, 100, 3);
+    CPPUNIT_ASSERT_EQUAL(10LL, wheel.getTickDuration());
+    CPPUNIT_ASSERT_EQUAL(3, wheel.getWorkerCount());
+    CPPUNIT_ASSERT_EQUAL(0, wheel.getPendingCount());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        TimerWheel(""),
+        IllegalArgumentException);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        TimerWheel("testConstructor", 0),
+        IllegalArgumentException);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        TimerWheel("testConstructor", 10, 0),
+        IllegalArgumentException);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        TimerWheel("testConstructor", 10, 512, 0),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testScheduleNullRunnableThrows() {
+
+    TimerWheel wheel("testScheduleNullRunnableThrows");
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a NullPointerException",
+        wheel.schedule(NULL, 400),
+        NullPointerException);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a NullPointerException",
+        wheel.scheduleAtFixedRate(NULL, 0, 400),
+        NullPointerException);
+
+    CounterTask task;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        wheel.schedule(&task, -1, false),
+        IllegalArgumentException);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        wheel.scheduleAtFixedRate(&task, 0, 0, false),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testScheduleTwiceThrows() {
+
+    TimerWheel wheel("testScheduleTwiceThrows");
+
+    CounterTask task;
+    wheel.schedule(&task, 1000, false);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalStateException",
+        wheel.schedule(&task, 1000, false),
+        IllegalStateException);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalStateException",
+        wheel.scheduleAtFixedRate(&task, 1000, 1000, false),
+        IllegalStateException);
+
+    CPPUNIT_ASSERT(wheel.cancel(&task));
+    wheel.schedule(&task, 1000, false);
+    CPPUNIT_ASSERT(wheel.cancel(&task));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testSchedule() {
+
+    TimerWheel wheel("testSchedule");
+
+    CounterTask task;
+    wheel.schedule(&task, 500, false);
+    CPPUNIT_ASSERT_EQUAL(1, wheel.getPendingCount());
+    CPPUNIT_ASSERT_EQUAL(0, task.getCount());
+    Thread::sleep(700);
+    CPPUNIT_ASSERT_EQUAL(1, task.getCount());
+    CPPUNIT_ASSERT_EQUAL(0, wheel.getPendingCount());
+    Thread::sleep(600);
+    CPPUNIT_ASSERT_EQUAL(1, task.getCount());
+
+    // Once run a task can be scheduled again.
+    wheel.schedule(&task, 0, false);
+    Thread::sleep(200);
+    CPPUNIT_ASSERT_EQUAL(2, task.getCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testScheduleAtFixedRate() {
+
+    TimerWheel wheel("testScheduleAtFixedRate");
+
+    CounterTask* task = new CounterTask();
+    wheel.scheduleAtFixedRate(task, 500, 500);
+    CPPUNIT_ASSERT(task->getCount() == 0);
+    Thread::sleep(700);
+    CPPUNIT_ASSERT(task->getCount() >= 1);
+    Thread::sleep(600);
+    CPPUNIT_ASSERT(task->getCount() >= 2);
+    CPPUNIT_ASSERT(task->getCount() < 5);
+    CPPUNIT_ASSERT_EQUAL(1, wheel.getPendingCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testLongDelay() {
+
+    // Eight buckets of 10ms, the delay has to go around the wheel several times.
+    TimerWheel wheel("testLongDelay", 10, 8, 1);
+
+    CounterTask task;
+    wheel.schedule(&task, 500, false);
+    Thread::sleep(300);
+    CPPUNIT_ASSERT_EQUAL(0, task.getCount());
+    Thread::sleep(400);
+    CPPUNIT_ASSERT_EQUAL(1, task.getCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testCancel() {
+
+    TimerWheel wheel("testCancel");
+
+    CounterTask task;
+    CPPUNIT_ASSERT(!wheel.cancel(&task));
+
+    wheel.scheduleAtFixedRate(&task, 100, 100, false);
+    Thread::sleep(350);
+    CPPUNIT_ASSERT(wheel.cancel(&task));
+    CPPUNIT_ASSERT(!wheel.cancel(&task));
+    CPPUNIT_ASSERT_EQUAL(0, wheel.getPendingCount());
+
+    int count = task.getCount();
+    CPPUNIT_ASSERT(count >= 1);
+    Thread::sleep(300);
+    CPPUNIT_ASSERT_EQUAL(count, task.getCount());
+
+    CounterTask* owned = new CounterTask();
+    wheel.schedule(owned, 1000);
+    CPPUNIT_ASSERT(wheel.cancel(owned));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testCancelWaitsForRunningTask() {
+
+    TimerWheel wheel("testCancelWaitsForRunningTask");
+
+    SlowTask task;
+    wheel.scheduleAtFixedRate(&task, 0, 100, false);
+    CPPUNIT_ASSERT(task.awaitStarted());
+
+    CPPUNIT_ASSERT(wheel.cancel(&task));
+    CPPUNIT_ASSERT_EQUAL(1, task.getFinished());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testCancelFromTaskDoesNotWait() {
+
+    TimerWheel wheel("testCancelFromTaskDoesNotWait", 10, 64, 2);
+
+    SlowTask task;
+    CancelingTask canceler(&wheel, &task);
+
+    wheel.scheduleAtFixedRate(&task, 0, 100, false);
+    CPPUNIT_ASSERT(task.awaitStarted());
+
+    // Runs on the other worker while the slow task is still running.
+    wheel.schedule(&canceler, 0, false);
+    CPPUNIT_ASSERT(canceler.done.await(2000));
+    CPPUNIT_ASSERT_EQUAL(0, canceler.finishedWhenCanceled);
+
+    // Let the slow task finish before it is destroyed.
+    wheel.cancel(&task);
+    CPPUNIT_ASSERT_EQUAL(1, task.getFinished());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerWheelTest::testManyTasks() {
+
+    static const int COUNT = 1000;
+
+    TimerWheel wheel("testManyTasks", 10, 64, 2);
+
+    std::vector<CounterTask*> tasks;
+    for(int i = 0; i < COUNT; ++i) {
+        CounterTask* task = new CounterTask();
+        tasks.push_back(task);
+        wheel.schedule(task, i % 500, false);
+    }
+
+    Thread::sleep(1000);
+    CPPUNIT_ASSERT_EQUAL(0, wheel.getPendingCount());
+
+    for(int i = 0; i < COUNT; ++i) {
+        CPPUNIT_ASSERT_EQUAL(1, tasks[i]->getCount());
+        delete tasks[i];
+    }
+}
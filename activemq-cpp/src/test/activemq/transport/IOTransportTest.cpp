@@ -22,12 +22,14 @@
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/commands/BaseCommand.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/io/BufferedInputStream.h>
 #include <decaf/io/BufferedOutputStream.h>
 #include <decaf/io/BlockingByteArrayInputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
 #include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Exception.h>
@@ -343,6 +345,287 @@ void IOTransportTest::testWrite(){
     transport.close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CoalescingSender : public decaf::lang::Runnable {
+    private:
+
+        IOTransport* transport;
+        char value;
+        int count;
+
+    private:
+
+        CoalescingSender( const CoalescingSender& );
+        CoalescingSender& operator= ( const CoalescingSender& );
+
+    public:
+
+        CoalescingSender( IOTransport* transport, char value, int count ) :
+            Runnable(), transport( transport ), value( value ), count( count ) {}
+
+        virtual ~CoalescingSender() {}
+
+        virtual void run() {
+            for( int i = 0; i < count; ++i ) {
+                Pointer<MyCommand> cmd( new MyCommand() );
+                cmd->c = value;
+                transport->oneway( cmd );
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testWriteCoalescing(){
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<MyWireFormat> wireFormat( new MyWireFormat() );
+    MyTransportListener listener;
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setWriteCoalescing( true );
+    transport.setWriteCoalescingMaxDelay( 1 );
+
+    transport.start();
+
+    Pointer<MyCommand> cmd( new MyCommand() );
+    cmd->c = '1';
+    transport.oneway( cmd );
+    cmd->c = '2';
+    transport.oneway( cmd );
+    cmd->c = '3';
+    transport.oneway( cmd );
+
+    CPPUNIT_ASSERT_EQUAL( 3LL, os.size() );
+
+    std::pair<const unsigned char*, int> array = os.toByteArray();
+    CPPUNIT_ASSERT( array.first[0] == '1' );
+    CPPUNIT_ASSERT( array.first[1] == '2' );
+    CPPUNIT_ASSERT( array.first[2] == '3' );
+    delete [] array.first;
+
+    os.reset();
+
+    const int NUM_SENDERS = 4;
+    const int NUM_SENDS = 250;
+
+    CoalescingSender sender1( &transport, 'a', NUM_SENDS );
+    CoalescingSender sender2( &transport, 'b', NUM_SENDS );
+    CoalescingSender sender3( &transport, 'c', NUM_SENDS );
+    CoalescingSender sender4( &transport, 'd', NUM_SENDS );
+
+    decaf::lang::Thread thread1( &sender1 );
+    decaf::lang::Thread thread2( &sender2 );
+    decaf::lang::Thread thread3( &sender3 );
+    decaf::lang::Thread thread4( &sender4 );
+
+    thread1.start();
+    thread2.start();
+    thread3.start();
+    thread4.start();
+
+    thread1.join();
+    thread2.join();
+    thread3.join();
+    thread4.join();
+
+    // Each sender only returns once the batch holding its frame was written, so
+    // every frame has been written by the time all the senders have returned.
+    CPPUNIT_ASSERT_EQUAL( (long long)( NUM_SENDERS * NUM_SENDS ), os.size() );
+
+    transport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testAsyncWriter(){
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<MyWireFormat> wireFormat( new MyWireFormat() );
+    MyTransportListener listener;
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setAsyncWriterQueueSize( 16 );
+    transport.setAsyncWriter( true );
+
+    transport.start();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException once started",
+        transport.setAsyncWriter( false ),
+        decaf::lang::exceptions::IllegalStateException );
+
+    const int NUM_SENDERS = 4;
+    const int NUM_SENDS = 250;
+    const long long EXPECTED = NUM_SENDERS * NUM_SENDS;
+
+    CoalescingSender sender1( &transport, 'a', NUM_SENDS );
+    CoalescingSender sender2( &transport, 'b', NUM_SENDS );
+    CoalescingSender sender3( &transport, 'c', NUM_SENDS );
+    CoalescingSender sender4( &transport, 'd', NUM_SENDS );
+
+    decaf::lang::Thread thread1( &sender1 );
+    decaf::lang::Thread thread2( &sender2 );
+    decaf::lang::Thread thread3( &sender3 );
+    decaf::lang::Thread thread4( &sender4 );
+
+    thread1.start();
+    thread2.start();
+    thread3.start();
+    thread4.start();
+
+    thread1.join();
+    thread2.join();
+    thread3.join();
+    thread4.join();
+
+    // Writes complete on the writer thread so give it a chance to drain.
+    long long written = 0;
+    for( int i = 0; i < 100 && written < EXPECTED; ++i ) {
+        synchronized( &output ) {
+            written = os.size();
+        }
+        if( written < EXPECTED ) {
+            decaf::lang::Thread::sleep( 50 );
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL( EXPECTED, written );
+
+    transport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testAsyncWriterDrainsOnClose(){
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<MyWireFormat> wireFormat( new MyWireFormat() );
+    MyTransportListener listener;
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setAsyncWriter( true );
+
+    transport.start();
+
+    const int NUM_SENDS = 500;
+
+    for( int i = 0; i < NUM_SENDS; ++i ) {
+        Pointer<MyCommand> cmd( new MyCommand() );
+        cmd->c = 'a';
+        transport.oneway( cmd );
+    }
+
+    // Everything queued before the close is written before the writer exits.
+    transport.close();
+
+    CPPUNIT_ASSERT_EQUAL( (long long)NUM_SENDS, os.size() );
+
+    Pointer<MyCommand> cmd( new MyCommand() );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException once closed",
+        transport.oneway( cmd ),
+        IOException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Reads frames that carry an OpenWire style size prefix ahead of the single byte body.
+    class SizePrefixedWireFormat : public MyWireFormat {
+    public:
+
+        virtual ~SizePrefixedWireFormat() {}
+
+        virtual Pointer<commands::Command> unmarshal( const activemq::transport::Transport* transport AMQCPP_UNUSED,
+                                                      decaf::io::DataInputStream* inputStream )
+            throw ( IOException ){
+
+            Pointer<MyCommand> command( new MyCommand() );
+
+            try{
+                CPPUNIT_ASSERT_EQUAL( 1, inputStream->readInt() );
+                command->c = inputStream->readByte();
+            } catch( decaf::lang::Exception& ex ){
+                ex.setMark( __FILE__, __LINE__ );
+                throw IOException( ex );
+            }
+
+            return command;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testNonBlockingRead(){
+
+    decaf::io::ByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<SizePrefixedWireFormat> wireFormat( new SizePrefixedWireFormat() );
+    MyTransportListener listener;
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setNonBlockingRead( true );
+
+    transport.start();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException once started",
+        transport.setNonBlockingRead( false ),
+        decaf::lang::exceptions::IllegalStateException );
+
+    unsigned char frames[15] = { 0, 0, 0, 1, 'a', 0, 0, 0, 1, 'b', 0, 0, 0, 1, 'c' };
+
+    // The second frame is split across reads and is held until it is complete.
+    is.setByteArray( frames, 7 );
+    CPPUNIT_ASSERT( transport.readAvailable() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "a" ), listener.str );
+
+    is.setByteArray( frames + 7, 8 );
+    CPPUNIT_ASSERT( transport.readAvailable() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "abc" ), listener.str );
+
+    // Commands can still be sent without a reader thread.
+    Pointer<MyCommand> cmd( new MyCommand() );
+    cmd->c = '1';
+    transport.oneway( cmd );
+    CPPUNIT_ASSERT_EQUAL( 1LL, (long long)os.size() );
+
+    // Nothing left to read looks like the peer closing the connection.
+    CPPUNIT_ASSERT( !transport.readAvailable() );
+    CPPUNIT_ASSERT( listener.caughtOne );
+
+    transport.close();
+    CPPUNIT_ASSERT( !transport.readAvailable() );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransportTest::testException(){
 
@@ -32,6 +32,10 @@ namespace transport{
         CPPUNIT_TEST( testStressTransportStartClose );
         CPPUNIT_TEST( testRead );
         CPPUNIT_TEST( testWrite );
+        CPPUNIT_TEST( testWriteCoalescing );
+        CPPUNIT_TEST( testAsyncWriter );
+        CPPUNIT_TEST( testAsyncWriterDrainsOnClose );
+        CPPUNIT_TEST( testNonBlockingRead );
         CPPUNIT_TEST( testException );
         CPPUNIT_TEST( testNarrow );
         CPPUNIT_TEST_SUITE_END();
@@ -42,6 +46,10 @@ namespace transport{
 
         void testException();
         void testWrite();
+        void testWriteCoalescing();
+        void testAsyncWriter();
+        void testAsyncWriterDrainsOnClose();
+        void testNonBlockingRead();
         void testRead();
         void testStartClose();
         void testStressTransportStartClose();
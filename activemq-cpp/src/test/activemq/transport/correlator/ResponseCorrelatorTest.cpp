@@ -24,8 +24,10 @@
 #include <activemq/transport/correlator/ResponseCorrelator.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <queue>
+#include <set>
 
 using namespace activemq;
 using namespace activemq::transport;
@@ -103,6 +105,14 @@ namespace correlator{
                 __FILE__, __LINE__, "stuff" );
         }
 
+        virtual void asyncRequest( const Pointer<Command>& command AMQCPP_UNUSED,
+                                   const Pointer<ResponseCallback>& responseCallback AMQCPP_UNUSED,
+                                   unsigned int timeout AMQCPP_UNUSED )
+        {
+            throw decaf::lang::exceptions::UnsupportedOperationException(
+                __FILE__, __LINE__, "stuff" );
+        }
+
         virtual Pointer<wireformat::WireFormat> getWireFormat() const {
             return Pointer<wireformat::WireFormat>();
         }
@@ -258,6 +268,45 @@ namespace correlator{
         }
     };
 
+    class MySilentTransport : public MyTransport{
+    public:
+
+        MySilentTransport(){}
+        virtual ~MySilentTransport(){}
+
+        virtual Pointer<Response> createResponse( const Pointer<Command>& command AMQCPP_UNUSED ){
+            return Pointer<Response>();
+        }
+    };
+
+    class MyResponseCallback : public ResponseCallback {
+    public:
+
+        decaf::util::concurrent::CountDownLatch done;
+        decaf::util::concurrent::Mutex mutex;
+        std::set<int> correlationIds;
+        int exCount;
+
+    public:
+
+        MyResponseCallback( int count ) : done( count ), mutex(), correlationIds(), exCount( 0 ) {}
+        virtual ~MyResponseCallback(){}
+
+        virtual void onResponse( const Pointer<Response>& response ){
+            synchronized( &mutex ){
+                correlationIds.insert( response->getCorrelationId() );
+            }
+            done.countDown();
+        }
+
+        virtual void onException( const decaf::lang::Exception& ex AMQCPP_UNUSED ){
+            synchronized( &mutex ){
+                exCount++;
+            }
+            done.countDown();
+        }
+    };
+
     class MyListener : public DefaultTransportListener {
     public:
 
@@ -290,6 +339,39 @@ namespace correlator{
 
     };
 
+    class AsyncRequestThread : public decaf::lang::Thread{
+    public:
+
+        Transport* transport;
+        Pointer<MyResponseCallback> callback;
+        int issued;
+        int rejected;
+
+    public:
+
+        AsyncRequestThread( Transport* transport, const Pointer<MyResponseCallback>& callback ) :
+            Thread(), transport( transport ), callback( callback ), issued( 0 ), rejected( 0 ) {
+        }
+
+        virtual ~AsyncRequestThread(){}
+
+        void run(){
+
+            // Keep issuing requests with short timeouts until the transport is closed,
+            // a request is either rejected or its callback is told exactly once.
+            while( true ){
+                issued++;
+                try{
+                    transport->asyncRequest(
+                        Pointer<MyCommand>( new MyCommand() ), callback, issued % 2 == 0 ? 0 : 5 );
+                } catch( IOException& ex ) {
+                    rejected++;
+                    return;
+                }
+            }
+        }
+    };
+
     class RequestThread : public decaf::lang::Thread{
     public:
 
@@ -536,3 +618,186 @@ void ResponseCorrelatorTest::testNarrow(){
     CPPUNIT_ASSERT( narrowed == &correlator );
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelatorTest::testAsyncRequest(){
+
+    MyListener listener;
+    Pointer<MyTransport> transport( new MyTransport() );
+    ResponseCorrelator correlator( transport );
+    correlator.setTransportListener( &listener );
+
+    synchronized( &(transport->startedMutex) ) {
+        correlator.start();
+        transport->startedMutex.wait();
+    }
+
+    // Issue all the requests from this thread before any response is seen.
+    const int numRequests = 100;
+    Pointer<MyResponseCallback> callback( new MyResponseCallback( numRequests ) );
+    std::set<int> commandIds;
+
+    for( int ix = 0; ix < numRequests; ++ix ) {
+        Pointer<MyCommand> command( new MyCommand() );
+        correlator.asyncRequest( command, callback, 0 );
+        CPPUNIT_ASSERT( command->isResponseRequired() );
+        commandIds.insert( command->getCommandId() );
+    }
+
+    CPPUNIT_ASSERT( callback->done.await( 5000 ) );
+    CPPUNIT_ASSERT_EQUAL( 0, callback->exCount );
+    CPPUNIT_ASSERT( callback->correlationIds == commandIds );
+
+    correlator.close();
+    CPPUNIT_ASSERT_EQUAL( 0, callback->exCount );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelatorTest::testAsyncRequestTimeout(){
+
+    MyListener listener;
+    Pointer<MySilentTransport> transport( new MySilentTransport() );
+    ResponseCorrelator correlator( transport );
+    correlator.setTransportListener( &listener );
+
+    synchronized( &(transport->startedMutex) ) {
+        correlator.start();
+        transport->startedMutex.wait();
+    }
+
+    Pointer<MyResponseCallback> callback( new MyResponseCallback( 1 ) );
+    correlator.asyncRequest( Pointer<MyCommand>( new MyCommand() ), callback, 100 );
+
+    CPPUNIT_ASSERT( callback->done.await( 5000 ) );
+    CPPUNIT_ASSERT_EQUAL( 1, callback->exCount );
+    CPPUNIT_ASSERT( callback->correlationIds.empty() );
+
+    // Closing must not report the expired request a second time.
+    correlator.close();
+    CPPUNIT_ASSERT_EQUAL( 1, callback->exCount );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelatorTest::testAsyncRequestFailedOnClose(){
+
+    MyListener listener;
+    Pointer<MySilentTransport> transport( new MySilentTransport() );
+    ResponseCorrelator correlator( transport );
+    correlator.setTransportListener( &listener );
+
+    synchronized( &(transport->startedMutex) ) {
+        correlator.start();
+        transport->startedMutex.wait();
+    }
+
+    Pointer<MyResponseCallback> callback( new MyResponseCallback( 2 ) );
+    correlator.asyncRequest( Pointer<MyCommand>( new MyCommand() ), callback, 0 );
+    correlator.asyncRequest( Pointer<MyCommand>( new MyCommand() ), callback, 60000 );
+
+    correlator.close();
+
+    CPPUNIT_ASSERT( callback->done.await( 5000 ) );
+    CPPUNIT_ASSERT_EQUAL( 2, callback->exCount );
+
+    try{
+        correlator.asyncRequest( Pointer<MyCommand>( new MyCommand() ), callback, 0 );
+        CPPUNIT_FAIL( "Should throw an IOException" );
+    } catch( IOException& ex ) {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelatorTest::testManyOutstandingRequests(){
+
+    MyListener listener;
+    Pointer<MySilentTransport> transport( new MySilentTransport() );
+    ResponseCorrelator correlator( transport );
+    correlator.setTransportListener( &listener );
+
+    synchronized( &(transport->startedMutex) ) {
+        correlator.start();
+        transport->startedMutex.wait();
+    }
+
+    // Keep more requests outstanding than the table has slots for.
+    const int numRequests = 2000;
+    Pointer<MyResponseCallback> callback( new MyResponseCallback( numRequests ) );
+    std::set<int> answeredIds;
+
+    for( int ix = 0; ix < numRequests; ++ix ) {
+        Pointer<MyCommand> command( new MyCommand() );
+        correlator.asyncRequest( command, callback, ix % 2 == 0 ? 0 : 60000 );
+        if( ix % 3 == 0 ) {
+            answeredIds.insert( command->getCommandId() );
+        }
+    }
+
+    std::set<int>::const_iterator iter = answeredIds.begin();
+    for( ; iter != answeredIds.end(); ++iter ) {
+        Pointer<Response> response( new Response() );
+        response->setCorrelationId( *iter );
+        correlator.onCommand( response );
+    }
+
+    correlator.close();
+
+    CPPUNIT_ASSERT( callback->done.await( 5000 ) );
+    CPPUNIT_ASSERT( callback->correlationIds == answeredIds );
+    CPPUNIT_ASSERT_EQUAL( numRequests - (int)answeredIds.size(), callback->exCount );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelatorTest::testCloseWhileIssuingAsyncRequests(){
+
+    MyListener listener;
+    Pointer<MySilentTransport> transport( new MySilentTransport() );
+    ResponseCorrelator correlator( transport );
+    correlator.setTransportListener( &listener );
+
+    synchronized( &(transport->startedMutex) ) {
+        correlator.start();
+        transport->startedMutex.wait();
+    }
+
+    // The latch isn't used, the callback's counts are checked directly.
+    Pointer<MyResponseCallback> callback( new MyResponseCallback( 1 ) );
+
+    const int numThreads = 4;
+    std::vector<AsyncRequestThread*> threads;
+
+    for( int ix = 0; ix < numThreads; ++ix ) {
+        threads.push_back( new AsyncRequestThread( &correlator, callback ) );
+        threads.back()->start();
+    }
+
+    decaf::lang::Thread::sleep( 50 );
+
+    correlator.close();
+
+    int expected = 0;
+    for( int ix = 0; ix < numThreads; ++ix ) {
+        threads[ix]->join();
+        expected += threads[ix]->issued - threads[ix]->rejected;
+        delete threads[ix];
+    }
+
+    // Every request that was accepted is failed by the close or by its timeout.
+    int failed = 0;
+    for( int ix = 0; ix < 100 && failed < expected; ++ix ) {
+        synchronized( &(callback->mutex) ){
+            failed = callback->exCount;
+        }
+        if( failed < expected ) {
+            decaf::lang::Thread::sleep( 10 );
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL( expected, failed );
+
+    // Give any timeout that was wrongly left scheduled the chance to fire.
+    decaf::lang::Thread::sleep( 50 );
+
+    synchronized( &(callback->mutex) ){
+        CPPUNIT_ASSERT_EQUAL( expected, callback->exCount );
+    }
+}
@@ -33,6 +33,11 @@ namespace correlator{
         CPPUNIT_TEST( testTransportException );
         CPPUNIT_TEST( testMultiRequests );
         CPPUNIT_TEST( testNarrow );
+        CPPUNIT_TEST( testAsyncRequest );
+        CPPUNIT_TEST( testAsyncRequestTimeout );
+        CPPUNIT_TEST( testAsyncRequestFailedOnClose );
+        CPPUNIT_TEST( testManyOutstandingRequests );
+        CPPUNIT_TEST( testCloseWhileIssuingAsyncRequests );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -44,6 +49,11 @@ namespace correlator{
         void testTransportException();
         void testMultiRequests();
         void testNarrow();
+        void testAsyncRequest();
+        void testAsyncRequestTimeout();
+        void testAsyncRequestFailedOnClose();
+        void testManyOutstandingRequests();
+        void testCloseWhileIssuingAsyncRequests();
 
     };
 
@@ -26,6 +26,9 @@
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/util/UUID.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <vector>
 
 using namespace activemq;
 using namespace activemq::commands;
@@ -36,6 +39,7 @@ using namespace activemq::exceptions;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util;
+using namespace decaf::util::concurrent::atomic;
 
 ////////////////////////////////////////////////////////////////////////////////
 FailoverTransportTest::FailoverTransportTest() {
@@ -259,6 +263,105 @@ void FailoverTransportTest::testSendOnewayMessage() {
     transport->close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class SynchronizedMessageCountingListener : public DefaultTransportListener {
+    public:
+
+        AtomicInteger numMessages;
+
+        SynchronizedMessageCountingListener() : numMessages() {}
+
+        virtual void onCommand( const Pointer<Command>& command AMQCPP_UNUSED ) {
+            numMessages.incrementAndGet();
+        }
+    };
+
+    class OnewaySender : public Runnable {
+    private:
+
+        Transport* transport;
+        int numMessages;
+
+    private:
+
+        OnewaySender( const OnewaySender& );
+        OnewaySender& operator= ( const OnewaySender& );
+
+    public:
+
+        OnewaySender( Transport* transport, int numMessages ) :
+            transport( transport ), numMessages( numMessages ) {
+        }
+
+        virtual void run() {
+            try{
+                for( int i = 0; i < numMessages; ++i ) {
+                    Pointer<ActiveMQMessage> message( new ActiveMQMessage() );
+                    transport->oneway( message );
+                }
+            } catch(...) {
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransportTest::testSendOnewayMessageFromMultipleThreads() {
+
+    std::string uri = "failover://(mock://localhost:61616)?randomize=false";
+
+    const int numThreads = 8;
+    const int numMessages = 250;
+
+    SynchronizedMessageCountingListener messageCounter;
+    DefaultTransportListener listener;
+    FailoverTransportFactory factory;
+
+    Pointer<Transport> transport( factory.create( uri ) );
+    CPPUNIT_ASSERT( transport != NULL );
+    transport->setTransportListener( &listener );
+
+    FailoverTransport* failover = dynamic_cast<FailoverTransport*>(
+        transport->narrow( typeid( FailoverTransport ) ) );
+
+    CPPUNIT_ASSERT( failover != NULL );
+
+    transport->start();
+
+    Thread::sleep( 1000 );
+    CPPUNIT_ASSERT( failover->isConnected() == true );
+
+    MockTransport* mock = NULL;
+    while( mock == NULL ) {
+        mock = dynamic_cast<MockTransport*>( transport->narrow( typeid( MockTransport ) ) );
+    }
+    mock->setOutgoingListener( &messageCounter );
+
+    std::vector<OnewaySender*> senders;
+    std::vector<Thread*> threads;
+
+    for( int i = 0; i < numThreads; ++i ) {
+        senders.push_back( new OnewaySender( transport.get(), numMessages ) );
+        threads.push_back( new Thread( senders.back() ) );
+    }
+
+    for( int i = 0; i < numThreads; ++i ) {
+        threads[i]->start();
+    }
+
+    for( int i = 0; i < numThreads; ++i ) {
+        threads[i]->join();
+        delete threads[i];
+        delete senders[i];
+    }
+
+    CPPUNIT_ASSERT_EQUAL( numThreads * numMessages, messageCounter.numMessages.get() );
+
+    transport->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void FailoverTransportTest::testSendRequestMessage() {
 
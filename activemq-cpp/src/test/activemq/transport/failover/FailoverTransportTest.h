@@ -46,6 +46,7 @@ namespace failover {
         CPPUNIT_TEST( testTransportCreateFailOnCreateSendMessage );
         CPPUNIT_TEST( testFailingBackupCreation );
         CPPUNIT_TEST( testSendOnewayMessage );
+        CPPUNIT_TEST( testSendOnewayMessageFromMultipleThreads );
         CPPUNIT_TEST( testSendRequestMessage );
         CPPUNIT_TEST( testSendOnewayMessageFail );
         CPPUNIT_TEST( testSendRequestMessageFail );
@@ -83,6 +84,9 @@ namespace failover {
         void testSendOnewayMessage();
         void testSendRequestMessage();
 
+        // Test that messages sent concurrently by several threads are all received.
+        void testSendOnewayMessageFromMultipleThreads();
+
         // Test that messages sent via the Oneway or Request methods are received after
         // the first transport faults on the send and transport 2 is created.
         void testSendOnewayMessageFail();
@@ -0,0 +1,386 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TcpReactorTest.h"
+
+#include <activemq/transport/tcp/TcpReactor.h>
+#include <decaf/internal/net/tcp/TcpSocket.h>
+#include <decaf/io/IOException.h>
+#include <decaf/io/InputStream.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/net/ServerSocket.h>
+#include <decaf/net/Socket.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::net;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::internal::net::tcp;
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::tcp;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // A connected pair of sockets, the client end uses a TcpSocket the reactor can poll.
+    class TestConnection {
+    private:
+
+        TestConnection( const TestConnection& );
+        TestConnection& operator= ( const TestConnection& );
+
+    public:
+
+        TcpSocket* impl;
+        std::auto_ptr<Socket> client;
+        std::auto_ptr<Socket> worker;
+
+        TestConnection( ServerSocket& server ) : impl( new TcpSocket() ), client( new Socket( impl ) ), worker() {
+            client->connect( "localhost", server.getLocalPort() );
+            worker.reset( server.accept() );
+        }
+
+        void send( const std::string& data ) {
+            worker->getOutputStream()->write( (const unsigned char*)data.c_str(), (int)data.size() );
+            worker->getOutputStream()->flush();
+        }
+    };
+
+    // Records what it reads from the socket each time the reactor calls it.
+    class RecordingChannel : public TcpReactorChannel {
+    private:
+
+        RecordingChannel( const RecordingChannel& );
+        RecordingChannel& operator= ( const RecordingChannel& );
+
+    public:
+
+        InputStream* input;
+        Mutex mutex;
+        std::string data;
+        bool remoteClosed;
+
+        RecordingChannel( InputStream* input ) : input( input ), mutex(), data(), remoteClosed( false ) {}
+
+        virtual ~RecordingChannel() {}
+
+        virtual bool onReadable() {
+
+            int length = input->available();
+            if( length <= 0 ) {
+                length = 1;
+            }
+
+            std::vector<unsigned char> buffer( length );
+            int count = input->read( &buffer[0], length, 0, length );
+
+            synchronized( &mutex ) {
+                if( count == -1 ) {
+                    remoteClosed = true;
+                } else {
+                    data.append( (const char*)&buffer[0], count );
+                }
+
+                mutex.notifyAll();
+            }
+
+            return count != -1;
+        }
+
+        std::string waitFor( std::size_t length, long long timeout ) {
+
+            std::string result;
+            long long deadline = System::currentTimeMillis() + timeout;
+
+            synchronized( &mutex ) {
+
+                long long remaining = timeout;
+                while( data.size() < length && remaining > 0 ) {
+                    mutex.wait( remaining );
+                    remaining = deadline - System::currentTimeMillis();
+                }
+
+                result = data;
+            }
+
+            return result;
+        }
+
+        bool waitForClose( long long timeout ) {
+
+            bool result = false;
+            long long deadline = System::currentTimeMillis() + timeout;
+
+            synchronized( &mutex ) {
+
+                long long remaining = timeout;
+                while( !remoteClosed && remaining > 0 ) {
+                    mutex.wait( remaining );
+                    remaining = deadline - System::currentTimeMillis();
+                }
+
+                result = remoteClosed;
+            }
+
+            return result;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TcpReactorTest::TcpReactorTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TcpReactorTest::~TcpReactorTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testConstructor() {
+
+    TcpReactor reactor( "Test Reactor", 3, 16 );
+    CPPUNIT_ASSERT_EQUAL( 0, reactor.getSelectorCount() );
+    CPPUNIT_ASSERT_EQUAL( 3, reactor.getMaxSelectorCount() );
+    CPPUNIT_ASSERT_EQUAL( 16, reactor.getSelectorCapacity() );
+    CPPUNIT_ASSERT_EQUAL( 0, reactor.getChannelCount() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        TcpReactor( "", 1, 16 ),
+        IllegalArgumentException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        TcpReactor( "Test Reactor", 0, 16 ),
+        IllegalArgumentException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        TcpReactor( "Test Reactor", 1, 0 ),
+        IllegalArgumentException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testRegisterNullThrows() {
+
+    TcpReactor reactor( "Test Reactor", 1, 16 );
+    ServerSocket server( 0 );
+    TestConnection connection( server );
+    RecordingChannel channel( connection.client->getInputStream() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        reactor.registerChannel( NULL, &channel ),
+        NullPointerException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        reactor.registerChannel( connection.impl, NULL ),
+        NullPointerException );
+
+    CPPUNIT_ASSERT( !reactor.unregisterChannel( NULL ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testRegisterTwiceThrows() {
+
+    TcpReactor reactor( "Test Reactor", 2, 16 );
+    ServerSocket server( 0 );
+    TestConnection connection( server );
+    RecordingChannel channel( connection.client->getInputStream() );
+
+    reactor.registerChannel( connection.impl, &channel );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException",
+        reactor.registerChannel( connection.impl, &channel ),
+        IllegalStateException );
+
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testRead() {
+
+    TcpReactor reactor( "Test Reactor", 2, 16 );
+    ServerSocket server( 0 );
+    TestConnection connection( server );
+    RecordingChannel channel( connection.client->getInputStream() );
+
+    reactor.registerChannel( connection.impl, &channel );
+    CPPUNIT_ASSERT( reactor.isRegistered( &channel ) );
+    CPPUNIT_ASSERT_EQUAL( 1, reactor.getChannelCount() );
+
+    connection.send( "Hello" );
+    CPPUNIT_ASSERT_EQUAL( std::string( "Hello" ), channel.waitFor( 5, 5000 ) );
+
+    connection.send( " World" );
+    CPPUNIT_ASSERT_EQUAL( std::string( "Hello World" ), channel.waitFor( 11, 5000 ) );
+
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testRemoteClose() {
+
+    TcpReactor reactor( "Test Reactor", 1, 16 );
+    ServerSocket server( 0 );
+    TestConnection connection( server );
+    RecordingChannel channel( connection.client->getInputStream() );
+
+    reactor.registerChannel( connection.impl, &channel );
+
+    connection.worker->close();
+    CPPUNIT_ASSERT( channel.waitForClose( 5000 ) );
+
+    // A failed channel is no longer polled but stays registered until its owner is done.
+    CPPUNIT_ASSERT( reactor.isRegistered( &channel ) );
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel ) );
+    CPPUNIT_ASSERT( !reactor.isRegistered( &channel ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testUnregister() {
+
+    TcpReactor reactor( "Test Reactor", 1, 16 );
+    ServerSocket server( 0 );
+    TestConnection connection( server );
+    RecordingChannel channel( connection.client->getInputStream() );
+
+    reactor.registerChannel( connection.impl, &channel );
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel ) );
+    CPPUNIT_ASSERT( !reactor.unregisterChannel( &channel ) );
+    CPPUNIT_ASSERT_EQUAL( 0, reactor.getChannelCount() );
+
+    // Once unregistered the channel is not told about new data.
+    connection.send( "Hello" );
+    CPPUNIT_ASSERT_EQUAL( std::string( "" ), channel.waitFor( 5, 200 ) );
+
+    // The same socket can be registered again and the waiting data is then read.
+    reactor.registerChannel( connection.impl, &channel );
+    CPPUNIT_ASSERT_EQUAL( std::string( "Hello" ), channel.waitFor( 5, 5000 ) );
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testCapacity() {
+
+    TcpReactor reactor( "Test Reactor", 1, 2 );
+    ServerSocket server( 0 );
+    TestConnection connection1( server );
+    TestConnection connection2( server );
+    TestConnection connection3( server );
+    RecordingChannel channel1( connection1.client->getInputStream() );
+    RecordingChannel channel2( connection2.client->getInputStream() );
+    RecordingChannel channel3( connection3.client->getInputStream() );
+
+    reactor.registerChannel( connection1.impl, &channel1 );
+    reactor.registerChannel( connection2.impl, &channel2 );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        reactor.registerChannel( connection3.impl, &channel3 ),
+        IOException );
+
+    // Unregistering frees up the space again.
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel1 ) );
+    reactor.registerChannel( connection3.impl, &channel3 );
+    CPPUNIT_ASSERT_EQUAL( 2, reactor.getChannelCount() );
+
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel2 ) );
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel3 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testSelectorsStartedOnDemand() {
+
+    TcpReactor reactor( "Test Reactor", 2, 16 );
+    ServerSocket server( 0 );
+    TestConnection connection1( server );
+    TestConnection connection2( server );
+    TestConnection connection3( server );
+    RecordingChannel channel1( connection1.client->getInputStream() );
+    RecordingChannel channel2( connection2.client->getInputStream() );
+    RecordingChannel channel3( connection3.client->getInputStream() );
+
+    CPPUNIT_ASSERT_EQUAL( 0, reactor.getSelectorCount() );
+
+    reactor.registerChannel( connection1.impl, &channel1 );
+    CPPUNIT_ASSERT_EQUAL( 1, reactor.getSelectorCount() );
+
+    reactor.registerChannel( connection2.impl, &channel2 );
+    CPPUNIT_ASSERT_EQUAL( 2, reactor.getSelectorCount() );
+
+    // Never more than the maximum, the new socket joins an existing thread.
+    reactor.registerChannel( connection3.impl, &channel3 );
+    CPPUNIT_ASSERT_EQUAL( 2, reactor.getSelectorCount() );
+    CPPUNIT_ASSERT_EQUAL( 3, reactor.getChannelCount() );
+
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel1 ) );
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel2 ) );
+    CPPUNIT_ASSERT( reactor.unregisterChannel( &channel3 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpReactorTest::testManyChannels() {
+
+    static const int NUM_CONNECTIONS = 50;
+
+    TcpReactor reactor( "Test Reactor", 2, 64 );
+    ServerSocket server( 0, NUM_CONNECTIONS );
+
+    std::vector<TestConnection*> connections;
+    std::vector<RecordingChannel*> channels;
+
+    for( int i = 0; i < NUM_CONNECTIONS; ++i ) {
+        connections.push_back( new TestConnection( server ) );
+        channels.push_back( new RecordingChannel( connections[i]->client->getInputStream() ) );
+        reactor.registerChannel( connections[i]->impl, channels[i] );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( NUM_CONNECTIONS, reactor.getChannelCount() );
+
+    for( int i = 0; i < NUM_CONNECTIONS; ++i ) {
+        connections[i]->send( "Message" );
+    }
+
+    // Two reactor threads serve all of the connections.
+    for( int i = 0; i < NUM_CONNECTIONS; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( std::string( "Message" ), channels[i]->waitFor( 7, 5000 ) );
+    }
+
+    for( int i = 0; i < NUM_CONNECTIONS; ++i ) {
+        CPPUNIT_ASSERT( reactor.unregisterChannel( channels[i] ) );
+        delete channels[i];
+        delete connections[i];
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 0, reactor.getChannelCount() );
+}
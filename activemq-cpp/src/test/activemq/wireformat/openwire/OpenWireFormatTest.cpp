@@ -19,16 +19,29 @@
 
 #include <decaf/util/Properties.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQMessageMarshaller.h>
+#include <activemq/commands/ActiveMQMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/MessageId.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/DataInputStream.h>
 
 using namespace std;
 using namespace activemq;
 using namespace activemq::util;
+using namespace activemq::commands;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util;
 using namespace activemq::exceptions;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace activemq::wireformat::openwire::marshal::generated;
 
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormatTest::test()
@@ -36,3 +49,114 @@ void OpenWireFormatTest::test()
     Properties properties;
     //OpenWireFormat myWireFormat( properties );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testLooseMarshalCache() {
+    doTestMarshalCache( false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTightMarshalCache() {
+    doTestMarshalCache( true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testUnmarshalCacheIndexNotSet() {
+
+    Properties properties;
+    OpenWireFormat wireFormat( properties );
+    wireFormat.setCacheEnabled( true );
+
+    ActiveMQQueue queue( "TEST.QUEUE" );
+    wireFormat.setInUnmarshalCache( 5, &queue );
+    wireFormat.setInUnmarshalCache( 3, NULL );
+
+    std::auto_ptr<DataStructure> cached( wireFormat.getFromUnmarshalCache( 5 ) );
+    CPPUNIT_ASSERT( cached.get() != NULL );
+    CPPUNIT_ASSERT( cached->equals( &queue ) );
+
+    // A NULL the peer cached is a valid entry.
+    CPPUNIT_ASSERT( wireFormat.getFromUnmarshalCache( 3 ) == NULL );
+
+    // Below the highest index set but never filled by the peer.
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        wireFormat.getFromUnmarshalCache( 4 ),
+        IOException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        wireFormat.getFromUnmarshalCache( 6 ),
+        IOException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::doTestMarshalCache( bool tightEncoding ) {
+
+    Properties properties;
+    OpenWireFormat wireFormat( properties );
+    wireFormat.setTightEncodingEnabled( tightEncoding );
+    wireFormat.setCacheEnabled( true );
+
+    ActiveMQMessageMarshaller marshaller;
+
+    Pointer<ProducerId> producerId( new ProducerId() );
+    producerId->setConnectionId( "ID:test-connection-with-a-long-identifier:1" );
+    producerId->setSessionId( 2 );
+    producerId->setValue( 3 );
+
+    ActiveMQMessage outCommand;
+    outCommand.setProducerId( producerId );
+    outCommand.setDestination( Pointer<ActiveMQDestination>( new ActiveMQQueue( "TEST.QUEUE.FOR.MARSHAL.CACHE" ) ) );
+
+    Pointer<MessageId> messageId( new MessageId() );
+    messageId->setProducerId( producerId );
+    messageId->setProducerSequenceId( 1 );
+    outCommand.setMessageId( messageId );
+
+    ByteArrayOutputStream baos;
+    DataOutputStream dataOut( &baos );
+
+    std::size_t sizes[2];
+
+    for( int i = 0; i < 2; ++i ) {
+
+        std::size_t start = baos.size();
+
+        if( tightEncoding ) {
+            BooleanStream bs;
+            marshaller.tightMarshal1( &wireFormat, &outCommand, &bs );
+            bs.marshal( &dataOut );
+            marshaller.tightMarshal2( &wireFormat, &outCommand, &dataOut, &bs );
+        } else {
+            marshaller.looseMarshal( &wireFormat, &outCommand, &dataOut );
+        }
+
+        sizes[i] = baos.size() - start;
+    }
+
+    // The second copy refers to the producer id and destination by index.
+    CPPUNIT_ASSERT( sizes[1] < sizes[0] );
+
+    std::pair<const unsigned char*, int> array = baos.toByteArray();
+    ByteArrayInputStream bais( array.first, array.second, true );
+    DataInputStream dataIn( &bais );
+
+    for( int i = 0; i < 2; ++i ) {
+
+        ActiveMQMessage inCommand;
+
+        if( tightEncoding ) {
+            BooleanStream bs;
+            bs.unmarshal( &dataIn );
+            marshaller.tightUnmarshal( &wireFormat, &inCommand, &dataIn, &bs );
+        } else {
+            marshaller.looseUnmarshal( &wireFormat, &inCommand, &dataIn );
+        }
+
+        CPPUNIT_ASSERT( inCommand.getProducerId() != NULL );
+        CPPUNIT_ASSERT( inCommand.getProducerId()->equals( producerId.get() ) );
+        CPPUNIT_ASSERT( inCommand.getDestination() != NULL );
+        CPPUNIT_ASSERT( inCommand.getDestination()->equals( outCommand.getDestination().get() ) );
+    }
+}
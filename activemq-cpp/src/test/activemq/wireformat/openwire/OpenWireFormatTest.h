@@ -29,6 +29,9 @@ namespace openwire{
 
         CPPUNIT_TEST_SUITE( OpenWireFormatTest );
         CPPUNIT_TEST( test );
+        CPPUNIT_TEST( testLooseMarshalCache );
+        CPPUNIT_TEST( testTightMarshalCache );
+        CPPUNIT_TEST( testUnmarshalCacheIndexNotSet );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -37,6 +40,13 @@ namespace openwire{
         virtual ~OpenWireFormatTest() {}
 
         virtual void test();
+        virtual void testLooseMarshalCache();
+        virtual void testTightMarshalCache();
+        virtual void testUnmarshalCacheIndexNotSet();
+
+    private:
+
+        void doTestMarshalCache( bool tightEncoding );
 
     };
 
@@ -58,6 +58,32 @@ void ByteArrayOutputStreamTest::testReset() {
     CPPUNIT_ASSERT_MESSAGE("reset failed", 0 == baos.size() );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ByteArrayOutputStreamTest::testResetAndTrim() {
+    ByteArrayOutputStream baos( 16 );
+    baos.write( (unsigned char*)&testString[0], (int)testString.size(), 0, 100 );
+    CPPUNIT_ASSERT( baos.capacity() >= 100 );
+
+    baos.resetAndTrim( 64 );
+    CPPUNIT_ASSERT_EQUAL( 0LL, baos.size() );
+    CPPUNIT_ASSERT_EQUAL( 64, baos.capacity() );
+
+    // A buffer already within the limit is kept as it is.
+    baos.write( (unsigned char*)&testString[0], (int)testString.size(), 0, 10 );
+    baos.resetAndTrim( 128 );
+    CPPUNIT_ASSERT_EQUAL( 0LL, baos.size() );
+    CPPUNIT_ASSERT_EQUAL( 64, baos.capacity() );
+
+    baos.write( (unsigned char*)&testString[0], (int)testString.size(), 0, 100 );
+    CPPUNIT_ASSERT_EQUAL( 100LL, baos.size() );
+    CPPUNIT_ASSERT( testString.substr( 0, 100 ) == baos.toString() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        baos.resetAndTrim( 0 ),
+        decaf::lang::exceptions::IllegalArgumentException );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ByteArrayOutputStreamTest::testSize() {
     ByteArrayOutputStream baos;
@@ -34,6 +34,7 @@ namespace io{
         CPPUNIT_TEST( testConstructor2 );
         CPPUNIT_TEST( testClose );
         CPPUNIT_TEST( testReset );
+        CPPUNIT_TEST( testResetAndTrim );
         CPPUNIT_TEST( testSize );
         CPPUNIT_TEST( testToByteArray );
         CPPUNIT_TEST( testToString );
@@ -59,6 +60,7 @@ namespace io{
         void testConstructor2();
         void testClose();
         void testReset();
+        void testResetAndTrim();
         void testSize();
         void testToByteArray();
         void testToString();
@@ -107,4 +107,8 @@ void LongTest::test2() {
     CPPUNIT_ASSERT( Long::lowestOneBit( 255 ) == 1 );
     CPPUNIT_ASSERT( Long::lowestOneBit( 0xFF000000 ) == (long long)0x01000000 );
 
+    // numberOfLeadingZeros
+    CPPUNIT_ASSERT( Long::numberOfLeadingZeros( 0 ) == 64 );
+    CPPUNIT_ASSERT( Long::numberOfLeadingZeros( 1 ) == 63 );
+    CPPUNIT_ASSERT( Long::numberOfLeadingZeros( 0x100000000LL ) == 31 );
 }
@@ -22,6 +22,7 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/exceptions/ClassCastException.h>
 #include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/atomic/AtomicRefCounted.h>
 
 #include <map>
 #include <string>
@@ -85,6 +86,34 @@ public:
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+class CountedClass : public decaf::util::concurrent::atomic::AtomicRefCounted {
+private:
+
+    int* destroyed;
+
+public:
+
+    CountedClass( int* destroyed ) : AtomicRefCounted(), destroyed( destroyed ) {}
+
+    CountedClass( const CountedClass& source ) : AtomicRefCounted( source ), destroyed( source.destroyed ) {}
+
+    virtual ~CountedClass() {
+        ( *destroyed )++;
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+class DerivedCountedClass : public CountedClass {
+public:
+
+    DerivedCountedClass( int* destroyed ) : CountedClass( destroyed ) {}
+
+    virtual ~DerivedCountedClass() {}
+
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 struct X {
     Pointer<X> next;
@@ -563,3 +592,60 @@ void PointerTest::testThreadSafety() {
         thread[i]->join();
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void PointerTest::testEmbeddedCount() {
+
+    int destroyed = 0;
+
+    {
+        Pointer<CountedClass> pointer( new CountedClass( &destroyed ) );
+        Pointer<CountedClass> copy( pointer );
+        Pointer<CountedClass> assigned;
+        assigned = copy;
+
+        pointer.reset( NULL );
+        copy.reset( NULL );
+        CPPUNIT_ASSERT_EQUAL( 0, destroyed );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 1, destroyed );
+
+    // The count is not copied along with the object.
+    {
+        Pointer<CountedClass> pointer( new CountedClass( &destroyed ) );
+        Pointer<CountedClass> copy( new CountedClass( *pointer ) );
+
+        pointer.reset( NULL );
+        CPPUNIT_ASSERT_EQUAL( 2, destroyed );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 3, destroyed );
+
+    // Casts to and from the derived type share the embedded count.
+    {
+        Pointer<CountedClass> pointer( new DerivedCountedClass( &destroyed ) );
+        Pointer<DerivedCountedClass> derived = pointer.dynamicCast<DerivedCountedClass>();
+
+        pointer.reset( NULL );
+        CPPUNIT_ASSERT_EQUAL( 3, destroyed );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 4, destroyed );
+
+    // A released object is owned by the caller again and can be given to a new Pointer.
+    {
+        CountedClass* released = NULL;
+
+        {
+            Pointer<CountedClass> pointer( new CountedClass( &destroyed ) );
+            released = pointer.release();
+        }
+
+        CPPUNIT_ASSERT_EQUAL( 4, destroyed );
+
+        Pointer<CountedClass> pointer( released );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 5, destroyed );
+}
@@ -37,6 +37,7 @@ namespace lang {
         CPPUNIT_TEST( testReturnByValue );
         CPPUNIT_TEST( testDynamicCast );
         CPPUNIT_TEST( testThreadSafety );
+        CPPUNIT_TEST( testEmbeddedCount );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -54,6 +55,7 @@ namespace lang {
         void testReturnByValue();
         void testDynamicCast();
         void testThreadSafety();
+        void testEmbeddedCount();
 
     };
 
@@ -24,6 +24,8 @@
 #include <decaf/util/Random.h>
 
 #include <decaf/internal/util/concurrent/SynchronizableImpl.h>
+#include <decaf/internal/util/concurrent/Threading.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 
 #include <time.h>
 
@@ -768,3 +770,101 @@ void MutexTest::testStressMutex(){
 
     CPPUNIT_ASSERT( true );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void MutexTest::testGetName() {
+
+    Mutex named( "TestMutex" );
+    CPPUNIT_ASSERT_EQUAL( std::string( "TestMutex" ), named.getName() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "TestMutex" ), named.toString() );
+
+    Mutex mutex1;
+    Mutex mutex2;
+
+    std::string name1 = mutex1.getName();
+    std::string name2 = mutex2.getName();
+
+    CPPUNIT_ASSERT( name1.find( "Mutex-" ) == 0 );
+    CPPUNIT_ASSERT( name2.find( "Mutex-" ) == 0 );
+    CPPUNIT_ASSERT( name1 != name2 );
+
+    // The default name is assigned once and then stays the same.
+    CPPUNIT_ASSERT_EQUAL( name1, mutex1.getName() );
+    CPPUNIT_ASSERT_EQUAL( name1, mutex1.toString() );
+
+    Mutex unnamed( "" );
+    CPPUNIT_ASSERT( unnamed.getName().find( "Mutex-" ) == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ContendingThread : public lang::Thread {
+    private:
+
+        Mutex* mutex;
+        int* counter;
+
+    private:
+
+        ContendingThread( const ContendingThread& );
+        ContendingThread& operator= ( const ContendingThread& );
+
+    public:
+
+        ContendingThread( Mutex* mutex, int* counter ) : Thread(), mutex( mutex ), counter( counter ) {}
+        virtual ~ContendingThread() {}
+
+        virtual void run() {
+
+            for( int i = 0; i < 10000; ++i ) {
+                synchronized( mutex ) {
+                    ( *counter )++;
+
+                    if( *counter % 1000 == 0 ) {
+                        mutex->notifyAll();
+                    }
+                }
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MutexTest::testSpinningContention() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        Threading::setMonitorSpinLimit( -1 ),
+        IllegalArgumentException );
+
+    int oldLimit = Threading::getMonitorSpinLimit();
+    Threading::setMonitorSpinLimit( 100 );
+    CPPUNIT_ASSERT_EQUAL( 100, Threading::getMonitorSpinLimit() );
+
+    Mutex mutex;
+    int counter = 0;
+
+    ContendingThread thread1( &mutex, &counter );
+    ContendingThread thread2( &mutex, &counter );
+    ContendingThread thread3( &mutex, &counter );
+
+    thread1.start();
+    thread2.start();
+    thread3.start();
+
+    // Waiting on a Monitor that other threads spin on must still be woken.
+    synchronized( &mutex ) {
+        while( counter < 30000 ) {
+            mutex.wait( 100 );
+        }
+    }
+
+    thread1.join();
+    thread2.join();
+    thread3.join();
+
+    Threading::setMonitorSpinLimit( oldLimit );
+
+    CPPUNIT_ASSERT_EQUAL( 30000, counter );
+}
@@ -37,6 +37,8 @@ namespace concurrent{
         CPPUNIT_TEST( testRecursiveLock );
         CPPUNIT_TEST( testDoubleLock );
         CPPUNIT_TEST( testStressMutex );
+        CPPUNIT_TEST( testGetName );
+        CPPUNIT_TEST( testSpinningContention );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -54,6 +56,8 @@ namespace concurrent{
         void testRecursiveLock();
         void testDoubleLock();
         void testStressMutex();
+        void testGetName();
+        void testSpinningContention();
 
     };
 
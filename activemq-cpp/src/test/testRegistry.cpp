@@ -77,8 +77,12 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionFactoryTest )
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionTest );
 #include <activemq/core/ActiveMQSessionTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQSessionTest );
+#include <activemq/core/DispatchedMessageListTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::DispatchedMessageListTest );
 #include <activemq/core/FifoMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::FifoMessageDispatchChannelTest );
+#include <activemq/core/RingBufferMessageDispatchChannelTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::RingBufferMessageDispatchChannelTest );
 #include <activemq/core/SimplePriorityMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::SimplePriorityMessageDispatchChannelTest );
 
@@ -88,6 +92,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ConnectionStateTrackerTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ConnectionStateTest );
 #include <activemq/state/ConsumerStateTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ConsumerStateTest );
+#include <activemq/state/MessageCacheTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::MessageCacheTest );
 #include <activemq/state/ProducerStateTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ProducerStateTest );
 #include <activemq/state/SessionStateTest.h>
@@ -107,6 +113,9 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::mock::MockTransportFactory
 #include <activemq/transport/inactivity/InactivityMonitorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::inactivity::InactivityMonitorTest );
 
+#include <activemq/transport/tcp/TcpReactorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::tcp::TcpReactorTest );
+
 #include <activemq/transport/TransportRegistryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::TransportRegistryTest );
 #include <activemq/transport/IOTransportTest.h>
@@ -140,8 +149,12 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MarshallingSupportTest );
 
 #include <activemq/threads/SchedulerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::SchedulerTest );
+#include <activemq/threads/TimerWheelTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::TimerWheelTest );
 #include <activemq/threads/DedicatedTaskRunnerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::DedicatedTaskRunnerTest );
+#include <activemq/threads/PooledTaskRunnerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::PooledTaskRunnerTest );
 #include <activemq/threads/CompositeTaskRunnerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::CompositeTaskRunnerTest );
 